@@ -25,19 +25,12 @@
      added 48/96 kHz sampling rate support
      added 24/32bit sample size support
      removed glib dependency
+     moved the process wide settings into an equalizer instance
 */
 
 #include <math.h>
 #include "iir.h"
-
-/* Coefficients */
-sIIRCoefficients *iir_cf;
-
-/* Volume gain
- * values should be between 0.0 and 1.0
- * Use the preamp from XMMS for now
- * */
-float preamp[EQ_CHANNELS];
+#include "iir_fpu.h"
 
 #ifdef BENCHMARK
 #include "benchmark.h"
@@ -47,41 +40,39 @@ unsigned int blength = 0;
 #endif
 
 /*
- * Equalizer settings
+ * Process wide equalizer settings
  */
-unsigned int rate = 0;
-int band_count = 0;
-unsigned int eq_options = 0;
+static eq_state_t eq_default;
 
 void eq_set_preamp(int chn, float val)
 {
-  preamp[chn] = val;
+  eq_state_set_preamp(&eq_default, chn, val);
 }
 
 void eq_set_option(eq_option_t option, int enabled)
 {
-  if(enabled)
-    eq_options |= option;
-  else
-    eq_options &= ~option;
+  eq_state_set_option(&eq_default, option, enabled);
 }
 
-/* Init the filters */
-void eq_init_iir(unsigned int srate, int band_num)
+void eq_set_gain(int index, int chn, float val)
 {
-  calc_coeffs();
-#if 0
-  band_count = cfg.band_num;
-#endif
+  eq_state_set_gain(&eq_default, index, chn, val);
+}
 
-  if(srate == rate && band_num == band_count)
-      return;
+void eq_clean_history()
+{
+  eq_state_clean_history(&eq_default);
+}
 
-  band_count = band_num;
-  rate = srate;
+/* Init the filters */
+void eq_init_iir(unsigned int srate, int band_num)
+{
+  eq_state_init_iir(&eq_default, srate, band_num);
+}
 
-  iir_cf = get_coeffs(&band_count, rate);
-  eq_clean_history();
+int eq_iir(float *d, int samples, int nch)
+{
+  return eq_state_iir(&eq_default, d, samples, nch);
 }
 
 #ifdef ARCH_X86
@@ -26,6 +26,7 @@
      added 24/32bit sample size support
      added optimization
      removed glib dependency
+     added reentrant equalizer instances
 */
 
 #ifndef IIR_H
@@ -66,9 +67,27 @@ typedef enum {
 
 } eq_option_t;
 
+/*
+ * Equalizer instance, keeps its own coefficients, gains and history
+ * so that several streams can be filtered at the same time
+ */
+typedef struct eq_state eq_state_t;
+
 /*
  * Function prototypes
  */
+eq_state_t *eq_state_new(unsigned int srate, int band_num);
+void eq_state_free(eq_state_t *eq);
+void eq_state_init_iir(eq_state_t *eq, unsigned int srate, int band_num);
+void eq_state_clean_history(eq_state_t *eq);
+void eq_state_set_gain(eq_state_t *eq, int index, int chn, float val);
+void eq_state_set_preamp(eq_state_t *eq, int chn, float val);
+void eq_state_set_option(eq_state_t *eq, eq_option_t option, int enabled);
+int eq_state_iir(eq_state_t *eq, float * d, int samples, int nch);
+
+/*
+ * Process wide equalizer, kept for the old callers
+ */
 void eq_init_iir(unsigned int srate, int band_num);
 void eq_clean_history();
 void eq_set_gain(int index, int chn, float val);
@@ -86,15 +105,4 @@ __inline__ int round_ppc(float x);
 #define EQ_CHANNELS 9
 #define EQ_MAX_BANDS 32
 
-extern float preamp[EQ_CHANNELS];
-extern sIIRCoefficients *iir_cf;
-extern int band_count;
-extern unsigned int eq_options;
-
-#ifdef BENCHMARK
-extern double timex;
-extern int count;
-extern unsigned int blength;
-#endif
-
 #endif /* #define IIR_H */
@@ -135,48 +135,38 @@ struct {
  * Functions *
  *************/
 
-/* Get the coeffs for a given number of bands and sampling frequency */
-sIIRCoefficients* get_coeffs(int *bands, unsigned int sfreq)
+/* Get the index in iir_bands[] for a given number of bands and sampling frequency.
+ * The first entry wins, so 10 bands at 44.1/48 kHz keep the original xmms freqs.
+ * The band count of the chosen table is written back, the caller never uses more */
+static int find_band(int *bands, unsigned int sfreq)
 {
-  sIIRCoefficients *iir_cf = 0;
+  int n, count = *bands;
   switch(sfreq)
   {
-    case 11025: iir_cf = iir_cf10_11k_11025;
-                *bands = 10;
-                break;
-    case 22050: iir_cf = iir_cf10_22k_22050;
-                *bands = 10;
+    case 11025:
+    case 22050: count = 10;
                 break;
     case 48000:
-                switch(*bands)
-                {
-                  case 31: iir_cf = iir_cf31_48000; break;
-                  case 25: iir_cf = iir_cf25_48000; break;
-                  case 15: iir_cf = iir_cf15_48000; break;
-                  default: iir_cf = iir_cforiginal10_48000; break;
-                }
+    case 96000: break;
+    default:    sfreq = 44100;
                 break;
-    case 96000:
-               switch(*bands)
-               {
-                 case 31: iir_cf = iir_cf31_96000; break;
-                 case 25: iir_cf = iir_cf25_96000; break;
-                 case 15: iir_cf = iir_cf15_96000; break;
-                 default: iir_cf = iir_cf10_96000; break;
-               }
-               break;
-
-    default:
-               switch(*bands)
-               {
-                  case 31: iir_cf = iir_cf31_44100; break;
-                  case 25: iir_cf = iir_cf25_44100; break;
-                  case 15: iir_cf = iir_cf15_44100; break;
-                  default: iir_cf = iir_cforiginal10_44100; break;
-               }
-               break;
   }
-  return iir_cf;
+
+  if(count != 15 && count != 25 && count != 31)
+    count = 10;
+  *bands = count;
+
+  for(n = 0; iir_bands[n].cfs; n++) {
+    if(iir_bands[n].band_count == count && iir_bands[n].sfreq == sfreq)
+      return n;
+  }
+  return 0;
+}
+
+/* Get the coeffs for a given number of bands and sampling frequency */
+sIIRCoefficients* get_coeffs(int *bands, unsigned int sfreq)
+{
+  return iir_bands[find_band(bands, sfreq)].coeffs;
 }
 
 /* Get the freqs at both sides of F0. These will be cut at -3dB */
@@ -202,51 +192,64 @@ static int find_root(double a, double b, double c, double *x0) {
   return 0;
 }
 
-/* Calculate all the coefficients as specified in the bands[] array */
-void calc_coeffs()
+/* Calculate the coefficients of iir_bands[n] into coeffs */
+static void calc_band_coeffs(int n, sIIRCoefficients *coeffs)
 {
-  int i, n;
+  int i;
   double f1, f2;
   double x0;
 
-  n = 0;
-  for(; iir_bands[n].cfs; n++) {
-    double *freqs = (double *)iir_bands[n].cfs;
-    for(i=0; i<iir_bands[n].band_count; i++)
-    {
+  double *freqs = (double *)iir_bands[n].cfs;
+  for(i=0; i<iir_bands[n].band_count; i++)
+  {
 
-      /* Find -3dB frequencies for the center freq */
-      find_f1_and_f2(freqs[i], iir_bands[n].octave, &f1, &f2);
-      /* Find Beta */
-      if( find_root(
-            BETA2(TETA(freqs[i]), TETA(f1)),
-            BETA1(TETA(freqs[i]), TETA(f1)),
-            BETA0(TETA(freqs[i]), TETA(f1)),
-            &x0) == 0)
-      {
-        /* Got a solution, now calculate the rest of the factors */
-        /* Take the smallest root always (find_root returns the smallest one)
-         *
-         * NOTE: The IIR equation is
-         *	y[n] = 2 * (alpha*(x[n]-x[n-2]) + gamma*y[n-1] - beta*y[n-2])
-         *  Now the 2 factor has been distributed in the coefficients
-         */
-        /* Now store the coefficients */
-        iir_bands[n].coeffs[i].beta = 2.0 * x0;
-        iir_bands[n].coeffs[i].alpha = 2.0 * ALPHA(x0);
-        iir_bands[n].coeffs[i].gamma = 2.0 * GAMMA(x0, TETA(freqs[i]));
+    /* Find -3dB frequencies for the center freq */
+    find_f1_and_f2(freqs[i], iir_bands[n].octave, &f1, &f2);
+    /* Find Beta */
+    if( find_root(
+          BETA2(TETA(freqs[i]), TETA(f1)),
+          BETA1(TETA(freqs[i]), TETA(f1)),
+          BETA0(TETA(freqs[i]), TETA(f1)),
+          &x0) == 0)
+    {
+      /* Got a solution, now calculate the rest of the factors */
+      /* Take the smallest root always (find_root returns the smallest one)
+       *
+       * NOTE: The IIR equation is
+       *	y[n] = 2 * (alpha*(x[n]-x[n-2]) + gamma*y[n-1] - beta*y[n-2])
+       *  Now the 2 factor has been distributed in the coefficients
+       */
+      /* Now store the coefficients */
+      coeffs[i].beta = 2.0 * x0;
+      coeffs[i].alpha = 2.0 * ALPHA(x0);
+      coeffs[i].gamma = 2.0 * GAMMA(x0, TETA(freqs[i]));
 #ifdef DEBUG
-        printf("Freq[%d]: %f. Beta: %.10e Alpha: %.10e Gamma %.10e\n",
-            i, freqs[i], bands[n].coeffs[i].beta,
-            bands[n].coeffs[i].alpha, bands[n].coeffs[i].gamma);
+      printf("Freq[%d]: %f. Beta: %.10e Alpha: %.10e Gamma %.10e\n",
+          i, freqs[i], coeffs[i].beta,
+          coeffs[i].alpha, coeffs[i].gamma);
 #endif
-      } else {
-        /* Shouldn't happen */
-        iir_bands[n].coeffs[i].beta = 0.;
-        iir_bands[n].coeffs[i].alpha = 0.;
-        iir_bands[n].coeffs[i].gamma = 0.;
-        printf("  **** Where are the roots?\n");
-      }
-    }// for i
+    } else {
+      /* Shouldn't happen */
+      coeffs[i].beta = 0.;
+      coeffs[i].alpha = 0.;
+      coeffs[i].gamma = 0.;
+      printf("  **** Where are the roots?\n");
+    }
+  }// for i
+}
+
+/* Calculate all the coefficients as specified in the bands[] array */
+void calc_coeffs()
+{
+  int n = 0;
+  for(; iir_bands[n].cfs; n++) {
+    calc_band_coeffs(n, iir_bands[n].coeffs);
   }//for n
 }
+
+/* Calculate the coeffs for a given number of bands and sampling frequency
+ * into the caller's table, the shared tables are left untouched */
+void calc_coeffs_for(sIIRCoefficients *coeffs, int *bands, unsigned int sfreq)
+{
+  calc_band_coeffs(find_band(bands, sfreq), coeffs);
+}
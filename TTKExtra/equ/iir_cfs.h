@@ -25,6 +25,7 @@
      added 48/96 kHz sampling rate support
      added 24/32bit sample size support
      removed glib dependency
+     added per instance coefficient tables
 */
 
 #ifndef IIR_CFS_H
@@ -43,5 +44,6 @@ typedef struct
 
 sIIRCoefficients* get_coeffs(int *bands, unsigned int sfreq); //, bool use_xmms_original_freqs);
 void calc_coeffs();
+void calc_coeffs_for(sIIRCoefficients *coeffs, int *bands, unsigned int sfreq);
 
 #endif
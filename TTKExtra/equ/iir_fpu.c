@@ -33,38 +33,159 @@
 #include "iir_fpu.h"
 #include "iir.h"
 
-static sXYData data_history[EQ_CHANNELS][EQ_MAX_BANDS] __attribute__((aligned));
-static sXYData data_history2[EQ_CHANNELS][EQ_MAX_BANDS] __attribute__((aligned));
-float gain[EQ_CHANNELS][EQ_MAX_BANDS] __attribute__((aligned));
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
-void eq_set_gain(int index, int chn, float val)
+eq_state_t *eq_state_new(unsigned int srate, int band_num)
 {
-  gain[chn][index] = val;
+  eq_state_t *eq = (eq_state_t *) calloc(1, sizeof(eq_state_t));
+  if(eq)
+    eq_state_init_iir(eq, srate, band_num);
+  return eq;
 }
 
-void eq_clean_history()
+void eq_state_free(eq_state_t *eq)
+{
+  free(eq);
+}
+
+/* Init the filters, coefficients are computed into the instance */
+void eq_state_init_iir(eq_state_t *eq, unsigned int srate, int band_num)
+{
+  sIIRCoefficients coeffs[EQ_MAX_BANDS];
+  int band;
+
+  if(srate == eq->rate && band_num == eq->band_count)
+      return;
+
+  calc_coeffs_for(coeffs, &band_num, srate);
+  eq->band_count = band_num;
+  eq->rate = srate;
+
+  for(band = 0; band < EQ_MAX_BANDS; band++)
+  {
+    eq->alpha[band] = band < band_num ? coeffs[band].alpha : 0.;
+    eq->beta[band] = band < band_num ? coeffs[band].beta : 0.;
+    eq->gamma[band] = band < band_num ? coeffs[band].gamma : 0.;
+  }
+  eq_state_clean_history(eq);
+}
+
+void eq_state_set_gain(eq_state_t *eq, int index, int chn, float val)
+{
+  eq->gain[chn][index] = val;
+}
+
+void eq_state_set_preamp(eq_state_t *eq, int chn, float val)
+{
+  eq->preamp[chn] = val;
+}
+
+void eq_state_set_option(eq_state_t *eq, eq_option_t option, int enabled)
+{
+  if(enabled)
+    eq->options |= option;
+  else
+    eq->options &= ~option;
+}
+
+void eq_state_clean_history(eq_state_t *eq)
 {
-  //int n;
   /* Zero the history arrays */
-  memset(data_history, 0, sizeof(sXYData) * EQ_MAX_BANDS * EQ_CHANNELS);
-  memset(data_history2, 0, sizeof(sXYData) * EQ_MAX_BANDS * EQ_CHANNELS);
+  memset(eq->x1, 0, sizeof(eq->x1));
+  memset(eq->x2, 0, sizeof(eq->x2));
+  memset(eq->data_history, 0, sizeof(eq->data_history));
+  memset(eq->data_history2, 0, sizeof(eq->data_history2));
 }
 
-__inline__ int eq_iir(float *d, int samples, int nch)
+/*
+ * First pass, every band sees the same input so all of them are evaluated
+ * together, two bands per SSE2 register. Bands with a zero gain are still
+ * filtered and just add nothing, which keeps their history in step.
+ */
+static __inline__ sample_t eq_first_pass(const eq_state_t *eq, sXYData *h, const sample_t *gain,
+                                         sample_t x0, sample_t x2)
 {
-//  FTZ_ON;
-  float *data = (float *) d;
-  /* Indexes for the history arrays
-   * These have to be kept between calls to this function
-   * hence they are static */
-  static int i = 2, j = 1, k = 0;
+  const sample_t dx = x0 - x2;
+  sample_t out = 0.;
+  int band = 0;
+
+#ifdef __SSE2__
+  /* Coefficients and gains are zero above band_count, round up to a pair */
+  const int bands = (eq->band_count + 1) & ~1;
+  const __m128d vdx = _mm_set1_pd(dx);
+  __m128d vout = _mm_setzero_pd();
+  double sum[2];
+
+  for(; band < bands; band += 2)
+  {
+    const __m128d y1 = _mm_loadu_pd(h->y1 + band);
+    const __m128d y2 = _mm_loadu_pd(h->y2 + band);
+    /* y(n) = alpha * [x(n)-x(n-2)] + gamma * y(n-1) - beta * y(n-2) */
+    const __m128d y0 = _mm_sub_pd(_mm_add_pd(_mm_mul_pd(_mm_loadu_pd(eq->alpha + band), vdx),
+                                             _mm_mul_pd(_mm_loadu_pd(eq->gamma + band), y1)),
+                                  _mm_mul_pd(_mm_loadu_pd(eq->beta + band), y2));
+    _mm_storeu_pd(h->y2 + band, y1);
+    _mm_storeu_pd(h->y1 + band, y0);
+    /* Apply the gain */
+    vout = _mm_add_pd(vout, _mm_mul_pd(y0, _mm_loadu_pd(gain + band)));
+  }
 
-  int index, band, channel;
-  sample_t out[EQ_CHANNELS], pcm[EQ_CHANNELS];
+  _mm_storeu_pd(sum, vout);
+  out = sum[0] + sum[1];
+#endif
+
+  for(; band < eq->band_count; band++)
+  {
+    const sample_t y0 = eq->alpha[band] * dx
+                      + eq->gamma[band] * h->y1[band]
+                      - eq->beta[band] * h->y2[band];
+    h->y2[band] = h->y1[band];
+    h->y1[band] = y0;
+    out += y0 * gain[band];
+  }
+  return out;
+}
+
+/*
+ * Second pass, every band is fed with the output accumulated so far,
+ * so the bands depend on each other and run one by one
+ */
+static __inline__ sample_t eq_second_pass(const eq_state_t *eq, sXYData *h, const sample_t *gain,
+                                          sample_t out)
+{
+  int band;
+  for(band = 0; band < eq->band_count; band++)
+  {
+    sample_t y0;
+      /* Optimization */
+    if(gain[band] > -1.0e-10 && gain[band] < 1.0e-10)
+       continue;
+
+    /* y(n) = alpha * [x(n)-x(n-2)] + gamma * y(n-1) - beta * y(n-2) */
+    y0 = eq->alpha[band] * (out - h->x2[band])
+       + eq->gamma[band] * h->y1[band]
+       - eq->beta[band] * h->y2[band];
+
+    h->x2[band] = h->x1[band];
+    h->x1[band] = out;
+    h->y2[band] = h->y1[band];
+    h->y1[band] = y0;
+    /* Apply the gain */
+    out += y0 * gain[band];
+  }
+  return out;
+}
 
-#ifdef BENCHMARK
-  start_counter();
-#endif //BENCHMARK
+int eq_state_iir(eq_state_t *eq, float *d, int samples, int nch)
+{
+//  FTZ_ON;
+  float *data = (float *) d;
+  /* Channels above EQ_CHANNELS are left untouched */
+  const int channels = nch > EQ_CHANNELS ? EQ_CHANNELS : nch;
+  int index, channel;
+  sample_t out, pcm;
 
   /**
    * IIR filter equation is
@@ -80,71 +201,23 @@ __inline__ int eq_iir(float *d, int samples, int nch)
   for(index = 0; index < samples; index+=nch)
   {
     /* For each channel */
-    for(channel = 0; channel < nch; channel++)
+    for(channel = 0; channel < channels; channel++)
     {
-      pcm[channel] = data[index+channel];
+      pcm = data[index+channel];
       /* Preamp gain */
-      pcm[channel] *= preamp[channel];
+      pcm *= eq->preamp[channel];
 
-      /* add random noise */
-      //pcm[channel] += dither[di];
+      out = eq_first_pass(eq, &eq->data_history[channel], eq->gain[channel], pcm, eq->x2[channel]);
+      eq->x2[channel] = eq->x1[channel];
+      eq->x1[channel] = pcm;
 
-      out[channel] = 0.;
-      /* For each band */
-      for(band = 0; band < band_count; band++)
-      {
-          /* Optimization */
-        if(gain[channel][band] > -1.0e-10 && gain[channel][band] < 1.0e-10)
-            continue;
-
-        /* Store Xi(n) */
-        data_history[channel][band].x[i] = pcm[channel];
-        /* Calculate and store Yi(n) */
-        data_history[channel][band].y[i] =
-          (
-           /* 		= alpha * [x(n)-x(n-2)] */
-           iir_cf[band].alpha * ( data_history[channel][band].x[i]
-             -  data_history[channel][band].x[k])
-           /* 		+ gamma * y(n-1) */
-           + iir_cf[band].gamma * data_history[channel][band].y[j]
-           /* 		- beta * y(n-2) */
-           - iir_cf[band].beta * data_history[channel][band].y[k]
-          );
-        /*
-         * The multiplication by 2.0 was 'moved' into the coefficients to save
-         * CPU cycles here */
-        /* Apply the gain  */
-        out[channel] +=  data_history[channel][band].y[i]*gain[channel][band]; // * 2.0;
-      } /* For each band */
-
-      if(eq_options & EQ_TWO_PASSES)
+      if(eq->options & EQ_TWO_PASSES)
       {
         /* Filter the sample again */
-        for(band = 0; band < band_count; band++)
-        {
-            /* Optimization */
-          if(gain[channel][band] > -1.0e-10 && gain[channel][band] < 1.0e-10)
-             continue;
-
-          /* Store Xi(n) */
-          data_history2[channel][band].x[i] = out[channel];
-          /* Calculate and store Yi(n) */
-          data_history2[channel][band].y[i] =
-            (
-             /* y(n) = alpha * [x(n)-x(n-2)] */
-             iir_cf[band].alpha * (data_history2[channel][band].x[i]
-               -  data_history2[channel][band].x[k])
-             /* 	    + gamma * y(n-1) */
-             + iir_cf[band].gamma * data_history2[channel][band].y[j]
-             /* 		- beta * y(n-2) */
-             - iir_cf[band].beta * data_history2[channel][band].y[k]
-            );
-          /* Apply the gain */
-          out[channel] +=  data_history2[channel][band].y[i]*gain[channel][band];
-        } /* For each band */
+        out = eq_second_pass(eq, &eq->data_history2[channel], eq->gain[channel], out);
       }
 
-      if(eq_options & EQ_CLIP)
+      if(eq->options & EQ_CLIP)
       {
         /* Volume stuff
            Scale down original PCM sample and add it to the filters
@@ -152,36 +225,19 @@ __inline__ int eq_iir(float *d, int samples, int nch)
            Go back to use the floating point multiplication before the
            conversion to give more dynamic range
            */
-        out[channel] += pcm[channel]*0.25;
-        data[index+channel] = out[channel] > 1.0 ? 1.0 : (out[channel] < -1.0 ? -1.0 : out[channel]);
+        out += pcm*0.25;
+        data[index+channel] = out > 1.0 ? 1.0 : (out < -1.0 ? -1.0 : out);
       }
       else
       {
-        out[channel] += pcm[channel];
-        data[index+channel] = out[channel];
+        out += pcm;
+        data[index+channel] = out;
       }
 
     } /* For each channel */
 
-    /* Wrap around the indexes */
-    i = (i+1)%3;
-    j = (j+1)%3;
-    k = (k+1)%3;
-
   }/* For each pair of samples */
 
-#ifdef BENCHMARK
-  timex += get_counter();
-  blength += length;
-  if(count++ == 1024)
-  {
-    printf("FLOATING POINT: %f %d\n",timex/1024.0, blength/1024);
-    blength = 0;
-    timex = 0.;
-    count = 0;
-  }
-#endif // BENCHMARK
-
 //  FTZ_OFF;
   return samples;
 }
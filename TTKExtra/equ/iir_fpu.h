@@ -22,18 +22,43 @@
 #ifndef IIR_FPU_H
 #define IIR_FPU_H
 
+#include "iir.h"
+
 #define sample_t double
 
 /*
  * Normal FPU implementation data structures
  */
-/* Coefficient history for the IIR filter */
+/* History of all the bands of one channel, stored band by band so that
+ * neighbour bands are evaluated together */
 typedef struct
 {
-    sample_t x[3]; /* x[n], x[n-1], x[n-2] */
-    sample_t y[3]; /* y[n], y[n-1], y[n-2] */
-    sample_t dummy1; // Word alignment
-    sample_t dummy2;
+    sample_t x1[EQ_MAX_BANDS]; /* x[n-1] */
+    sample_t x2[EQ_MAX_BANDS]; /* x[n-2] */
+    sample_t y1[EQ_MAX_BANDS]; /* y[n-1] */
+    sample_t y2[EQ_MAX_BANDS]; /* y[n-2] */
 }sXYData;
 
+/* Equalizer instance */
+struct eq_state
+{
+    unsigned int rate;
+    int band_count;
+    unsigned int options;
+
+    /* Coefficients, bands above band_count are zero */
+    sample_t alpha[EQ_MAX_BANDS] __attribute__((aligned(16)));
+    sample_t beta[EQ_MAX_BANDS] __attribute__((aligned(16)));
+    sample_t gamma[EQ_MAX_BANDS] __attribute__((aligned(16)));
+
+    sample_t gain[EQ_CHANNELS][EQ_MAX_BANDS] __attribute__((aligned(16)));
+    float preamp[EQ_CHANNELS];
+
+    /* x[n-1] and x[n-2] of the first pass, the same for all the bands */
+    sample_t x1[EQ_CHANNELS];
+    sample_t x2[EQ_CHANNELS];
+    sXYData data_history[EQ_CHANNELS] __attribute__((aligned(16)));
+    sXYData data_history2[EQ_CHANNELS] __attribute__((aligned(16)));
+};
+
 #endif
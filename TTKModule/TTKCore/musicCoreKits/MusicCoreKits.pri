@@ -33,9 +33,11 @@ HEADERS  += \
     $$PWD/musicconnectionpool.h \
     $$PWD/musicplatformmanager.h \
     $$PWD/musicsingleton.h \
+    $$PWD/musicskinthumbnailcache.h \
     $$PWD/musiccoremplayer.h \
     $$PWD/musicsong.h \
     $$PWD/musicsongtag.h \
+    $$PWD/musicsongtagmanager.h \
     $$PWD/musiccryptographichash.h \
     $$PWD/musicbackgroundmanager.h \
     $$PWD/musicsemaphoreloop.h \
@@ -61,8 +63,10 @@ SOURCES += \
     $$PWD/musicplatformmanager.cpp \
     $$PWD/musiccoremplayer.cpp \
     $$PWD/musicsingleton.cpp \
+    $$PWD/musicskinthumbnailcache.cpp \
     $$PWD/musicsong.cpp \
     $$PWD/musicsongtag.cpp \
+    $$PWD/musicsongtagmanager.cpp \
     $$PWD/musiccryptographichash.cpp \
     $$PWD/musicbackgroundmanager.cpp \
     $$PWD/musicsemaphoreloop.cpp \
@@ -13,12 +13,13 @@ MusicAbstractThread::~MusicAbstractThread()
 
 void MusicAbstractThread::stopAndQuitThread()
 {
+    ///let the run loop see the stop before waiting for it
+    m_running = false;
     if(isRunning())
     {
         quit();
         wait();
     }
-    m_running = false;
 }
 
 void MusicAbstractThread::start()
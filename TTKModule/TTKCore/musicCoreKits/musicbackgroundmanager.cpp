@@ -1,9 +1,14 @@
 #include "musicbackgroundmanager.h"
 #include "musicstringutils.h"
 
+#include <QFileSystemWatcher>
+
 MusicBackgroundManager::MusicBackgroundManager()
 {
     m_currentIndex = 0;
+    m_directoryChanged = true;
+    m_directoryWatcher = new QFileSystemWatcher(this);
+    connect(m_directoryWatcher, SIGNAL(directoryChanged(QString)), SLOT(backgroundDirectoryChanged()));
 }
 
 void MusicBackgroundManager::setArtistName(const QString &name)
@@ -15,12 +20,14 @@ void MusicBackgroundManager::setArtistName(const QString &name)
     }
 
     m_photos.clear();
-    const QString &filter = BACKGROUND_DIR_FULL + (m_currentArtistName = sName) + "%1" + SKN_FILE;
+    updateBackgroundDirectory();
+
+    const QString &filter = (m_currentArtistName = sName) + "%1" + SKN_FILE;
     for(int i=0; i<MAX_INDEX; ++i)
     {
-        if(QFile::exists(filter.arg(i)))
+        if(m_directoryFiles.contains(filter.arg(i)))
         {
-            m_photos << filter.arg(i);
+            m_photos << BACKGROUND_DIR_FULL + filter.arg(i);
         }
     }
     Q_EMIT artistNameChanged();
@@ -121,3 +128,30 @@ void MusicBackgroundManager::backgroundHasChanged()
 {
     Q_EMIT backgroundChanged();
 }
+
+void MusicBackgroundManager::backgroundDirectoryChanged()
+{
+    m_directoryChanged = true;
+}
+
+void MusicBackgroundManager::updateBackgroundDirectory()
+{
+    if(!m_directoryChanged)
+    {
+        return;
+    }
+
+    const QString &path = BACKGROUND_DIR_FULL;
+    if(m_directoryWatcher->directories().isEmpty() && QDir(path).exists())
+    {
+        m_directoryWatcher->addPath(path);
+    }
+    ///keep listing every time until the directory is watched
+    m_directoryChanged = m_directoryWatcher->directories().isEmpty();
+
+    m_directoryFiles.clear();
+    foreach(const QString &file, QDir(path).entryList(QStringList() << QString("*%1").arg(SKN_FILE), QDir::Files))
+    {
+        m_directoryFiles.insert(file);
+    }
+}
@@ -24,6 +24,8 @@
 
 #define MAX_INDEX 5
 
+class QFileSystemWatcher;
+
 /*! @brief The class of the manager of dealing with artist pictures.
  * @author Greedysky <greedysky@163.com>
  */
@@ -116,6 +118,12 @@ public:
      */
     void backgroundHasChanged();
 
+public Q_SLOTS:
+    /*!
+     * Artist photo directory changed, list it again when needed.
+     */
+    void backgroundDirectoryChanged();
+
 Q_SIGNALS:
     /*!
      * Background image changed.
@@ -136,7 +144,15 @@ protected:
      */
     MusicBackgroundManager();
 
+    /*!
+     * List artist photo directory if changed.
+     */
+    void updateBackgroundDirectory();
+
     int m_currentIndex;
+    bool m_directoryChanged;
+    QSet<QString> m_directoryFiles;
+    QFileSystemWatcher *m_directoryWatcher;
     QStringList m_photos;
     QList<QObject*> m_observer;
     QString m_currentArtistName, m_background;
@@ -158,6 +158,8 @@ void MusicConfigManager::readSysConfigData() const
                      readXmlAttributeByTagNameValue("enhancedMonoStereo").toInt());
     M_SETTING_PTR->setValue(MusicSettingManager::EnhancedMono,
                      readXmlAttributeByTagNameValue("enhancedMono").toInt());
+    M_SETTING_PTR->setValue(MusicSettingManager::EnhancedGapless,
+                     readXmlAttributeByTagNameValue("enhancedGapless").toInt());
 
 
     M_SETTING_PTR->setValue(MusicSettingManager::TimerAutoIndex,
@@ -299,6 +301,7 @@ void MusicConfigManager::writeSysConfigData()
     const int enhancedSRC = M_SETTING_PTR->value(MusicSettingManager::EnhancedSRC).toInt();
     const int enhancedMonoStereo = M_SETTING_PTR->value(MusicSettingManager::EnhancedMonoStereo).toInt();
     const int enhancedMono = M_SETTING_PTR->value(MusicSettingManager::EnhancedMono).toInt();
+    const int enhancedGapless = M_SETTING_PTR->value(MusicSettingManager::EnhancedGapless).toInt();
 
     //
     const int timeAutoIndex = M_SETTING_PTR->value(MusicSettingManager::TimerAutoIndex).toInt();
@@ -434,6 +437,7 @@ void MusicConfigManager::writeSysConfigData()
     writeDomElement(equalizerSettingDom, "enhancedSRC", MusicXmlAttribute("value", enhancedSRC));
     writeDomElement(equalizerSettingDom, "enhancedMonoStereo", MusicXmlAttribute("value", enhancedMonoStereo));
     writeDomElement(equalizerSettingDom, "enhancedMono", MusicXmlAttribute("value", enhancedMono));
+    writeDomElement(equalizerSettingDom, "enhancedGapless", MusicXmlAttribute("value", enhancedGapless));
 
     //
     writeDomElement(timeSettingDom, "timeAutoIndex", MusicXmlAttribute("value", timeAutoIndex));
@@ -13,7 +13,8 @@
 #  pragma GCC diagnostic ignored "-Wsign-compare"
 #endif
 
-bool MusicExtractWrap::outputThunderSkin(QPixmap &image, const QString &input)
+///read the skin image data and config, the image entry is skipped when data is null
+static bool readSkinData(QByteArray *data, MusicSkinConfigItem *item, const QString &input)
 {
     const unzFile &zFile = unzOpen64(input.toLocal8Bit().constData());
     if(!zFile)
@@ -49,7 +50,7 @@ bool MusicExtractWrap::outputThunderSkin(QPixmap &image, const QString &input)
         int size = 0;
 
         QByteArray arrayData;
-        if(QString(file).toLower().contains("image/bkg"))
+        if(data && QString(file).toLower().contains(SKN_FILE))
         {
             while(true)
             {
@@ -60,7 +61,26 @@ bool MusicExtractWrap::outputThunderSkin(QPixmap &image, const QString &input)
                 }
                 arrayData.append(dt, size);
             }
-            image.loadFromData(arrayData);
+
+            *data = arrayData;
+        }
+        else if(QString(file).toLower().contains(XML_FILE))
+        {
+            while(true)
+            {
+                size= unzReadCurrentFile(zFile, dt, sizeof(dt));
+                if(size <= 0)
+                {
+                    break;
+                }
+                arrayData.append(dt, size);
+            }
+
+            MusicSkinConfigManager manager;
+            if(manager.fromByteArray(arrayData))
+            {
+                manager.readSkinData(*item);
+            }
         }
 
         unzCloseCurrentFile(zFile);
@@ -75,18 +95,7 @@ bool MusicExtractWrap::outputThunderSkin(QPixmap &image, const QString &input)
     return true;
 }
 
-bool MusicExtractWrap::outputBinary(const QString &input)
-{
-    return outputBinary(input, QFileInfo(input).absolutePath() + "/" + QFileInfo(input).baseName() + "/");
-}
-
-bool MusicExtractWrap::outputBinary(const QString &input, const QString &output)
-{
-    QStringList path;
-    return outputBinary(input, output, path);
-}
-
-bool MusicExtractWrap::outputBinary(const QString &input, const QString &output, QStringList &path)
+bool MusicExtractWrap::outputThunderSkin(QPixmap &image, const QString &input)
 {
     const unzFile &zFile = unzOpen64(input.toLocal8Bit().constData());
     if(!zFile)
@@ -94,10 +103,6 @@ bool MusicExtractWrap::outputBinary(const QString &input, const QString &output,
         return false;
     }
 
-    QDir dir;
-    dir.mkpath(output);
-    dir.cd(output);
-
     unz_file_info64 fileInfo;
     unz_global_info64 gInfo;
     if(unzGetGlobalInfo64(zFile, &gInfo) != UNZ_OK)
@@ -117,11 +122,6 @@ bool MusicExtractWrap::outputBinary(const QString &input, const QString &output,
             break;
         }
 
-        if(QString(file).contains("/"))
-        {
-            dir.mkpath(QFileInfo(file).path());
-        }
-
         if(unzOpenCurrentFile(zFile) != UNZ_OK)
         {
             break;
@@ -130,20 +130,21 @@ bool MusicExtractWrap::outputBinary(const QString &input, const QString &output,
         char dt[MH_KB] = {0};
         int size = 0;
 
-        QFile outputFile(output + file);
-        outputFile.open(QFile::WriteOnly);
-        while(true)
+        QByteArray arrayData;
+        if(QString(file).toLower().contains("image/bkg"))
         {
-            size= unzReadCurrentFile(zFile, dt, sizeof(dt));
-            if(size <= 0)
+            while(true)
             {
-                break;
+                size= unzReadCurrentFile(zFile, dt, sizeof(dt));
+                if(size <= 0)
+                {
+                    break;
+                }
+                arrayData.append(dt, size);
             }
-            outputFile.write(dt, size);
+            image.loadFromData(arrayData);
         }
 
-        outputFile.close();
-        path << outputFile.fileName();
         unzCloseCurrentFile(zFile);
 
         if(i < gInfo.number_entry - 1 && unzGoToNextFile(zFile) != UNZ_OK)
@@ -156,7 +157,18 @@ bool MusicExtractWrap::outputBinary(const QString &input, const QString &output,
     return true;
 }
 
-bool MusicExtractWrap::outputSkin(MusicBackgroundImage *image, const QString &input)
+bool MusicExtractWrap::outputBinary(const QString &input)
+{
+    return outputBinary(input, QFileInfo(input).absolutePath() + "/" + QFileInfo(input).baseName() + "/");
+}
+
+bool MusicExtractWrap::outputBinary(const QString &input, const QString &output)
+{
+    QStringList path;
+    return outputBinary(input, output, path);
+}
+
+bool MusicExtractWrap::outputBinary(const QString &input, const QString &output, QStringList &path)
 {
     const unzFile &zFile = unzOpen64(input.toLocal8Bit().constData());
     if(!zFile)
@@ -164,6 +176,10 @@ bool MusicExtractWrap::outputSkin(MusicBackgroundImage *image, const QString &in
         return false;
     }
 
+    QDir dir;
+    dir.mkpath(output);
+    dir.cd(output);
+
     unz_file_info64 fileInfo;
     unz_global_info64 gInfo;
     if(unzGetGlobalInfo64(zFile, &gInfo) != UNZ_OK)
@@ -183,6 +199,11 @@ bool MusicExtractWrap::outputSkin(MusicBackgroundImage *image, const QString &in
             break;
         }
 
+        if(QString(file).contains("/"))
+        {
+            dir.mkpath(QFileInfo(file).path());
+        }
+
         if(unzOpenCurrentFile(zFile) != UNZ_OK)
         {
             break;
@@ -191,44 +212,20 @@ bool MusicExtractWrap::outputSkin(MusicBackgroundImage *image, const QString &in
         char dt[MH_KB] = {0};
         int size = 0;
 
-        QByteArray arrayData;
-        if(QString(file).toLower().contains(SKN_FILE))
-        {
-            while(true)
-            {
-                size= unzReadCurrentFile(zFile, dt, sizeof(dt));
-                if(size <= 0)
-                {
-                    break;
-                }
-                arrayData.append(dt, size);
-            }
-
-            QPixmap pix;
-            pix.loadFromData(arrayData);
-            image->m_pix = pix;
-        }
-        else if(QString(file).toLower().contains(XML_FILE))
+        QFile outputFile(output + file);
+        outputFile.open(QFile::WriteOnly);
+        while(true)
         {
-            while(true)
-            {
-                size= unzReadCurrentFile(zFile, dt, sizeof(dt));
-                if(size <= 0)
-                {
-                    break;
-                }
-                arrayData.append(dt, size);
-            }
-
-            MusicSkinConfigManager manager;
-            MusicSkinConfigItem item;
-            if(manager.fromByteArray(arrayData))
+            size= unzReadCurrentFile(zFile, dt, sizeof(dt));
+            if(size <= 0)
             {
-                manager.readSkinData(item);
-                image->m_item = item;
+                break;
             }
+            outputFile.write(dt, size);
         }
 
+        outputFile.close();
+        path << outputFile.fileName();
         unzCloseCurrentFile(zFile);
 
         if(i < gInfo.number_entry - 1 && unzGoToNextFile(zFile) != UNZ_OK)
@@ -241,6 +238,30 @@ bool MusicExtractWrap::outputSkin(MusicBackgroundImage *image, const QString &in
     return true;
 }
 
+bool MusicExtractWrap::outputSkin(MusicBackgroundImage *image, const QString &input)
+{
+    QByteArray data;
+    if(!outputSkin(data, &image->m_item, input))
+    {
+        return false;
+    }
+
+    QPixmap pix;
+    pix.loadFromData(data);
+    image->m_pix = pix;
+    return true;
+}
+
+bool MusicExtractWrap::outputSkin(QByteArray &data, MusicSkinConfigItem *item, const QString &input)
+{
+    return readSkinData(&data, item, input);
+}
+
+bool MusicExtractWrap::outputSkin(MusicSkinConfigItem *item, const QString &input)
+{
+    return readSkinData(nullptr, item, input);
+}
+
 bool MusicExtractWrap::inputSkin(MusicBackgroundImage *image, const QString &output)
 {
     const zipFile &zFile = zipOpen64(output.toLocal8Bit().constData(), 0);
@@ -22,6 +22,7 @@
 #include "musicglobaldefine.h"
 
 class MusicBackgroundImage;
+class MusicSkinConfigItem;
 
 /*! @brief The class of the extract data wrap.
  * @author Greedysky <greedysky@163.com>
@@ -52,6 +53,14 @@ public:
      * Transfer file to image data.
      */
     static bool outputSkin(MusicBackgroundImage *image, const QString &input);
+    /*!
+     * Transfer file to raw image data without decoding.
+     */
+    static bool outputSkin(QByteArray &data, MusicSkinConfigItem *item, const QString &input);
+    /*!
+     * Transfer file to skin config only, the image data is skipped.
+     */
+    static bool outputSkin(MusicSkinConfigItem *item, const QString &input);
     /*!
      * Transfer image data to file.
      */
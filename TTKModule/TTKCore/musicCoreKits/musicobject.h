@@ -122,6 +122,7 @@
 #define BACKGROUND_DIR          "MArt/background/"
 #define CACHE_DIR               "MCached/"
 #define SCREEN_DIR              "MScreen/"
+#define THUMBNAIL_DIR           "MThumbnail/"
 //
 #define AVATAR_DIR              "avatar/"
 #define USER_THEME_DIR          "theme/"
@@ -143,6 +144,8 @@
 #define TEMPPATH                "musictemp"
 #define COFIGPATH               "musicconfig.xml"
 #define MUSICPATH               "music.tkpl"
+#define MUSICSNAPSHOTPATH       "music.tkpb"
+#define MUSICJOURNALPATH        "music.tkpj"
 #define NORMALDOWNPATH          "musicdown.ttk"
 #define CLOUDDOWNPATH           "musiccloud.ttk"
 #define CLOUDUPPATH             "musiccloudp.ttk"
@@ -150,6 +153,8 @@
 #define DARABASEPATH            "musicuser.dll"
 #define USERPATH                "musicuser.ttk"
 #define BARRAGEPATH             "musicbarrage.ttk"
+#define METAINDEXPATH           "musicmeta.ttk"
+#define LOCALSCANPATH           "musiclocal.ttk"
 
 
 //
@@ -174,10 +179,15 @@
 #define ART_DIR_FULL            APPCACHE_DIR_FULL + ART_DIR
 #define BACKGROUND_DIR_FULL     APPCACHE_DIR_FULL + BACKGROUND_DIR
 #define SCREEN_DIR_FULL         APPCACHE_DIR_FULL + SCREEN_DIR
+#define THUMBNAIL_DIR_FULL      APPCACHE_DIR_FULL + THUMBNAIL_DIR
+#define METAINDEXPATH_FULL      APPCACHE_DIR_FULL + METAINDEXPATH
+#define LOCALSCANPATH_FULL      APPCACHE_DIR_FULL + LOCALSCANPATH
 
 
 #define COFIGPATH_FULL          APPDATA_DIR_FULL + COFIGPATH
 #define MUSICPATH_FULL          APPDATA_DIR_FULL + MUSICPATH
+#define MUSICSNAPSHOTPATH_FULL  APPDATA_DIR_FULL + MUSICSNAPSHOTPATH
+#define MUSICJOURNALPATH_FULL   APPDATA_DIR_FULL + MUSICJOURNALPATH
 #define NORMALDOWNPATH_FULL     APPDATA_DIR_FULL + NORMALDOWNPATH
 #define CLOUDDOWNPATH_FULL      APPDATA_DIR_FULL + CLOUDDOWNPATH
 #define CLOUDUPPATH_FULL        APPDATA_DIR_FULL + CLOUDUPPATH
@@ -1,5 +1,4 @@
 #include "musicplayer.h"
-#include "musicplaylist.h"
 #include "musicsettingmanager.h"
 #include "musicconnectionpool.h"
 ///qmmp incldue
@@ -18,10 +17,24 @@ MusicPlayer::MusicPlayer(QObject *parent)
     m_volumeMusic3D = 0;
     m_duration = 0;
     m_durationTimes = 0;
+    m_nextIndex = -1;
+    m_mediaEnded = false;
+    m_transitionStart = -1;
+    m_elapsedTime = 0;
+    m_elapsedAt = -1;
+    m_transitionGap = -1;
+    m_transitionTotal = 0;
+    m_transitionCount = 0;
 
     setEnabledEffect(false);
+    m_clock.start();
 
     connect(&m_timer, SIGNAL(timeout()), SLOT(update()));
+    connect(m_music, SIGNAL(nextTrackRequest()), SLOT(nextTrackRequest()));
+    connect(m_music, SIGNAL(trackInfoChanged()), SLOT(trackInfoChanged()));
+    connect(m_music, SIGNAL(elapsedChanged(qint64)), SLOT(elapsedChanged(qint64)));
+    connect(m_music, SIGNAL(finished()), SLOT(finished()));
+    connect(m_music, SIGNAL(stateChanged(Qmmp::State)), SLOT(engineStateChanged()));
     M_CONNECTION_PTR->setValue(getClassName(), this);
 }
 
@@ -121,6 +134,16 @@ MusicPlayer::Enhanced MusicPlayer::getMusicEnhanced() const
     return m_musicEnhanced;
 }
 
+qint64 MusicPlayer::lastTransitionGap() const
+{
+    return m_transitionGap;
+}
+
+qint64 MusicPlayer::averageTransitionGap() const
+{
+    return m_transitionCount == 0 ? -1 : m_transitionTotal / m_transitionCount;
+}
+
 void MusicPlayer::play()
 {
     if(m_playlist->isEmpty())
@@ -139,11 +162,14 @@ void MusicPlayer::play()
         return;
     }
 
+    m_nextIndex = -1;
+    m_nextItem = MusicPlayItem();
     m_currentMedia = m_playlist->currentMediaPath();
     ///The current playback path
     if(!m_music->play(m_currentMedia))
     {
         m_state = MusicObject::PS_StoppedState;
+        m_transitionStart = -1;
         return;
     }
 
@@ -164,6 +190,9 @@ void MusicPlayer::pause()
 
 void MusicPlayer::stop()
 {
+    m_nextIndex = -1;
+    m_nextItem = MusicPlayItem();
+    m_transitionStart = -1;
     m_music->stop();
     m_timer.stop();
     m_state = MusicObject::PS_StoppedState;
@@ -219,6 +248,9 @@ void MusicPlayer::setEqInformation()
 
 void MusicPlayer::removeCurrentMedia()
 {
+    m_nextIndex = -1;
+    m_nextItem = MusicPlayItem();
+    m_transitionStart = -1;
     m_timer.stop();
     m_music->stop();
 }
@@ -235,27 +267,11 @@ void MusicPlayer::update()
         m_music->setVolume(fabs(100 * cosf(m_posOnCircle)), fabs(100 * sinf(m_posOnCircle * 0.5f)));
     }
 
+    ///Fallback for the media ended without finished event, such as decode error
     const Qmmp::State state = m_music->state();
-    if(state != Qmmp::Playing && state != Qmmp::Paused)
+    if(state != Qmmp::Playing && state != Qmmp::Paused && state != Qmmp::Buffering)
     {
-        m_timer.stop();
-        if(m_playlist->playbackMode() == MusicObject::PM_PlayOnce)
-        {
-            m_music->stop();
-            Q_EMIT positionChanged(0);
-            Q_EMIT stateChanged(MusicObject::PS_StoppedState);
-            return;
-        }
-
-        m_playlist->setCurrentIndex();
-        if(m_playlist->playbackMode() == MusicObject::PM_PlayOrder && m_playlist->currentIndex() == -1)
-        {
-            m_music->stop();
-            Q_EMIT positionChanged(0);
-            Q_EMIT stateChanged(MusicObject::PS_StoppedState);
-            return;
-        }
-        play();
+        mediaEnded();
     }
 }
 
@@ -272,6 +288,102 @@ void MusicPlayer::queryCurrentDuration()
     }
 }
 
+void MusicPlayer::nextTrackRequest()
+{
+    if(!M_SETTING_PTR->value(MusicSettingManager::EnhancedGapless).toBool() || !isPlaying())
+    {
+        return;
+    }
+
+    if(m_playlist->playbackMode() == MusicObject::PM_PlayOnce)
+    {
+        return;
+    }
+
+    ///Open and decode next media while current one is playing
+    const int index = m_playlist->nextIndex();
+    if(index < 0 || index >= m_playlist->mediaCount())
+    {
+        return;
+    }
+
+    const MusicPlayItem item = m_playlist->mediaList()->at(index);
+    if(item.isValid() && m_music->play(item.m_path, true))
+    {
+        ///Keep the queued one, the mode or list may change before it starts
+        m_nextIndex = index;
+        m_nextItem = item;
+    }
+}
+
+void MusicPlayer::trackInfoChanged()
+{
+    if(!m_nextItem.isValid() || m_music->path() != m_nextItem.m_path)
+    {
+        return;
+    }
+
+    ///Queued media has been started by engine without stop, previous one
+    ///ended where its last elapsed time would have reached its duration
+    if(m_elapsedAt >= 0)
+    {
+        const qint64 left = qMax(TTKStatic_cast(qint64, 0), m_duration - m_elapsedTime) * MT_MS2US * MT_MS2US;
+        m_transitionStart = qMin(m_clock.nsecsElapsed(), m_elapsedAt + left);
+    }
+    else
+    {
+        m_transitionStart = m_clock.nsecsElapsed();
+    }
+
+    m_playlist->setCurrentItem(m_nextIndex, m_nextItem);
+    m_nextIndex = -1;
+    m_nextItem = MusicPlayItem();
+    m_currentMedia = m_playlist->currentMediaPath();
+
+    m_durationTimes = 0;
+    queryCurrentDuration();
+    Q_EMIT positionChanged(0);
+}
+
+void MusicPlayer::elapsedChanged(qint64 time)
+{
+    const qint64 now = m_clock.nsecsElapsed();
+    m_elapsedTime = time;
+    m_elapsedAt = now;
+
+    if(m_transitionStart < 0)
+    {
+        return;
+    }
+
+    ///Wall time since previous media ended minus audio already played is the silence
+    m_transitionGap = qMax(TTKStatic_cast(qint64, 0), (now - m_transitionStart) / MT_MS2US - time * MT_MS2US);
+    m_transitionTotal += m_transitionGap;
+    ++m_transitionCount;
+    m_transitionStart = -1;
+    TTK_LOGGER_INFO(QString("Music player inter track gap %1 us").arg(m_transitionGap));
+}
+
+void MusicPlayer::finished()
+{
+    ///The poll fallback has already switched for this media end
+    if(m_mediaEnded)
+    {
+        return;
+    }
+
+    mediaEnded();
+}
+
+void MusicPlayer::engineStateChanged()
+{
+    ///The events of previous media are all delivered before the new one plays
+    if(m_music->state() == Qmmp::Playing)
+    {
+        m_mediaEnded = false;
+    }
+}
+
 void MusicPlayer::setMusicEnhancedCase()
 {
     switch(m_musicEnhanced)
@@ -292,3 +404,42 @@ void MusicPlayer::setMusicEnhancedCase()
             break;
     }
 }
+
+void MusicPlayer::mediaEnded()
+{
+    m_mediaEnded = true;
+    m_elapsedAt = -1;
+    m_transitionStart = m_clock.nsecsElapsed();
+    playNextByMode();
+}
+
+void MusicPlayer::playNextByMode()
+{
+    if(!isPlaying())
+    {
+        return;
+    }
+
+    m_timer.stop();
+    m_nextIndex = -1;
+    m_nextItem = MusicPlayItem();
+    if(m_playlist->playbackMode() == MusicObject::PM_PlayOnce)
+    {
+        m_music->stop();
+        m_transitionStart = -1;
+        Q_EMIT positionChanged(0);
+        Q_EMIT stateChanged(MusicObject::PS_StoppedState);
+        return;
+    }
+
+    m_playlist->setCurrentIndex();
+    if(m_playlist->playbackMode() == MusicObject::PM_PlayOrder && m_playlist->currentIndex() == -1)
+    {
+        m_music->stop();
+        m_transitionStart = -1;
+        Q_EMIT positionChanged(0);
+        Q_EMIT stateChanged(MusicObject::PS_StoppedState);
+        return;
+    }
+    play();
+}
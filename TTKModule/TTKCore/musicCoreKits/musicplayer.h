@@ -20,15 +20,14 @@
  ================================================= */
 
 #include <QTimer>
-#include "musicobject.h"
-#include "musicglobaldefine.h"
+#include <QElapsedTimer>
+#include "musicplaylist.h"
 
 #ifdef Q_CC_GNU
 #  pragma GCC diagnostic ignored "-Wswitch"
 #endif
 
 class SoundCore;
-class MusicPlaylist;
 
 /*! @brief The class of the music player.
  * @author Greedysky <greedysky@163.com>
@@ -119,6 +118,15 @@ public:
      */
     Enhanced getMusicEnhanced() const;
 
+    /*!
+     * Get last inter track gap in microseconds, -1 means no transition yet.
+     */
+    qint64 lastTransitionGap() const;
+    /*!
+     * Get average inter track gap in microseconds, -1 means no transition yet.
+     */
+    qint64 averageTransitionGap() const;
+
 Q_SIGNALS:
     /*!
      * Current state changed.
@@ -172,21 +180,60 @@ private Q_SLOTS:
      * Query current duration by time out.
      */
     void queryCurrentDuration();
+    /*!
+     * Queue next media before current media ends.
+     */
+    void nextTrackRequest();
+    /*!
+     * Current track info changed, queued media started.
+     */
+    void trackInfoChanged();
+    /*!
+     * Engine elapsed time changed.
+     */
+    void elapsedChanged(qint64 time);
+    /*!
+     * Current media play finished.
+     */
+    void finished();
+    /*!
+     * Engine state changed.
+     */
+    void engineStateChanged();
 
 protected:
     /*!
      * Set current music enhanced effect option.
      */
     void setMusicEnhancedCase();
+    /*!
+     * Switch to next media by play mode when current ends.
+     */
+    void playNextByMode();
+    /*!
+     * Switch to next media once for the current media end.
+     */
+    void mediaEnded();
 
     MusicPlaylist *m_playlist;
     MusicObject::PlayState m_state;
     SoundCore *m_music;
     QTimer m_timer;
     QString m_currentMedia;
+    int m_nextIndex;
+    MusicPlayItem m_nextItem;
+    bool m_mediaEnded;
     Enhanced m_musicEnhanced;
     qint64 m_duration;
 
+    QElapsedTimer m_clock;
+    qint64 m_transitionStart;
+    qint64 m_elapsedTime;
+    qint64 m_elapsedAt;
+    qint64 m_transitionGap;
+    qint64 m_transitionTotal;
+    int m_transitionCount;
+
     int m_durationTimes;
     int m_volumeMusic3D;
     float m_posOnCircle;
@@ -6,6 +6,7 @@ MusicPlaylist::MusicPlaylist(QObject *parent)
 {
     MusicTime::initRandom();
     m_currentIndex = -1;
+    m_randomIndex = -1;
     m_playbackMode = MusicObject::PM_PlayOrder;
 }
 
@@ -54,6 +55,56 @@ QString MusicPlaylist::currentMediaPath() const
     return currentItem().m_path;
 }
 
+int MusicPlaylist::nextIndex()
+{
+    if(m_mediaList.isEmpty())
+    {
+        return -1;
+    }
+
+    if(!m_laterMediaList.isEmpty())
+    {
+        const int index = m_laterMediaList.first().m_toolIndex;
+        return (index < 0 || index >= m_mediaList.count()) ? -1 : index;
+    }
+
+    int index = m_currentIndex;
+    switch(m_playbackMode)
+    {
+        case MusicObject::PM_PlayOneLoop: break;
+        case MusicObject::PM_PlayOrder:
+            if(++index >= m_mediaList.count())
+            {
+                index = -1;
+            }
+            break;
+        case MusicObject::PM_PlaylistLoop:
+            if(++index >= m_mediaList.count())
+            {
+                index = 0;
+            }
+            break;
+        case MusicObject::PM_PlayRandom:
+            if(m_randomIndex < 0 || m_randomIndex >= m_mediaList.count())
+            {
+                m_randomIndex = rand() % m_mediaList.count();
+            }
+            index = m_randomIndex;
+            break;
+        case MusicObject::PM_PlayOnce :
+            break;
+        default: break;
+    }
+
+    return index;
+}
+
+MusicPlayItem MusicPlaylist::nextItem()
+{
+    const int index = nextIndex();
+    return (index < 0 || index >= m_mediaList.count()) ? MusicPlayItem() : m_mediaList[index];
+}
+
 MusicPlayItems MusicPlaylist::mediaListConst() const
 {
     return m_mediaList;
@@ -187,33 +238,13 @@ void MusicPlaylist::setCurrentIndex(int index)
 {
     if(index == DEFAULT_LEVEL_NORMAL)
     {
-        switch(m_playbackMode)
-        {
-            case MusicObject::PM_PlayOneLoop: break;
-            case MusicObject::PM_PlayOrder:
-                if(++m_currentIndex >= m_mediaList.count())
-                {
-                    m_currentIndex = -1;
-                }
-                break;
-            case MusicObject::PM_PlaylistLoop:
-                if(++m_currentIndex >= m_mediaList.count())
-                {
-                    m_currentIndex = 0;
-                }
-                break;
-            case MusicObject::PM_PlayRandom:
-                m_currentIndex = rand() % m_mediaList.count();
-                break;
-            case MusicObject::PM_PlayOnce :
-                break;
-            default: break;
-        }
+        m_currentIndex = nextIndex();
     }
     else
     {
         m_currentIndex = index;
     }
+    m_randomIndex = -1;
 
     if(!m_laterMediaList.isEmpty())
     {
@@ -233,3 +264,21 @@ void MusicPlaylist::setCurrentIndex(int toolIndex, const QString &path)
     const int playIndex = mapItemIndex(MusicPlayItem(toolIndex, path));
     setCurrentIndex(playIndex);
 }
+
+void MusicPlaylist::setCurrentItem(int index, const MusicPlayItem &item)
+{
+    ///the list may be changed after the item is queued, find it again then
+    if(index < 0 || index >= m_mediaList.count() || !(m_mediaList[index] == item))
+    {
+        index = mapItemIndex(item);
+    }
+
+    if(!m_laterMediaList.isEmpty() && m_laterMediaList.first().m_toolIndex == index)
+    {
+        m_laterMediaList.removeFirst();
+    }
+
+    m_currentIndex = index;
+    m_randomIndex = -1;
+    Q_EMIT currentIndexChanged(m_currentIndex);
+}
@@ -89,6 +89,15 @@ public:
      * Get current play music media path.
      */
     QString currentMediaPath() const;
+    /*!
+     * Get next play index by current play mode, -1 means no next item.
+     * The random choice is kept until the index is applied.
+     */
+    int nextIndex();
+    /*!
+     * Get next play item by current play mode.
+     */
+    MusicPlayItem nextItem();
 
     /*!
      * Get all music media path.
@@ -190,9 +199,14 @@ public Q_SLOTS:
      * Set current play index.
      */
     void setCurrentIndex(int toolIndex, const QString &path);
+    /*!
+     * Set current play index to the queued item which is already playing.
+     */
+    void setCurrentItem(int index, const MusicPlayItem &item);
 
 protected:
     int m_currentIndex;
+    int m_randomIndex;
     MusicPlayItems m_mediaList;
     MusicPlayItems m_laterMediaList;
     MusicObject::PlayMode m_playbackMode;
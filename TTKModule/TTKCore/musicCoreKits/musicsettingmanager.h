@@ -20,6 +20,8 @@
  ================================================= */
 
 #include <QMetaEnum>
+#include <QReadWriteLock>
+#include <algorithm>
 #include "musicobject.h"
 #include "musicsingleton.h"
 
@@ -114,6 +116,7 @@ public:
         EnhancedSRC,                     /*!< Enhanced SRC Parameter*/
         EnhancedMonoStereo,              /*!< Enhanced Mono Stereo Parameter*/
         EnhancedMono,                    /*!< Enhanced Mono Parameter*/
+        EnhancedGapless,                 /*!< Enhanced Gapless Parameter*/
 
         TimerAutoIndex,                  /*!< Timer Auto Index Parameter*/
         TimerAutoPlay,                   /*!< Timer Auto Play Parameter*/
@@ -143,12 +146,13 @@ public:
         HotkeyEnable,                    /*!< Hotkey Enable Parameter*/
         HotkeyString,                    /*!< Hotkey String Parameter*/
 
-        NetworkCookie                    /*!< Network cookie Parameter*/
+        NetworkCookie,                   /*!< Network cookie Parameter*/
 
 #ifdef MUSIC_MOBILE
-        ,MobileWifiConnect               /*!< Mobile Wifi Connect Parameter*/
+        MobileWifiConnect,               /*!< Mobile Wifi Connect Parameter*/
 #endif
 
+        Count                            /*!< Parameter Count*/
     };
 
     /*!
@@ -156,7 +160,26 @@ public:
      */
     inline void setValue(ConfigType type, const QVariant &var)
     {
-        m_para[type] = var;
+        if(type <= Null || type >= Count)
+        {
+            return;
+        }
+
+        {
+            QWriteLocker locker(&m_lock);
+            if(m_contains[type] && m_para[type] == var)
+            {
+                return;
+            }
+
+            m_para[type] = var;
+            m_contains[type] = true;
+            m_intPara[type].fetchAndStoreRelease(var.toInt());
+            m_boolPara[type].fetchAndStoreRelease(var.toBool());
+        }
+
+        m_dirty.fetchAndStoreRelease(1);
+        Q_EMIT parameterChanged(type, var);
     }
 
     /*!
@@ -164,7 +187,7 @@ public:
      */
     inline void setValue(const QString &stype, const QVariant &var)
     {
-        m_para[typeStringToEnum(stype)] = var;
+        setValue(typeStringToEnum(stype), var);
     }
 
     /*!
@@ -172,6 +195,12 @@ public:
      */
     inline QVariant value(ConfigType type) const
     {
+        if(type <= Null || type >= Count)
+        {
+            return QVariant();
+        }
+
+        QReadLocker locker(&m_lock);
         return m_para[type];
     }
 
@@ -180,7 +209,23 @@ public:
      */
     inline QVariant value(const QString &stype) const
     {
-        return m_para[typeStringToEnum(stype)];
+        return value(typeStringToEnum(stype));
+    }
+
+    /*!
+     * Get current value as int by Config Type, lock free.
+     */
+    inline int intValue(ConfigType type) const
+    {
+        return (type <= Null || type >= Count) ? 0 : loadValue(m_intPara[type]);
+    }
+
+    /*!
+     * Get current value as bool by Config Type, lock free.
+     */
+    inline bool boolValue(ConfigType type) const
+    {
+        return (type <= Null || type >= Count) ? false : loadValue(m_boolPara[type]) != 0;
     }
 
     /*!
@@ -188,7 +233,8 @@ public:
      */
     inline int count() const
     {
-        return m_para.count();
+        QReadLocker locker(&m_lock);
+        return std::count(m_contains, m_contains + Count, true);
     }
 
     /*!
@@ -196,7 +242,7 @@ public:
      */
     inline bool isEmpty() const
     {
-        return m_para.isEmpty();
+        return count() == 0;
     }
 
     /*!
@@ -204,27 +250,81 @@ public:
      */
     inline bool contains(ConfigType type) const
     {
-        return m_para.contains(type);
+        if(type <= Null || type >= Count)
+        {
+            return false;
+        }
+
+        QReadLocker locker(&m_lock);
+        return m_contains[type];
     }
 
+    /*!
+     * Get and clear the flag of parameter changed since last call.
+     */
+    inline bool takeDirty()
+    {
+        return m_dirty.fetchAndStoreAcquire(0) != 0;
+    }
+
+Q_SIGNALS:
+    /*!
+     * Parameter value changed, emitted from the thread that set it.
+     */
+    void parameterChanged(MusicSettingManager::ConfigType type, const QVariant &value);
+
 protected:
+    /*!
+     * Object contsructor.
+     */
+    MusicSettingManager();
+
     /*!
      * Convert String type to Config Type.
      */
-    ConfigType typeStringToEnum(const QString &stype) const
+    inline ConfigType typeStringToEnum(const QString &stype) const
     {
-        int index = staticMetaObject.indexOfEnumerator("ConfigType");
-        QMetaEnum metaEnum = staticMetaObject.enumerator(index);
-        int key = metaEnum.keyToValue(stype.toStdString().c_str());
-        return TTKStatic_cast(ConfigType, key);
+        return m_types.value(stype, Null);
     }
 
-    QVariant m_variant;
-    QMap<ConfigType, QVariant> m_para;
+    /*!
+     * Read the atomic value with acquire order.
+     */
+    static inline int loadValue(const QAtomicInt &value)
+    {
+#if TTK_QT_VERSION_CHECK(5,0,0)
+        return value.loadAcquire();
+#else
+        return value;
+#endif
+    }
+
+    mutable QReadWriteLock m_lock;
+    QVariant m_para[Count];
+    bool m_contains[Count];
+    QAtomicInt m_intPara[Count];
+    QAtomicInt m_boolPara[Count];
+    QAtomicInt m_dirty;
+    QHash<QString, ConfigType> m_types;
 
     DECLARE_SINGLETON_CLASS(MusicSettingManager)
 };
 
+Q_DECLARE_METATYPE(MusicSettingManager::ConfigType)
+
+inline MusicSettingManager::MusicSettingManager()
+{
+    qRegisterMetaType<MusicSettingManager::ConfigType>("MusicSettingManager::ConfigType");
+
+    ///string keys are resolved once, not by meta enum every call
+    const QMetaEnum &metaEnum = staticMetaObject.enumerator(staticMetaObject.indexOfEnumerator("ConfigType"));
+    for(int i=0; i<metaEnum.keyCount(); ++i)
+    {
+        m_types.insert(metaEnum.key(i), TTKStatic_cast(ConfigType, metaEnum.value(i)));
+    }
+    std::fill(m_contains, m_contains + Count, false);
+}
+
 #define M_SETTING_PTR GetMusicSettingManager()
 MUSIC_CORE_EXPORT MusicSettingManager* GetMusicSettingManager();
 
@@ -4,8 +4,12 @@
 #include "musichotkeymanager.h"
 #include "musicsettingmanager.h"
 #include "musicsinglemanager.h"
+#include "musicsongtagmanager.h"
 #include "musicdownloadmanager.h"
 #include "musicdownloadqueryfactory.h"
+#include "musicnetworksession.h"
+#include "musicdownloadlimiter.h"
+#include "musicplaylistjournal.h"
 
 MusicConnectionPool* GetMusicConnectionPool()
 {
@@ -37,6 +41,11 @@ MusicSingleManager* GetMusicSingleManager()
     return MusicSingleton<MusicSingleManager>::createInstance();
 }
 
+MusicSongTagManager* GetMusicSongTagManager()
+{
+    return MusicSingleton<MusicSongTagManager>::createInstance();
+}
+
 MusicDownLoadManager* GetMusicDownLoadManager()
 {
     return MusicSingleton<MusicDownLoadManager>::createInstance();
@@ -51,3 +60,18 @@ MusicNetworkThread* GetMusicNetworkThread()
 {
     return MusicSingleton<MusicNetworkThread>::createInstance();
 }
+
+MusicNetworkSession* GetMusicNetworkSession()
+{
+    return MusicSingleton<MusicNetworkSession>::createInstance();
+}
+
+MusicDownLoadLimiter* GetMusicDownLoadLimiter()
+{
+    return MusicSingleton<MusicDownLoadLimiter>::createInstance();
+}
+
+MusicPlaylistJournal* GetMusicPlaylistJournal()
+{
+    return MusicSingleton<MusicPlaylistJournal>::createInstance();
+}
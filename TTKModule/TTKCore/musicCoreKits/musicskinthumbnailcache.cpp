@@ -0,0 +1,97 @@
+#include "musicskinthumbnailcache.h"
+#include "musicextractwrap.h"
+#include "musicalgorithmutils.h"
+#include "musicobject.h"
+
+#include <QDir>
+#include <QHash>
+#include <QMutex>
+#include <QBuffer>
+#include <QDateTime>
+#include <QImageReader>
+
+#define THUMBNAIL_NAME      "name"
+#define THUMBNAIL_COUNT     "count"
+
+///one lock for each skin, the same skin loaded twice must not remove the other's new thumbnail
+static QMutex *pathMutex(const QString &path)
+{
+    static QMutex mutex;
+    static QHash<QString, QMutex*> mutexes;
+
+    QMutexLocker locker(&mutex);
+    QMutex *&pathMutex = mutexes[QFileInfo(path).absoluteFilePath()];
+    if(!pathMutex)
+    {
+        pathMutex = new QMutex;
+    }
+    return pathMutex;
+}
+
+MusicSkinThumbnail MusicSkinThumbnailCache::load(const QString &path, const QSize &size)
+{
+    MusicSkinThumbnail thumbnail;
+    const QFileInfo info(path);
+    if(!info.exists())
+    {
+        return thumbnail;
+    }
+
+    QMutexLocker locker(pathMutex(path));
+
+    const QString &cache = QString("%1%2x%3-%4%5").arg(cachePrefix(path)).arg(size.width()).arg(size.height())
+                                                  .arg(info.lastModified().toMSecsSinceEpoch()).arg(PNG_FILE);
+    QImageReader reader(cache);
+    if(reader.read(&thumbnail.m_image))
+    {
+        thumbnail.m_item.m_name = reader.text(THUMBNAIL_NAME);
+        thumbnail.m_item.m_useCount = reader.text(THUMBNAIL_COUNT).toInt();
+        return thumbnail;
+    }
+
+    QByteArray data;
+    if(!MusicExtractWrap::outputSkin(data, &thumbnail.m_item, path))
+    {
+        return thumbnail;
+    }
+
+    ///decode to thumbnail size directly, jpeg skips the full size decode
+    QBuffer buffer(&data);
+    QImageReader decoder(&buffer);
+    decoder.setScaledSize(size);
+    if(!decoder.read(&thumbnail.m_image))
+    {
+        return thumbnail;
+    }
+
+    ///the old thumbnails of the skin are out of date
+    removeCache(path);
+    QDir().mkpath(THUMBNAIL_DIR_FULL);
+
+    QImage image(thumbnail.m_image);
+    image.setText(THUMBNAIL_NAME, thumbnail.m_item.m_name);
+    image.setText(THUMBNAIL_COUNT, QString::number(thumbnail.m_item.m_useCount));
+    image.save(cache, PNG_FILE_PREFIX);
+
+    return thumbnail;
+}
+
+void MusicSkinThumbnailCache::remove(const QString &path)
+{
+    QMutexLocker locker(pathMutex(path));
+    removeCache(path);
+}
+
+void MusicSkinThumbnailCache::removeCache(const QString &path)
+{
+    const QFileInfo info(cachePrefix(path));
+    foreach(const QFileInfo &file, QDir(info.path()).entryInfoList(QStringList() << info.fileName() + "*", QDir::Files))
+    {
+        QFile::remove(file.absoluteFilePath());
+    }
+}
+
+QString MusicSkinThumbnailCache::cachePrefix(const QString &path)
+{
+    return THUMBNAIL_DIR_FULL + MusicUtils::Algorithm::md5(QFileInfo(path).absoluteFilePath().toUtf8()).toHex() + "-";
+}
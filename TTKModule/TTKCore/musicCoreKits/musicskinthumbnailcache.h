@@ -0,0 +1,72 @@
+#ifndef MUSICSKINTHUMBNAILCACHE_H
+#define MUSICSKINTHUMBNAILCACHE_H
+
+/* =================================================
+ * This file is part of the TTK Music Player project
+ * Copyright (C) 2015 - 2020 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ================================================= */
+
+#include <QImage>
+#include "musicbackgroundconfigmanager.h"
+
+/*! @brief The class of the skin thumbnail.
+ * @author Greedysky <greedysky@163.com>
+ */
+typedef struct MUSIC_CORE_EXPORT MusicSkinThumbnail
+{
+    QImage m_image;
+    MusicSkinConfigItem m_item;
+
+    bool isValid() const
+    {
+        return !m_image.isNull();
+    }
+
+}MusicSkinThumbnail;
+
+
+/*! @brief The class of the skin thumbnail cache.
+ * Thumbnails are kept as png files keyed by skin path, size and modify time,
+ * so the full image is only decoded when the skin changed.
+ * @author Greedysky <greedysky@163.com>
+ */
+class MUSIC_CORE_EXPORT MusicSkinThumbnailCache
+{
+    TTK_DECLARE_MODULE(MusicSkinThumbnailCache)
+public:
+    /*!
+     * Load skin thumbnail from cache or decode it by size, thread safe.
+     * Loads of the same skin are serialized.
+     */
+    static MusicSkinThumbnail load(const QString &path, const QSize &size);
+    /*!
+     * Remove all cached thumbnails of skin path, thread safe.
+     */
+    static void remove(const QString &path);
+
+private:
+    /*!
+     * Remove all cached thumbnails of skin path, the skin lock is held.
+     */
+    static void removeCache(const QString &path);
+    /*!
+     * Get cache file prefix of skin path.
+     */
+    static QString cachePrefix(const QString &path);
+
+};
+
+#endif // MUSICSKINTHUMBNAILCACHE_H
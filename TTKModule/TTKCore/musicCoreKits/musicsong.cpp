@@ -2,9 +2,93 @@
 #include "musicstringutils.h"
 #include "musicnumberutils.h"
 
+#include <QThread>
 #include <QFileInfo>
 #include <QDateTime>
 #include <QStringList>
+#if TTK_QT_VERSION_CHECK(5,2,0)
+#  include <QCollator>
+#endif
+#ifdef TTK_GREATER_NEW
+#  include <QtConcurrent/QtConcurrent>
+#else
+#  include <QtConcurrentRun>
+#endif
+#include <vector>
+#include <algorithm>
+
+#define SORT_PARALLEL_THRESHOLD   4096
+
+#if TTK_QT_VERSION_CHECK(5,2,0)
+typedef QCollatorSortKey MusicSongTextKey;
+#else
+typedef QString MusicSongTextKey;
+#endif
+
+///play time label like mm:ss or hh:mm:ss to msec
+static qint64 playTime2Msec(const QString &time)
+{
+    qint64 value = 0;
+    foreach(const QString &part, time.split(":"))
+    {
+        value = value * MT_M2S + part.trimmed().toLongLong();
+    }
+    return value * MT_S2MS;
+}
+
+static inline bool textKeyLess(const MusicSongTextKey &a, const MusicSongTextKey &b)
+{
+#if TTK_QT_VERSION_CHECK(5,2,0)
+    return a.compare(b) < 0;
+#else
+    return a < b;
+#endif
+}
+
+///stable sort by chunks on the thread pool, then merge neighbour runs
+template <typename Compare>
+static void parallelStableSort(QVector<int> &order, const Compare &compare)
+{
+    const int count = order.count();
+    const int threads = (count < SORT_PARALLEL_THRESHOLD) ? 1 : QThread::idealThreadCount();
+    int *data = order.data();
+
+    if(threads <= 1)
+    {
+        std::stable_sort(data, data + count, compare);
+        return;
+    }
+
+    const int step = (count + threads - 1) / threads;
+    QList< QFuture<void> > futures;
+    for(int from = 0; from < count; from += step)
+    {
+        const int to = qMin(from + step, count);
+        futures << QtConcurrent::run([data, &compare, from, to]() { std::stable_sort(data + from, data + to, compare); });
+    }
+
+    for(int width = step; ; width *= 2)
+    {
+        for(int i = 0; i < futures.count(); ++i)
+        {
+            futures[i].waitForFinished();
+        }
+        futures.clear();
+
+        if(width >= count)
+        {
+            break;
+        }
+
+        ///the left run goes first, so equal keys keep their order
+        for(int from = 0; from + width < count; from += 2 * width)
+        {
+            const int middle = from + width;
+            const int to = qMin(from + 2 * width, count);
+            futures << QtConcurrent::run([data, &compare, from, middle, to]() { std::inplace_merge(data + from, data + middle, data + to, compare); });
+        }
+    }
+}
 
 MusicSong::MusicSong()
     : m_musicName(QString()), m_musicPath(QString())
@@ -12,7 +96,9 @@ MusicSong::MusicSong()
     m_sortType = SortByFileName;
     m_musicSize = 0;
     m_musicAddTime = -1;
+    m_musicPlayTimeMsec = 0;
     m_musicPlayCount = 0;
+    m_musicStatDeferred = false;
 }
 
 MusicSong::MusicSong(const QString &musicPath, const QString &musicName)
@@ -50,13 +136,35 @@ MusicSong::MusicSong(const QString &musicPath, const QString &type, int playCoun
 MusicSong::MusicSong(const QString &musicPath, const QString &type, const QString &playTime, int playCount, const QString &musicName)
     : MusicSong(musicPath, type, playCount, musicName)
 {
-    m_musicPlayTime = playTime;
+    setMusicPlayTime(playTime);
 }
 
 MusicSong::MusicSong(const QString &musicPath, int playCount, const QString &time, const QString &musicName)
     : MusicSong(musicPath, playCount, musicName)
 {
-    m_musicPlayTime = time;
+    setMusicPlayTime(time);
+}
+
+void MusicSong::setMusicPlayTime(const QString &t)
+{
+    m_musicPlayTime = t;
+    m_musicPlayTimeMsec = playTime2Msec(t);
+}
+
+void MusicSong::updateMusicStat()
+{
+    if(!m_musicStatDeferred)
+    {
+        return;
+    }
+
+    m_musicStatDeferred = false;
+    const QFileInfo info(m_musicPath);
+    if(info.exists())
+    {
+        m_musicSize = info.size();
+        m_musicSizeStr = MusicUtils::Number::size2Label(m_musicSize);
+    }
 }
 
 QString MusicSong::getMusicArtistFront() const
@@ -82,7 +190,7 @@ bool MusicSong::operator< (const MusicSong &other) const
         case SortBySinger : return getMusicArtistFront() < other.getMusicArtistFront();
         case SortByFileSize : return m_musicSize < other.m_musicSize;
         case SortByAddTime : return m_musicAddTime < other.m_musicAddTime;
-        case SortByPlayTime : return m_musicPlayTime < other.m_musicPlayTime;
+        case SortByPlayTime : return m_musicPlayTimeMsec < other.m_musicPlayTimeMsec;
         case SortByPlayCount : return m_musicPlayCount < other.m_musicPlayCount;
         default: break;
     }
@@ -97,9 +205,76 @@ bool MusicSong::operator> (const MusicSong &other) const
         case SortBySinger : return getMusicArtistFront() > other.getMusicArtistFront();
         case SortByFileSize : return m_musicSize > other.m_musicSize;
         case SortByAddTime : return m_musicAddTime > other.m_musicAddTime;
-        case SortByPlayTime : return m_musicPlayTime > other.m_musicPlayTime;
+        case SortByPlayTime : return m_musicPlayTimeMsec > other.m_musicPlayTimeMsec;
         case SortByPlayCount : return m_musicPlayCount > other.m_musicPlayCount;
         default: break;
     }
     return false;
 }
+
+void MusicSong::sortSongs(QList<MusicSong> *songs, Sort type, Qt::SortOrder order)
+{
+    const int count = songs->count();
+    const bool ascending = (order == Qt::AscendingOrder);
+
+    QVector<int> index(count);
+    for(int i=0; i<count; ++i)
+    {
+        index[i] = i;
+    }
+
+    if(type == SortByFileName || type == SortBySinger)
+    {
+#if TTK_QT_VERSION_CHECK(5,2,0)
+        const QCollator collator;
+#endif
+        std::vector<MusicSongTextKey> keys;
+        keys.reserve(count);
+        for(int i=0; i<count; ++i)
+        {
+            const MusicSong &song = songs->at(i);
+            const QString &text = (type == SortBySinger) ? song.getMusicArtistFront() : song.m_musicName;
+#if TTK_QT_VERSION_CHECK(5,2,0)
+            keys.push_back(collator.sortKey(text));
+#else
+            keys.push_back(text);
+#endif
+        }
+
+        const MusicSongTextKey *key = keys.data();
+        parallelStableSort(index, [key, ascending](int a, int b)
+        {
+            return ascending ? textKeyLess(key[a], key[b]) : textKeyLess(key[b], key[a]);
+        });
+    }
+    else
+    {
+        QVector<qint64> values(count);
+        for(int i=0; i<count; ++i)
+        {
+            const MusicSong &song = songs->at(i);
+            switch(type)
+            {
+                case SortByFileSize : values[i] = song.m_musicSize; break;
+                case SortByAddTime : values[i] = song.m_musicAddTime; break;
+                case SortByPlayTime : values[i] = song.m_musicPlayTimeMsec; break;
+                case SortByPlayCount : values[i] = song.m_musicPlayCount; break;
+                default: values[i] = 0; break;
+            }
+        }
+
+        const qint64 *value = values.constData();
+        parallelStableSort(index, [value, ascending](int a, int b)
+        {
+            return ascending ? value[a] < value[b] : value[b] < value[a];
+        });
+    }
+
+    QList<MusicSong> sorted;
+    sorted.reserve(count);
+    for(int i=0; i<count; ++i)
+    {
+        sorted << songs->at(index[i]);
+    }
+    *songs = sorted;
+}
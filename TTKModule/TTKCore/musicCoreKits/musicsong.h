@@ -117,13 +117,17 @@ public:
      */
     inline QString getMusicType() const { return m_musicType; }
     /*!
-     * Set music time.
+     * Set music time, the numeric duration is updated together.
      */
-    inline void setMusicPlayTime(const QString &t) { m_musicPlayTime = t; }
+    void setMusicPlayTime(const QString &t);
     /*!
      * Get music time.
      */
     inline QString getMusicPlayTime() const { return m_musicPlayTime; }
+    /*!
+     * Get music time in msec.
+     */
+    inline qint64 getMusicPlayTimeMsec() const { return m_musicPlayTimeMsec; }
     /*!
      * Set music add time.
      */
@@ -156,6 +160,14 @@ public:
      * Get music sort type.
      */
     inline Sort getMusicSort() const { return m_sortType; }
+    /*!
+     * Set music file stat deferred, the size is the stored one until updated.
+     */
+    inline void setMusicStatDeferred(bool d) { m_musicStatDeferred = d; }
+    /*!
+     * Stat the music file once if deferred, such as when the song is shown.
+     */
+    void updateMusicStat();
     /*!
      * Operator == function.
      */
@@ -169,11 +181,17 @@ public:
      */
     bool operator> (const MusicSong &other) const;
 
+    /*!
+     * Stable sort songs by sort type, the sort keys are computed once per song.
+     */
+    static void sortSongs(QList<MusicSong> *songs, Sort type, Qt::SortOrder order);
+
 protected:
     Sort m_sortType;
-    qint64 m_musicSize, m_musicAddTime;
+    qint64 m_musicSize, m_musicAddTime, m_musicPlayTimeMsec;
     QString m_musicSizeStr, m_musicAddTimeStr;
     int m_musicPlayCount;
+    bool m_musicStatDeferred;
     QString m_musicName, m_musicPath, m_musicType, m_musicPlayTime;
 
 };
@@ -1,14 +1,13 @@
 #include "musicsongtag.h"
 #include "musictime.h"
-#include "musicformats.h"
 #include "ttkversion.h"
-#include "musicqmmputils.h"
 #include "musicwidgetutils.h"
 #include "musicstringutils.h"
+#include "musicsongtagmanager.h"
 
 #include <QStringList>
-#include <QPluginLoader>
 #include <QFileInfo>
+#include <QCryptographicHash>
 ///qmmp incldue
 #include "tagwrapper.h"
 #include "decoderfactory.h"
@@ -17,7 +16,7 @@
 
 MusicSongTag::MusicSongTag()
 {
-
+    m_coverRead = false;
 }
 
 MusicSongTag::MusicSongTag(const QString &file)
@@ -36,20 +35,50 @@ bool MusicSongTag::read()
     return read(m_filePath);
 }
 
-bool MusicSongTag::read(const QString &file)
+bool MusicSongTag::read(const QString &file, bool cover)
 {
-    const QFile f(file);
-    if(!f.exists() || f.size() <= 0)
+    const QFileInfo fin(file);
+    if(!fin.exists() || fin.size() <= 0)
     {
         return false;
     }
 
     m_filePath = file;
-    return readOtherTaglib();
+
+    MusicSongMeta meta;
+    if(M_SONGTAG_PTR->find(fin, &meta))
+    {
+        m_coverRead = meta.m_coverRead;
+        m_coverHash = meta.m_coverHash;
+        m_parameters.remove(TagWrapper::TAG_COVER);
+        for(QMap<int, QString>::const_iterator it = meta.m_data.constBegin(); it != meta.m_data.constEnd(); ++it)
+        {
+            m_parameters[TTKStatic_cast(TagWrapper::TagType, it.key())] = it.value();
+        }
+        return !m_parameters.isEmpty();
+    }
+
+    if(!readOtherTaglib(cover))
+    {
+        return false;
+    }
+
+    for(QMap<TagWrapper::TagType, QVariant>::const_iterator it = m_parameters.constBegin(); it != m_parameters.constEnd(); ++it)
+    {
+        if(it.key() != TagWrapper::TAG_COVER)
+        {
+            meta.m_data.insert(it.key(), it.value().toString());
+        }
+    }
+    meta.m_coverRead = m_coverRead;
+    meta.m_coverHash = m_coverHash;
+    M_SONGTAG_PTR->insert(fin, meta);
+    return true;
 }
 
 bool MusicSongTag::save()
 {
+    M_SONGTAG_PTR->remove(m_filePath);
     return saveOtherTaglib();
 }
 
@@ -188,6 +217,11 @@ void MusicSongTag::setCover(const QByteArray &data)
 QPixmap MusicSongTag::getCover() const
 {
 #if TTKMUSIC_VERSION >= TTKMUSIC_VERSION_CHECK(2,5,3,0)
+    if(!m_parameters.contains(TagWrapper::TAG_COVER))
+    {
+        ///read from index, cover is loaded only when it is really needed
+        return (m_coverRead && m_coverHash.isEmpty()) ? QPixmap() : readCover();
+    }
     return m_parameters[TagWrapper::TAG_COVER].value<QPixmap>();
 #else
     return QPixmap();
@@ -227,34 +261,53 @@ QString MusicSongTag::findLegalDataString(TagWrapper::TagType type) const
 
 QString MusicSongTag::findPluginPath() const
 {
-    const QString &suffix = QFileInfo(m_filePath).suffix().toLower();
+    return M_SONGTAG_PTR->pluginPath(QFileInfo(m_filePath).suffix());
+}
 
-    const TTKStringListMap formats(MusicFormats::supportFormatsStringMap());
-    foreach(const QString &key, formats.keys())
+QPixmap MusicSongTag::readCover() const
+{
+    QPixmap pix;
+    DecoderFactory *factory = M_SONGTAG_PTR->decoderFactory(QFileInfo(m_filePath).suffix());
+    if(factory)
     {
-        if(formats.value(key).contains(suffix))
+        MetaDataModel *model = factory->createMetaDataModel(m_filePath, true);
+        if(model)
         {
-            return MusicUtils::QMMP::pluginPath("Input", key);
+            pix = model->cover();
+            delete model;
         }
     }
 
-    return QString();
+    m_coverRead = true;
+    m_coverHash = coverHash(pix);
+    ///only an entry of the same file version takes the hash, a changed file is read again anyway
+    const QFileInfo fin(m_filePath);
+    MusicSongMeta meta;
+    if(M_SONGTAG_PTR->find(fin, &meta) && (!meta.m_coverRead || meta.m_coverHash != m_coverHash))
+    {
+        meta.m_coverRead = true;
+        meta.m_coverHash = m_coverHash;
+        M_SONGTAG_PTR->insert(fin, meta);
+    }
+    return pix;
 }
 
-bool MusicSongTag::readOtherTaglib()
+bool MusicSongTag::readOtherTaglib(bool cover)
 {
-    QPluginLoader loader;
-    loader.setFileName(findPluginPath());
+    m_coverRead = cover;
+    m_coverHash.clear();
+    m_parameters.remove(TagWrapper::TAG_COVER);
 
-    const QObject *obj = loader.instance();
-    DecoderFactory *factory = nullptr;
-    if(obj && (factory = TTKObject_cast(DecoderFactory*, obj)))
+    DecoderFactory *factory = M_SONGTAG_PTR->decoderFactory(QFileInfo(m_filePath).suffix());
+    if(factory)
     {
         qint64 length = 0;
-        MetaDataModel *model = factory->createMetaDataModel(m_filePath, true);
+        MetaDataModel *model = cover ? factory->createMetaDataModel(m_filePath, true) : nullptr;
         if(model)
         {
-            m_parameters.insert(TagWrapper::TAG_COVER, model->cover());
+            const QPixmap &pix = model->cover();
+            m_parameters.insert(TagWrapper::TAG_COVER, pix);
+            m_coverHash = coverHash(pix);
             delete model;
         }
 
@@ -291,8 +344,6 @@ bool MusicSongTag::readOtherTaglib()
             }
             m_parameters[TagWrapper::TAG_LENGTH] = QString::number(length);
         }
-
-        loader.unload();
     }
 
     return !m_parameters.isEmpty();
@@ -300,13 +351,9 @@ bool MusicSongTag::readOtherTaglib()
 
 bool MusicSongTag::saveOtherTaglib()
 {
-    QPluginLoader loader;
-    loader.setFileName(findPluginPath());
-
     bool status = false;
-    const QObject *obj = loader.instance();
-    DecoderFactory *factory = nullptr;
-    if(obj && (factory = TTKObject_cast(DecoderFactory*, obj)))
+    DecoderFactory *factory = M_SONGTAG_PTR->decoderFactory(QFileInfo(m_filePath).suffix());
+    if(factory)
     {
         status = true;
         MetaDataModel *model = factory->createMetaDataModel(m_filePath, false);
@@ -342,8 +389,23 @@ bool MusicSongTag::saveOtherTaglib()
             }
         }
         delete model;
-        loader.unload();
     }
 
     return status;
 }
+
+QString MusicSongTag::coverHash(const QPixmap &pix)
+{
+    if(pix.isNull())
+    {
+        return QString();
+    }
+
+    const QImage &image = pix.toImage();
+#if TTK_QT_VERSION_CHECK(5,10,0)
+    const QByteArray data(TTKReinterpret_cast(const char*, image.constBits()), image.sizeInBytes());
+#else
+    const QByteArray data(TTKReinterpret_cast(const char*, image.constBits()), image.byteCount());
+#endif
+    return QCryptographicHash::hash(data, QCryptographicHash::Md5).toHex();
+}
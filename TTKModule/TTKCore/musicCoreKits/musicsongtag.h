@@ -46,8 +46,9 @@ public:
     bool read();
     /*!
      * Read music file to anaylsis.
+     * The cover is a pixmap, so reading out of the gui thread must skip it.
      */
-    bool read(const QString &file);
+    bool read(const QString &file, bool cover = true);
     /*!
      * Save music tags to music file.
      */
@@ -175,15 +176,25 @@ protected:
      * Find current pluin store path.
      */
     QString findPluginPath() const;
+    /*!
+     * Read image cover from music file, its hash is written back to the index.
+     */
+    QPixmap readCover() const;
     /*!
      * Read other taglib not by plugin.
      */
-    bool readOtherTaglib();
+    bool readOtherTaglib(bool cover);
     /*!
      * Save other taglib not by plugin.
      */
     bool saveOtherTaglib();
+    /*!
+     * Get image cover hash.
+     */
+    static QString coverHash(const QPixmap &pix);
 
+    mutable bool m_coverRead;
+    mutable QString m_coverHash;
     QString m_filePath;
     QMap<TagWrapper::TagType, QVariant> m_parameters;
 
@@ -0,0 +1,199 @@
+#include "musicsongtagmanager.h"
+#include "musicformats.h"
+#include "musicqmmputils.h"
+#include "musicfileutils.h"
+
+#include <QDate>
+#include <QDataStream>
+#include <QPluginLoader>
+///qmmp incldue
+#include "decoderfactory.h"
+
+#define META_INDEX_MAGIC    0x54544B4D
+#define META_INDEX_VERSION  3
+#define META_INDEX_EXPIRED  90
+
+MusicSongTagManager::MusicSongTagManager()
+{
+    m_loaded = false;
+    m_changed = false;
+    m_hit = 0;
+    m_miss = 0;
+}
+
+MusicSongTagManager::~MusicSongTagManager()
+{
+    save();
+}
+
+QString MusicSongTagManager::pluginPath(const QString &suffix)
+{
+    QMutexLocker locker(&m_mutex);
+    if(m_plugins.isEmpty())
+    {
+        const TTKStringListMap formats(MusicFormats::supportFormatsStringMap());
+        foreach(const QString &key, formats.keys())
+        {
+            foreach(const QString &format, formats.value(key))
+            {
+                m_plugins.insert(format, MusicUtils::QMMP::pluginPath("Input", key));
+            }
+        }
+    }
+    return m_plugins.value(suffix.toLower());
+}
+
+DecoderFactory *MusicSongTagManager::decoderFactory(const QString &suffix)
+{
+    const QString &path = pluginPath(suffix);
+    if(path.isEmpty())
+    {
+        return nullptr;
+    }
+
+    QMutexLocker locker(&m_mutex);
+    if(m_factorys.contains(path))
+    {
+        return m_factorys.value(path);
+    }
+
+    ///plugin is kept loaded for the whole process, no unload here
+    QPluginLoader loader(path);
+    DecoderFactory *factory = TTKObject_cast(DecoderFactory*, loader.instance());
+    m_factorys.insert(path, factory);
+    return factory;
+}
+
+bool MusicSongTagManager::find(const QFileInfo &info, MusicSongMeta *meta)
+{
+    load();
+
+    QMutexLocker locker(&m_mutex);
+    const QHash<QString, MusicSongMeta>::iterator it = m_metas.find(info.absoluteFilePath());
+    if(it == m_metas.end() || it->m_size != info.size() || it->m_modified != info.lastModified().toMSecsSinceEpoch())
+    {
+        ++m_miss;
+        return false;
+    }
+
+    ++m_hit;
+    ///the access day only changes once a day, so hits rarely dirty the index
+    const qint64 today = QDate::currentDate().toJulianDay();
+    if(it->m_accessed != today)
+    {
+        it->m_accessed = today;
+        m_changed = true;
+    }
+    *meta = it.value();
+    return true;
+}
+
+void MusicSongTagManager::insert(const QFileInfo &info, const MusicSongMeta &meta)
+{
+    load();
+
+    QMutexLocker locker(&m_mutex);
+    MusicSongMeta &item = m_metas[info.absoluteFilePath()];
+    item = meta;
+    item.m_size = info.size();
+    item.m_modified = info.lastModified().toMSecsSinceEpoch();
+    item.m_accessed = QDate::currentDate().toJulianDay();
+    m_changed = true;
+}
+
+void MusicSongTagManager::remove(const QString &path)
+{
+    load();
+
+    QMutexLocker locker(&m_mutex);
+    if(m_metas.remove(QFileInfo(path).absoluteFilePath()) != 0)
+    {
+        m_changed = true;
+    }
+}
+
+int MusicSongTagManager::hitCount() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_hit;
+}
+
+int MusicSongTagManager::missCount() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_miss;
+}
+
+void MusicSongTagManager::save()
+{
+    QMutexLocker locker(&m_mutex);
+    if(!m_changed)
+    {
+        return;
+    }
+
+    ///files removed or moved outside the app are never looked up again, drop them by age
+    const qint64 expired = QDate::currentDate().toJulianDay() - META_INDEX_EXPIRED;
+    for(QHash<QString, MusicSongMeta>::iterator it = m_metas.begin(); it != m_metas.end(); )
+    {
+        if(it->m_accessed < expired)
+        {
+            it = m_metas.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream << quint32(META_INDEX_MAGIC) << quint32(META_INDEX_VERSION) << quint32(m_metas.count());
+    for(QHash<QString, MusicSongMeta>::const_iterator it = m_metas.constBegin(); it != m_metas.constEnd(); ++it)
+    {
+        stream << it.key() << it->m_modified << it->m_size << it->m_accessed << it->m_coverRead << it->m_coverHash << it->m_data;
+    }
+
+    if(MusicUtils::File::writeFileAtomic(METAINDEXPATH_FULL, data))
+    {
+        m_changed = false;
+    }
+}
+
+void MusicSongTagManager::load()
+{
+    QMutexLocker locker(&m_mutex);
+    if(m_loaded)
+    {
+        return;
+    }
+
+    m_loaded = true;
+    QFile file(METAINDEXPATH_FULL);
+    if(!file.open(QFile::ReadOnly))
+    {
+        return;
+    }
+
+    QDataStream stream(&file);
+    quint32 magic = 0, version = 0, count = 0;
+    stream >> magic >> version >> count;
+    if(magic != META_INDEX_MAGIC || version != META_INDEX_VERSION)
+    {
+        return;
+    }
+
+    ///the count comes from disk, the stream status bounds the loop instead of a reserve
+    for(quint32 i=0; i<count && stream.status() == QDataStream::Ok; ++i)
+    {
+        QString path;
+        MusicSongMeta meta;
+        stream >> path >> meta.m_modified >> meta.m_size >> meta.m_accessed >> meta.m_coverRead >> meta.m_coverHash >> meta.m_data;
+        ///a truncated file leaves the last entry half read, drop it
+        if(stream.status() != QDataStream::Ok)
+        {
+            break;
+        }
+        m_metas.insert(path, meta);
+    }
+}
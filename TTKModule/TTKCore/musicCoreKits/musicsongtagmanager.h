@@ -0,0 +1,122 @@
+#ifndef MUSICSONGTAGMANAGER_H
+#define MUSICSONGTAGMANAGER_H
+
+/* =================================================
+ * This file is part of the TTK Music Player project
+ * Copyright (C) 2015 - 2020 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ================================================= */
+
+#include <QMutex>
+#include <QFileInfo>
+#include "musicobject.h"
+#include "musicsingleton.h"
+
+class DecoderFactory;
+
+/*! @brief The class of the music song meta index item.
+ * @author Greedysky <greedysky@163.com>
+ */
+typedef struct MUSIC_CORE_EXPORT MusicSongMeta
+{
+    qint64 m_modified;
+    qint64 m_size;
+    qint64 m_accessed;
+    bool m_coverRead;
+    QString m_coverHash;
+    QMap<int, QString> m_data;
+
+    MusicSongMeta()
+    {
+        m_modified = -1;
+        m_size = -1;
+        m_accessed = -1;
+        m_coverRead = false;
+    }
+}MusicSongMeta;
+
+
+/*! @brief The class of the music song tag manager.
+ * Keeps decoder factories loaded per suffix and an on-disk metadata
+ * index keyed by file path, modified time and size.
+ * @author Greedysky <greedysky@163.com>
+ */
+class MUSIC_CORE_EXPORT MusicSongTagManager
+{
+    TTK_DECLARE_MODULE(MusicSongTagManager)
+public:
+    /*!
+     * Get decoder plugin path by file suffix.
+     */
+    QString pluginPath(const QString &suffix);
+    /*!
+     * Get decoder factory by file suffix, the plugin stays loaded.
+     */
+    DecoderFactory *decoderFactory(const QString &suffix);
+
+    /*!
+     * Find meta data by file info, return false if absent or stale.
+     */
+    bool find(const QFileInfo &info, MusicSongMeta *meta);
+    /*!
+     * Insert or update meta data by file info.
+     */
+    void insert(const QFileInfo &info, const MusicSongMeta &meta);
+    /*!
+     * Remove meta data by file path.
+     */
+    void remove(const QString &path);
+
+    /*!
+     * Get meta index hit count.
+     */
+    int hitCount() const;
+    /*!
+     * Get meta index miss count.
+     */
+    int missCount() const;
+
+    /*!
+     * Save meta index to disk if changed, entries not accessed for a long time are dropped.
+     */
+    void save();
+
+protected:
+    /*!
+     * Object contsructor.
+     */
+    MusicSongTagManager();
+
+    ~MusicSongTagManager();
+
+    /*!
+     * Load meta index from disk once.
+     */
+    void load();
+
+    bool m_loaded, m_changed;
+    int m_hit, m_miss;
+    mutable QMutex m_mutex;
+    QHash<QString, QString> m_plugins;
+    QHash<QString, DecoderFactory*> m_factorys;
+    QHash<QString, MusicSongMeta> m_metas;
+
+    DECLARE_SINGLETON_CLASS(MusicSongTagManager)
+};
+
+#define M_SONGTAG_PTR GetMusicSongTagManager()
+MUSIC_CORE_EXPORT MusicSongTagManager* GetMusicSongTagManager();
+
+#endif // MUSICSONGTAGMANAGER_H
@@ -21,10 +21,14 @@ INCLUDEPATH += $$PWD
 HEADERS  += \
     $$PWD/musiclrcdefines.h \
     $$PWD/musiclrcanalysis.h \
+    $$PWD/musiclrctimeline.h \
+    $$PWD/musiclrcboundarytimer.h \
     $$PWD/musiclrcfromkrc.h
 
 
 SOURCES += \
     $$PWD/musiclrcdefines.cpp \
     $$PWD/musiclrcanalysis.cpp \
+    $$PWD/musiclrctimeline.cpp \
+    $$PWD/musiclrcboundarytimer.cpp \
     $$PWD/musiclrcfromkrc.cpp
@@ -2,109 +2,173 @@
 #ifndef MUSIC_MOBILE
 #include "musiclrcfromkrc.h"
 #endif
-#include <qmath.h>
-#include "musicstringutils.h"
 #include "musicapplication.h"
 #include "musicdownloadqueryfactory.h"
 #include "musictranslationrequest.h"
 
-MusicLrcAnalysis::MusicLrcAnalysis(QObject *parent)
-    : QObject(parent)
+///read at most max ascii digits, return the digit count
+static int readLrcDigits(const QString &data, int &pos, int max, qint64 *value)
 {
-    m_lineMax = 0;
-    m_currentLrcIndex = 0;
-    m_translationThread = nullptr;
+    int count = 0;
+    *value = 0;
+    while(pos < data.size() && count < max)
+    {
+        const ushort c = data[pos].unicode();
+        if(c < '0' || c > '9')
+        {
+            break;
+        }
+        *value = *value * 10 + (c - '0');
+        ++pos;
+        ++count;
+    }
+    return count;
 }
 
-MusicLrcAnalysis::~MusicLrcAnalysis()
+static bool isLrcTimeSeparator(const QString &data, int pos)
 {
-    delete m_translationThread;
+    return pos < data.size() && (data[pos] == ':' || data[pos] == '.');
 }
 
-MusicLrcAnalysis::State MusicLrcAnalysis::setLrcData(const QByteArray &data)
+///match [mm:ss] and [mm:ss.x(xx)] tags, ':' and '.' are both allowed as separator
+static int matchLrcTimeTag(const QString &data, int pos, qint64 *time)
 {
-    m_currentLrcIndex = 0;
-    m_lrcContainer.clear();
-    m_currentShowLrcContainer.clear();
+    qint64 minutes = 0, seconds = 0, milliseconds = 0;
+    ++pos;
+    if(readLrcDigits(data, pos, 3, &minutes) == 0 || !isLrcTimeSeparator(data, pos++))
+    {
+        return -1;
+    }
 
-    QStringList getAllText = QString(data).split("\n");
-    if(data.left(9) == MUSIC_TTKLRCF) //plain txt check
+    if(readLrcDigits(data, pos, 2, &seconds) != 2)
     {
-        getAllText[0].clear();
-        const int perTime = MusicApplication::instance()->duration() / getAllText.count();
-        foreach(const QString &oneLine, getAllText)
-        {
-            m_lrcContainer.insert(perTime*m_lrcContainer.count(), oneLine);
-        }
+        return -1;
     }
-    else
+
+    if(isLrcTimeSeparator(data, pos))
     {
-        foreach(const QString &oneLine, getAllText)
+        ++pos;
+        const int count = readLrcDigits(data, pos, 3, &milliseconds);
+        if(count == 0)
         {
-            matchLrcLine(oneLine);
+            return -1;
         }
-    }
 
-    if(m_lrcContainer.isEmpty())
-    {
-        return LrcEmpty;
+        for(int i=count; i<3; ++i)
+        {
+            milliseconds *= 10;
+        }
     }
 
-    for(int i=0; i<getMiddle(); ++i)
+    if(pos >= data.size() || data[pos] != ']')
     {
-        m_currentShowLrcContainer << QString();
+        return -1;
     }
-    if(m_lrcContainer.find(0) == m_lrcContainer.end())
+
+    *time = minutes * MT_M2MS + seconds * MT_S2MS + milliseconds;
+    return pos + 1;
+}
+
+///match [offset:+/-xxx] tag
+static int matchLrcOffsetTag(const QString &data, int pos, qint64 *offset)
+{
+    if(data.mid(pos, 8).compare("[offset:", Qt::CaseInsensitive) != 0)
     {
-        m_lrcContainer.insert(0, QString());
+        return -1;
     }
 
-    TTKIntStringMapIterator it(m_lrcContainer);
-    while(it.hasNext())
+    pos += 8;
+    const bool negative = pos < data.size() && data[pos] == '-';
+    if(pos < data.size() && (data[pos] == '-' || data[pos] == '+'))
     {
-        it.next();
-        m_currentShowLrcContainer << it.value();
+        ++pos;
     }
-    for(int i=0; i<getMiddle(); ++i)
+
+    qint64 value = 0;
+    if(readLrcDigits(data, pos, 9, &value) == 0 || pos >= data.size() || data[pos] != ']')
     {
-        m_currentShowLrcContainer << QString();
+        return -1;
     }
 
-    return OpenFileSuccess;
+    *offset = negative ? -value : value;
+    return pos + 1;
 }
 
-MusicLrcAnalysis::State MusicLrcAnalysis::setLrcData(const TTKIntStringMap &data)
+///match [start,duration] line tag or <offset,duration,0> word tag
+static int matchKrcTimeTag(const QString &data, int pos, QChar close, qint64 *time, qint64 *duration)
 {
-    if(data.isEmpty())
+    ++pos;
+    if(readLrcDigits(data, pos, 9, time) == 0 || pos >= data.size() || data[pos++] != ',')
     {
-        return LrcEmpty;
+        return -1;
     }
 
-    m_lrcContainer = data;
+    if(readLrcDigits(data, pos, 9, duration) == 0)
+    {
+        return -1;
+    }
+
+    ///skip the rest fields of the tag
+    while(pos < data.size() && data[pos] != close)
+    {
+        if(data[pos] != ',' && !data[pos].isDigit())
+        {
+            return -1;
+        }
+        ++pos;
+    }
+    return pos < data.size() ? pos + 1 : -1;
+}
+
+MusicLrcAnalysis::MusicLrcAnalysis(QObject *parent)
+    : QObject(parent)
+{
+    m_lineMax = 0;
     m_currentLrcIndex = 0;
+    m_translationThread = nullptr;
+}
+
+MusicLrcAnalysis::~MusicLrcAnalysis()
+{
+    delete m_translationThread;
+}
+
+MusicLrcAnalysis::State MusicLrcAnalysis::setLrcData(const QByteArray &data)
+{
+    m_currentLrcIndex = 0;
+    m_lrcContainer.clear();
     m_currentShowLrcContainer.clear();
 
-    for(int i=0; i<getMiddle(); ++i)
+    if(data.left(9) == MUSIC_TTKLRCF) //plain txt check
     {
-        m_currentShowLrcContainer << QString();
+        QStringList getAllText = QString(data).split("\n");
+        getAllText[0].clear();
+        const int perTime = MusicApplication::instance()->duration() / getAllText.count();
+        foreach(const QString &oneLine, getAllText)
+        {
+            m_lrcContainer.insert(perTime * m_lrcContainer.count(), oneLine);
+        }
     }
-    if(m_lrcContainer.find(0) == m_lrcContainer.end())
+    else
     {
-        m_lrcContainer.insert(0, QString());
+        matchLrcData(QString(data));
     }
 
-    TTKIntStringMapIterator it(m_lrcContainer);
-    while(it.hasNext())
-    {
-        it.next();
-        m_currentShowLrcContainer << it.value();
-    }
-    for(int i=0; i<getMiddle(); ++i)
+    return setLrcTimeline();
+}
+
+MusicLrcAnalysis::State MusicLrcAnalysis::setLrcData(const TTKIntStringMap &data)
+{
+    if(data.isEmpty())
     {
-        m_currentShowLrcContainer << QString();
+        return LrcEmpty;
     }
 
-    return OpenFileSuccess;
+    m_lrcContainer.setData(data);
+    m_currentLrcIndex = 0;
+    m_currentShowLrcContainer.clear();
+
+    return setLrcTimeline();
 }
 
 MusicLrcAnalysis::State MusicLrcAnalysis::transLrcFileToTime(const QString &lrcFileName)
@@ -136,311 +200,184 @@ MusicLrcAnalysis::State MusicLrcAnalysis::transKrcFileToTime(const QString &krcF
         return OpenFileFail;
     }
 
-    const QString &getAllText = QString(krc.getDecodeString());
-    //The lyrics by line into the lyrics list
-    foreach(const QString &oneLine, getAllText.split(MusicUtils::String::newlines()))
+    //The lyrics by line into the lyrics list, keep the word timings
+    matchKrcData(QString(krc.getRawString()));
+    if(m_lrcContainer.isEmpty())
     {
-        matchLrcLine(oneLine);
+        matchLrcData(QString(krc.getDecodeString()));
     }
 
-    //If the lrcContainer is empty
+    return setLrcTimeline();
+#else
+    Q_UNUSED(krcFileName);
+    return OpenFileFail;
+#endif
+}
+
+MusicLrcAnalysis::State MusicLrcAnalysis::setLrcTimeline()
+{
+    m_lrcContainer.finish();
     if(m_lrcContainer.isEmpty())
     {
         return LrcEmpty;
     }
 
-    for(int i=0; i<getMiddle(); ++i)
+    if(!m_lrcContainer.contains(0))
     {
-        m_currentShowLrcContainer << QString();
-    }
-    if(m_lrcContainer.find(0) == m_lrcContainer.end())
-    {
-       m_lrcContainer.insert(0, QString());
+        m_lrcContainer.insert(0, QString());
+        m_lrcContainer.finish();
     }
 
-    TTKIntStringMapIterator it(m_lrcContainer);
-    while(it.hasNext())
+    for(int i=0; i<getMiddle(); ++i)
     {
-        it.next();
-        m_currentShowLrcContainer << it.value();
+        m_currentShowLrcContainer << QString();
     }
+    m_currentShowLrcContainer << m_lrcContainer.texts();
     for(int i=0; i<getMiddle(); ++i)
     {
         m_currentShowLrcContainer << QString();
     }
 
     return OpenFileSuccess;
-#else
-    Q_UNUSED(krcFileName);
-    return OpenFileFail;
-#endif
 }
 
-void MusicLrcAnalysis::matchLrcLine(const QString &oneLine)
+void MusicLrcAnalysis::matchLrcData(const QString &data)
 {
-    const QRegExp regx01("\\[\\d{2}:\\d{2}\\.\\d{3}\\]");
-    const QRegExp regx02("\\[\\d{2}:\\d{2}\\.\\d{2}\\]");
-    const QRegExp regx03("\\[\\d{2}:\\d{2}\\.\\d{1}\\]");
-    const QRegExp regx04("\\[\\d{2}:\\d{2}:\\d{3}\\]");
-    const QRegExp regx05("\\[\\d{2}:\\d{2}:\\d{2}\\]");
-    const QRegExp regx06("\\[\\d{2}:\\d{2}:\\d{1}\\]");
-    const QRegExp regx07("\\[\\d{2}:\\d{2}\\]");
-    const QRegExp regx08("\\[\\d{2}\\.\\d{2}\\.\\d{3}\\]");
-    const QRegExp regx09("\\[\\d{2}\\.\\d{2}\\.\\d{2}\\]");
-    const QRegExp regx10("\\[\\d{2}\\.\\d{2}\\.\\d{1}\\]");
-    const QRegExp regx11("\\[\\d{2}\\.\\d{2}:\\d{3}\\]");
-    const QRegExp regx12("\\[\\d{2}\\.\\d{2}:\\d{2}\\]");
-    const QRegExp regx13("\\[\\d{2}\\.\\d{2}:\\d{1}\\]");
-    const QRegExp regx14("\\[\\d{2}\\.\\d{2}\\]");
+    ///one pass over all lines, the time tags of a line share its text
+    QList<qint64> times;
+    QString text;
+    qint64 offset = 0;
+    int pos = 0, from = 0;
 
-    LrcFormat type = Type02;
-    QRegExp regx;
-    if(oneLine.contains(regx01))
-    {
-        type = Type01;
-        regx = regx01;
-    }
-    else if(oneLine.contains(regx02))
-    {
-        type = Type02;
-        regx = regx02;
-    }
-    else if(oneLine.contains(regx03))
-    {
-        type = Type03;
-        regx = regx03;
-    }
-    else if(oneLine.contains(regx04))
-    {
-        type = Type04;
-        regx = regx04;
-    }
-    else if(oneLine.contains(regx05))
-    {
-        type = Type05;
-        regx = regx05;
-    }
-    else if(oneLine.contains(regx06))
+    while(pos <= data.size())
     {
-        type = Type06;
-        regx = regx06;
-    }
-    else if(oneLine.contains(regx07))
-    {
-        type = Type07;
-        regx = regx07;
-    }
-    else if(oneLine.contains(regx08))
-    {
-        type = Type08;
-        regx = regx08;
-    }
-    else if(oneLine.contains(regx09))
-    {
-        type = Type09;
-        regx = regx09;
-    }
-    else if(oneLine.contains(regx10))
-    {
-        type = Type10;
-        regx = regx10;
-    }
-    else if(oneLine.contains(regx11))
-    {
-        type = Type11;
-        regx = regx11;
-    }
-    else if(oneLine.contains(regx12))
-    {
-        type = Type12;
-        regx = regx12;
-    }
-    else if(oneLine.contains(regx13))
-    {
-        type = Type13;
-        regx = regx13;
-    }
-    else
-    {
-        type = Type14;
-        regx = regx14;
-    }
+        if(pos == data.size() || data[pos] == '\n' || data[pos] == '\r')
+        {
+            if(!times.isEmpty())
+            {
+                text.append(data.mid(from, pos - from));
+                foreach(const qint64 time, times)
+                {
+                    m_lrcContainer.insert(time, text);
+                }
+                times.clear();
+            }
+
+            text.clear();
+            from = ++pos;
+            continue;
+        }
 
-    QString temp = oneLine;
-    temp.replace(regx, QString());
-    int pos = regx.indexIn(oneLine, 0);
-    while(pos != -1)
-    {   //That match
-        const QString &cap = regx.cap(0);
-        //Return zeroth expression matching the content
-        //The time tag into the time value, in milliseconds
-        switch(type)
+        if(data[pos] == '[')
         {
-            case Type01:
-                    matchLrcLine(temp, cap, "\\d{2}(?=:)", "\\d{2}(?=\\.)", "\\d{3}(?=\\])");
-                    break;
-            case Type02:
-                    matchLrcLine(temp, cap, "\\d{2}(?=:)", "\\d{2}(?=\\.)", "\\d{2}(?=\\])");
-                    break;
-            case Type03:
-                    matchLrcLine(temp, cap, "\\d{2}(?=:)", "\\d{2}(?=\\.)", "\\d{1}(?=\\])");
-                    break;
-            case Type04:
-                    matchLrcLine(temp, cap, ":");
-                    break;
-            case Type05:
-                    matchLrcLine(temp, cap, ":");
-                    break;
-            case Type06:
-                    matchLrcLine(temp, cap, ":");
-                    break;
-            case Type07:
-                    matchLrcLine(temp, cap, "\\d{2}(?=:)", "\\d{2}(?=\\])");
-                    break;
-            case Type08:
-                    matchLrcLine(temp, cap, ".");
-                    break;
-            case Type09:
-                    matchLrcLine(temp, cap, ".");
-                    break;
-            case Type10:
-                    matchLrcLine(temp, cap, ".");
-                    break;
-            case Type11:
-                    matchLrcLine(temp, cap, "\\d{2}(?=\\.)", "\\d{2}(?=:)", "\\d{3}(?=\\])");
-                    break;
-            case Type12:
-                    matchLrcLine(temp, cap, "\\d{2}(?=\\.)", "\\d{2}(?=:)", "\\d{2}(?=\\])");
-                    break;
-            case Type13:
-                    matchLrcLine(temp, cap, "\\d{2}(?=\\.)", "\\d{2}(?=:)", "\\d{1}(?=\\])");
-                    break;
-            case Type14:
-                    matchLrcLine(temp, cap, "\\d{2}(?=\\.)", "\\d{2}(?=\\])");
-                    break;
-            default: break;
+            qint64 time = 0;
+            int end = matchLrcTimeTag(data, pos, &time);
+            if(end != -1)
+            {
+                ///positive offset shows the lyrics earlier
+                times << qMax(time - offset, qint64(0));
+            }
+            else
+            {
+                end = matchLrcOffsetTag(data, pos, &offset);
+            }
+
+            if(end != -1)
+            {
+                text.append(data.mid(from, pos - from));
+                from = pos = end;
+                continue;
+            }
         }
-        pos += regx.matchedLength();
-        pos = regx.indexIn(oneLine, pos); //Matching all
+        ++pos;
     }
 }
 
-void MusicLrcAnalysis::matchLrcLine(const QString &oneLine, const QString &cap, const QString &first, const QString &second, const QString &third)
+void MusicLrcAnalysis::matchKrcData(const QString &data)
 {
-    QRegExp regx;
-    regx.setPattern(first);
-    regx.indexIn(cap);
-
-    const int minutes = regx.cap(0).toInt();
-    regx.setPattern(second);
-    regx.indexIn(cap);
-
-    const int seconds = regx.cap(0).toInt();
-    regx.setPattern(third);
-    regx.indexIn(cap);
-
-    const int milliseconds = regx.cap(0).toInt();
-    const int length = QString::number(milliseconds).length();
-    const qint64 totalTime = minutes * MT_M2MS + seconds * MT_S2MS + milliseconds * pow(10, 3 - length);
-    m_lrcContainer.insert(totalTime, oneLine);
-}
+    qint64 offset = 0;
+    int from = 0;
 
-void MusicLrcAnalysis::matchLrcLine(const QString &oneLine, const QString &cap, const QString &first, const QString &second)
-{
-    QRegExp regx;
-    regx.setPattern(first);
-    regx.indexIn(cap);
+    while(from < data.size())
+    {
+        int end = from;
+        while(end < data.size() && data[end] != '\n' && data[end] != '\r')
+        {
+            ++end;
+        }
 
-    const int minutes = regx.cap(0).toInt();
-    regx.setPattern(second);
-    regx.indexIn(cap);
+        qint64 time = 0, duration = 0;
+        int pos = (data[from] == '[') ? matchKrcTimeTag(data, from, ']', &time, &duration) : -1;
+        if(pos != -1 && pos <= end)
+        {
+            QString text;
+            MusicLrcWords words;
+            while(pos < end)
+            {
+                MusicLrcWord word;
+                if(data[pos] == '<')
+                {
+                    const int next = matchKrcTimeTag(data, pos, '>', &word.m_offset, &word.m_duration);
+                    if(next != -1 && next <= end)
+                    {
+                        words << word;
+                        pos = next;
+                        continue;
+                    }
+                }
+
+                ///the text before the first word tag is shown at the line time
+                if(words.isEmpty())
+                {
+                    words << word;
+                }
+                text.append(data[pos++]);
+                ++words.last().m_length;
+            }
 
-    const int seconds = regx.cap(0).toInt();
-    const qint64 totalTime = minutes * MT_M2MS + seconds * MT_S2MS;
-    m_lrcContainer.insert(totalTime, oneLine);
-}
+            ///positive offset shows the lyrics earlier
+            m_lrcContainer.insert(qMax(time - offset, qint64(0)), text, words);
+        }
+        else if(data[from] == '[')
+        {
+            matchLrcOffsetTag(data, from, &offset);
+        }
 
-void MusicLrcAnalysis::matchLrcLine(const QString &oneLine, QString cap, const QString &splite)
-{
-    cap.chop(1);
-    cap.remove(0, 1);
-    const QStringList lists(cap.split(splite));
-    if(lists.count() != 3)
-    {
-        return;
+        from = end + 1;
     }
-
-    const int minutes = lists[0].toInt();
-    const int seconds = lists[1].toInt();
-    const int milliseconds = lists[2].toInt();
-    const int length = QString::number(milliseconds).length();
-    const qint64 totalTime = minutes * MT_M2MS + seconds * MT_S2MS + milliseconds * pow(10, 3 - length);
-    m_lrcContainer.insert(totalTime, oneLine);
 }
 
 qint64 MusicLrcAnalysis::setSongSpeedChanged(qint64 time)
 {
-    const QList<qint64> keys(m_lrcContainer.keys());
-    qint64 beforeTime = 0;
-    int index = -1;
-
-    if(!keys.isEmpty())
-    {
-        index = 0;
-        beforeTime = keys[0];
-    }
-    for(int i=1; i<keys.count(); ++i)
+    int index = m_lrcContainer.count() - 1;
+    ///the first line after time, the first line is always before it
+    const int later = m_lrcContainer.findLowerIndex(time, 1);
+    if(later < m_lrcContainer.count())
     {
-        index = i;
-        const qint64 afterTime = keys[i];
-        if(beforeTime <= time && time <= afterTime)
-        {
-            time = afterTime;
-            break;
-        }
-        beforeTime = afterTime;
+        index = later;
+        time = m_lrcContainer.time(later);
     }
 
     if((m_currentLrcIndex = index - 1) < 0)
     {
         m_currentLrcIndex = 0;
     }
-//    for(int i=0; i<m_currentShowLrcContainer.count(); ++i)
-//    {
-//        if(m_currentShowLrcContainer[i] == m_lrcContainer.value(time))
-//        {
-//            if((m_currentLrcIndex = i - getMiddle() - 1) < 0)
-//            {
-//                m_currentLrcIndex = 0;
-//            }
-//            break;
-//        }
-//    }
     return time;
 }
 
 void MusicLrcAnalysis::revertLrcTime(qint64 pos)
 {
-    TTKIntStringMapIterator it(m_lrcContainer);
-    TTKIntStringMap copy;
-    while(it.hasNext())
-    {
-        it.next();
-        copy.insert(it.key() + pos, it.value());
-    }
-    m_lrcContainer = copy;
+    m_lrcContainer.shift(pos);
 }
 
 void MusicLrcAnalysis::saveLrcTimeChanged()
 {
-    TTKIntStringMapIterator it(m_lrcContainer);
     QString data;
     data.append(QString("[by: %1]\n[offset:0]\n").arg(APP_NAME));
-    while(it.hasNext())
+    for(int i=0; i<m_lrcContainer.count(); ++i)
     {
-        it.next();
-        data.append(MusicTime::toString(it.key(), MusicTime::All_Msec, "[mm:ss.zzz]"));
-        data.append(it.value() + "\n");
+        data.append(MusicTime::toString(m_lrcContainer.time(i), MusicTime::All_Msec, "[mm:ss.zzz]"));
+        data.append(m_lrcContainer.text(i) + "\n");
     }
 
     QFile file(m_currentLrcFileName);
@@ -501,29 +438,14 @@ bool MusicLrcAnalysis::findText(qint64 current, qint64 total, QString &pre, QStr
     }
 
     //After get the current time in the lyrics of the two time points
-    qint64 previous = 0;
-    qint64 later = 0;
-    //Keys () method returns a list of lrcContainer
-    foreach(const qint64 value, m_lrcContainer.keys())
-    {
-        if(current >= value)
-        {
-            previous = value;
-        }
-        else
-        {
-            later = value;
-            break;
-        }
-    }
+    const int index = m_lrcContainer.findIndex(current);
+    const qint64 previous = index < 0 ? 0 : m_lrcContainer.time(index);
     //To the last line, set the later to song total time value
-    if(later == 0)
-    {
-        later = total;
-    }
+    const bool end = index + 1 >= m_lrcContainer.count();
+    const qint64 later = end ? total : m_lrcContainer.time(index + 1);
     //The lyrics content corresponds to obtain the current time
-    pre = m_lrcContainer.value(previous);
-    last = m_lrcContainer.value(later);
+    pre = index < 0 ? QString() : m_lrcContainer.text(index);
+    last = end ? QString() : m_lrcContainer.text(index + 1);
     interval = later - previous;
 
     return true;
@@ -531,17 +453,9 @@ bool MusicLrcAnalysis::findText(qint64 current, qint64 total, QString &pre, QStr
 
 qint64 MusicLrcAnalysis::findTime(int index) const
 {
-    if(index + m_lineMax < m_currentShowLrcContainer.count())
+    if(index >= 0 && index + m_lineMax < m_currentShowLrcContainer.count() && index < m_lrcContainer.count())
     {
-        TTKIntStringMapIterator it(m_lrcContainer);
-        for(int i=0; i<index + 1; ++i)
-        {
-            if(it.hasNext())
-            {
-                it.next();
-            }
-        }
-        return it.key();
+        return m_lrcContainer.time(index);
     }
     else
     {
@@ -567,15 +481,34 @@ qint64 MusicLrcAnalysis::findTime(const QStringList &ts) const
     return -1;
 }
 
+qint64 MusicLrcAnalysis::findNextTime(qint64 current) const
+{
+    const int index = m_lrcContainer.findIndex(current) + 1;
+    return index < m_lrcContainer.count() ? m_lrcContainer.time(index) : -1;
+}
+
+bool MusicLrcAnalysis::findWords(qint64 current, qint64 &start, MusicLrcWords &words) const
+{
+    const int index = m_lrcContainer.findIndex(current);
+    if(index < 0)
+    {
+        return false;
+    }
+
+    start = m_lrcContainer.time(index);
+    words = m_lrcContainer.words(index);
+    return true;
+}
+
 QStringList MusicLrcAnalysis::getAllLrcList() const
 {
-    return m_lrcContainer.values();
+    return m_lrcContainer.texts();
 }
 
 QString MusicLrcAnalysis::getAllLrcString() const
 {
     QString clipString;
-    foreach(const QString &s, m_lrcContainer.values())
+    foreach(const QString &s, m_lrcContainer.texts())
     {
         clipString.append(s + "\n");
     }
@@ -592,9 +525,9 @@ void MusicLrcAnalysis::getTranslatedLrc()
     }
 
     QString data;
-    foreach(const qint64 &key, m_lrcContainer.keys())
+    for(int i=0; i<m_lrcContainer.count(); ++i)
     {
-        data.append(QString("[%1.000]").arg(MusicTime::msecTime2LabelJustified(key)) + m_lrcContainer.value(key));
+        data.append(QString("[%1.000]").arg(MusicTime::msecTime2LabelJustified(m_lrcContainer.time(i))) + m_lrcContainer.text(i));
 #ifdef Q_OS_UNIX
         data.append("\r");
 #endif
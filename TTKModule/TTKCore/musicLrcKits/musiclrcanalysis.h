@@ -20,6 +20,7 @@
  ================================================= */
 
 #include "musicobject.h"
+#include "musiclrctimeline.h"
 #include "musicglobaldefine.h"
 
 #define MUSIC_TTKLRCF               "[TTKLRCF]"
@@ -156,6 +157,14 @@ public:
      * Get current time by texts.
      */
     qint64 findTime(const QStringList &ts) const;
+    /*!
+     * Get next line time after current time, return -1 if no more line.
+     */
+    qint64 findNextTime(qint64 current) const;
+    /*!
+     * Get current line time and its word timings by current time.
+     */
+    bool findWords(qint64 current, qint64 &start, MusicLrcWords &words) const;
 
     /*!
      * Get all lrcs from container.
@@ -174,25 +183,21 @@ public Q_SLOTS:
 
 protected:
     /*!
-     * Lrc analysis by match lrc line base.
-     */
-    void matchLrcLine(const QString &oneLine);
-    /*!
-     * Lrc analysis by match lrc line two[xx.(:)xx].
+     * Finish the lrc timeline and init show container.
      */
-    void matchLrcLine(const QString &oneLine, const QString &cap, const QString &first, const QString &second);
+    State setLrcTimeline();
     /*!
-     * Lrc analysis by match lrc line three[xx.xx.x(xx)]\[xx:xx:x(xx)].
+     * Lrc analysis by match all lrc lines in one pass.
      */
-    void matchLrcLine(const QString &oneLine, QString cap, const QString &splite);
+    void matchLrcData(const QString &data);
     /*!
-     * Lrc analysis by match lrc line three[xx.(:)xx.(:)x(xx)].
+     * Krc analysis by match all lines with their word timings.
      */
-    void matchLrcLine(const QString &oneLine, const QString &cap, const QString &first, const QString &second, const QString &third);
+    void matchKrcData(const QString &data);
 
     int m_lineMax, m_currentLrcIndex;
     QString m_currentLrcFileName;
-    TTKIntStringMap m_lrcContainer;
+    MusicLrcTimeline m_lrcContainer;
     QStringList m_currentShowLrcContainer;
     MusicTranslationRequest *m_translationThread;
 
@@ -0,0 +1,36 @@
+#include "musiclrcboundarytimer.h"
+#include "musiclrcanalysis.h"
+
+MusicLrcBoundaryTimer::MusicLrcBoundaryTimer(MusicLrcAnalysis *analysis, QObject *parent)
+    : QObject(parent)
+    , m_analysis(analysis)
+{
+    m_timer.setSingleShot(true);
+#if TTK_QT_VERSION_CHECK(5,0,0)
+    m_timer.setTimerType(Qt::PreciseTimer);
+#endif
+    connect(&m_timer, SIGNAL(timeout()), SIGNAL(timeout()));
+}
+
+void MusicLrcBoundaryTimer::schedule(qint64 current, bool pause)
+{
+    const qint64 next = m_analysis->findNextTime(current);
+    if(pause || next < 0)
+    {
+        m_timer.stop();
+    }
+    else
+    {
+        m_timer.start(TTKStatic_cast(int, qMax(next - current, qint64(0))));
+    }
+}
+
+void MusicLrcBoundaryTimer::stop()
+{
+    m_timer.stop();
+}
+
+bool MusicLrcBoundaryTimer::isActive() const
+{
+    return m_timer.isActive();
+}
@@ -0,0 +1,68 @@
+#ifndef MUSICLRCBOUNDARYTIMER_H
+#define MUSICLRCBOUNDARYTIMER_H
+
+/* =================================================
+ * This file is part of the TTK Music Player project
+ * Copyright (C) 2015 - 2020 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ================================================= */
+
+#include <QTimer>
+#include "musicglobaldefine.h"
+
+class MusicLrcAnalysis;
+
+/*! @brief The class of the lrc line boundary timer.
+ * Line switches are scheduled at the lrc time of the next line
+ * instead of waiting for the next player position tick.
+ * @author Greedysky <greedysky@163.com>
+ */
+class MUSIC_LRC_EXPORT MusicLrcBoundaryTimer : public QObject
+{
+    Q_OBJECT
+    TTK_DECLARE_MODULE(MusicLrcBoundaryTimer)
+public:
+    /*!
+     * Object contsructor.
+     */
+    explicit MusicLrcBoundaryTimer(MusicLrcAnalysis *analysis, QObject *parent = nullptr);
+
+    /*!
+     * Schedule the timeout at the next line time after current.
+     * The timer is stopped when paused or no line is left.
+     */
+    void schedule(qint64 current, bool pause);
+    /*!
+     * Stop the scheduled timeout.
+     */
+    void stop();
+    /*!
+     * Check the timeout is scheduled.
+     */
+    bool isActive() const;
+
+Q_SIGNALS:
+    /*!
+     * The next line time is reached, read the play position again.
+     */
+    void timeout();
+
+private:
+    QTimer m_timer;
+    MusicLrcAnalysis *m_analysis;
+
+};
+
+#endif // MUSICLRCBOUNDARYTIMER_H
@@ -69,7 +69,16 @@ bool MusicLrcFromKrc::decode(const QString &input, const QString &output)
         src[i] = (uchar)(src[i] ^ key[i % 16]);
     }
 
-    decompression(src, st.st_size, &dstsize);
+    if(decompression(src, st.st_size, &dstsize) != 0)
+    {
+        TTK_LOGGER_ERROR("decompression file error");
+        delete[] src;
+        fclose(fp);
+        return false;
+    }
+
+    ///create lrc modifies the buffer, keep the word timings first
+    m_rawData = QByteArray((char*)m_resultBytes, TTKStatic_cast(int, dstsize));
     createLrc(m_resultBytes, TTKStatic_cast(int, dstsize));
 
     delete[] src;
@@ -99,6 +108,11 @@ QByteArray MusicLrcFromKrc::getDecodeString() const
     return m_data;
 }
 
+QByteArray MusicLrcFromKrc::getRawString() const
+{
+    return m_rawData;
+}
+
 int MusicLrcFromKrc::sncasecmp(char *s1, char *s2, size_t n)
 {
     uint c1, c2;
@@ -206,7 +220,7 @@ void MusicLrcFromKrc::createLrc(uchar *lrc, int lrclen)
                             char ftime[14];
                             lrc[i + j] = 0;
                             ms = atoi((char*)&lrc[i + 1]);
-                            sprintf(ftime, "[%.2d:%.2d.%.2d]", (ms % MT_H2MS) / MT_M2MS, (ms % MT_M2MS) / MT_S2MS, (ms % MT_M2MS) % 100);
+                            sprintf(ftime, "[%.2d:%.2d.%.2d]", (ms % MT_H2MS) / MT_M2MS, (ms % MT_M2MS) / MT_S2MS, (ms % MT_S2MS) / 10);
 
                             for(j = 0; j < 10; j++)
                             {
@@ -43,6 +43,10 @@ public:
      * Get decode string.
      */
     QByteArray getDecodeString() const;
+    /*!
+     * Get raw krc string with word timings.
+     */
+    QByteArray getRawString() const;
 
 protected:
     /*!
@@ -63,7 +67,7 @@ protected:
     void createLrc(uchar *lrc, int lrclen);
 
     uchar *m_resultBytes;
-    QByteArray m_data;
+    QByteArray m_data, m_rawData;
 
 };
 
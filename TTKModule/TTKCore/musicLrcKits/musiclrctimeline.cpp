@@ -0,0 +1,100 @@
+#include "musiclrctimeline.h"
+
+#include <algorithm>
+
+MusicLrcTimeline::MusicLrcTimeline()
+{
+
+}
+
+void MusicLrcTimeline::clear()
+{
+    m_times.clear();
+    m_texts.clear();
+    m_words.clear();
+}
+
+void MusicLrcTimeline::insert(qint64 time, const QString &text, const MusicLrcWords &words)
+{
+    m_times << time;
+    m_texts << text;
+    m_words << words;
+}
+
+void MusicLrcTimeline::finish()
+{
+    QVector<int> order(m_times.count());
+    for(int i=0; i<order.count(); ++i)
+    {
+        order[i] = i;
+    }
+
+    std::stable_sort(order.begin(), order.end(), [this](int a, int b)
+    {
+        return m_times[a] < m_times[b];
+    });
+
+    QVector<qint64> times;
+    QStringList texts;
+    QVector<MusicLrcWords> words;
+    times.reserve(order.count());
+    texts.reserve(order.count());
+    words.reserve(order.count());
+    foreach(const int index, order)
+    {
+        ///the same time is replaced by the later line, as the map insert did
+        if(!times.isEmpty() && times.last() == m_times[index])
+        {
+            texts.last() = m_texts[index];
+            words.last() = m_words[index];
+            continue;
+        }
+        times << m_times[index];
+        texts << m_texts[index];
+        words << m_words[index];
+    }
+
+    m_times = times;
+    m_texts = texts;
+    m_words = words;
+}
+
+void MusicLrcTimeline::setData(const TTKIntStringMap &data)
+{
+    clear();
+    m_times.reserve(data.count());
+    m_texts.reserve(data.count());
+    m_words.reserve(data.count());
+
+    TTKIntStringMapIterator it(data);
+    while(it.hasNext())
+    {
+        it.next();
+        insert(it.key(), it.value());
+    }
+}
+
+bool MusicLrcTimeline::contains(qint64 time) const
+{
+    const int index = findLowerIndex(time);
+    return index < m_times.count() && m_times[index] == time;
+}
+
+int MusicLrcTimeline::findIndex(qint64 time) const
+{
+    return std::upper_bound(m_times.constBegin(), m_times.constEnd(), time) - m_times.constBegin() - 1;
+}
+
+int MusicLrcTimeline::findLowerIndex(qint64 time, int from) const
+{
+    from = qBound(0, from, m_times.count());
+    return std::lower_bound(m_times.constBegin() + from, m_times.constEnd(), time) - m_times.constBegin();
+}
+
+void MusicLrcTimeline::shift(qint64 pos)
+{
+    for(int i=0; i<m_times.count(); ++i)
+    {
+        m_times[i] += pos;
+    }
+}
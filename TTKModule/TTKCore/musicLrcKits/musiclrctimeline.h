@@ -0,0 +1,126 @@
+#ifndef MUSICLRCTIMELINE_H
+#define MUSICLRCTIMELINE_H
+
+/* =================================================
+ * This file is part of the TTK Music Player project
+ * Copyright (C) 2015 - 2020 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ================================================= */
+
+#include <QVector>
+#include <QStringList>
+#include "musicglobaldefine.h"
+
+/*! @brief The class of the lrc word timing.
+ * @author Greedysky <greedysky@163.com>
+ */
+typedef struct MUSIC_LRC_EXPORT MusicLrcWord
+{
+    qint64 m_offset;    ///offset from the line time
+    qint64 m_duration;
+    int m_length;       ///char count of the word in line text
+
+    MusicLrcWord()
+    {
+        m_offset = 0;
+        m_duration = 0;
+        m_length = 0;
+    }
+}MusicLrcWord;
+TTK_DECLARE_LISTS(MusicLrcWord)
+
+
+/*! @brief The class of the lrc timeline.
+ * Line times and texts are kept in sorted flat arrays, so the line of
+ * a play position is found by binary search.
+ * @author Greedysky <greedysky@163.com>
+ */
+class MUSIC_LRC_EXPORT MusicLrcTimeline
+{
+    TTK_DECLARE_MODULE(MusicLrcTimeline)
+public:
+    /*!
+     * Object contsructor.
+     */
+    MusicLrcTimeline();
+
+    /*!
+     * Clear all lines.
+     */
+    void clear();
+    /*!
+     * Append line by time, call finish when all lines appended.
+     */
+    void insert(qint64 time, const QString &text, const MusicLrcWords &words = MusicLrcWords());
+    /*!
+     * Sort lines by time, the last line of the same time is kept.
+     */
+    void finish();
+    /*!
+     * Set lines from time text map.
+     */
+    void setData(const TTKIntStringMap &data);
+
+    /*!
+     * Check current timeline is empty or not.
+     */
+    inline bool isEmpty() const { return m_times.isEmpty(); }
+    /*!
+     * Get current timeline line count.
+     */
+    inline int count() const { return m_times.count(); }
+    /*!
+     * Check current timeline contains time or not.
+     */
+    bool contains(qint64 time) const;
+
+    /*!
+     * Get line time by index.
+     */
+    inline qint64 time(int index) const { return m_times[index]; }
+    /*!
+     * Get line text by index.
+     */
+    inline const QString& text(int index) const { return m_texts[index]; }
+    /*!
+     * Get all line texts.
+     */
+    inline const QStringList& texts() const { return m_texts; }
+    /*!
+     * Get line word timings by index, empty if the line has no word timing.
+     */
+    inline const MusicLrcWords& words(int index) const { return m_words[index]; }
+
+    /*!
+     * Find the line index of time, return -1 if before the first line.
+     */
+    int findIndex(qint64 time) const;
+    /*!
+     * Find the first line index whose time is not less than time in [from, count).
+     */
+    int findLowerIndex(qint64 time, int from = 0) const;
+    /*!
+     * Move all lines time by pos.
+     */
+    void shift(qint64 pos);
+
+private:
+    QVector<qint64> m_times;
+    QStringList m_texts;
+    QVector<MusicLrcWords> m_words;
+
+};
+
+#endif // MUSICLRCTIMELINE_H
@@ -30,6 +30,9 @@ INCLUDEPATH += $$PWD \
 
 HEADERS  += \
     $$PWD/common/musicnetworkthread.h \
+    $$PWD/common/musicnetworksession.h \
+    $$PWD/common/musicdownloadlimiter.h \
+    $$PWD/common/musicdownloadjournal.h \
     $$PWD/common/musicnetworkproxy.h \
     $$PWD/common/musicnetworkoperator.h \
     $$PWD/common/musicdownloaddatarequest.h \
@@ -163,6 +166,9 @@ HEADERS  += \
 
 SOURCES += \
     $$PWD/common/musicnetworkthread.cpp \
+    $$PWD/common/musicnetworksession.cpp \
+    $$PWD/common/musicdownloadlimiter.cpp \
+    $$PWD/common/musicdownloadjournal.cpp \
     $$PWD/common/musicnetworkproxy.cpp \
     $$PWD/common/musicnetworkoperator.cpp \
     $$PWD/common/musicdownloaddatarequest.cpp \
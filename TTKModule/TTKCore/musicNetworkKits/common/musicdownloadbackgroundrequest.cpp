@@ -14,6 +14,8 @@ void MusicDownloadBackgroundRequest::downLoadFinished()
 {
     if(++m_index >= m_counter)
     {
+        ///the directory watcher notifies later, list the new photos now
+        M_BACKGROUND_PTR->backgroundDirectoryChanged();
         M_BACKGROUND_PTR->setArtistName(m_artName);
 #ifndef MUSIC_MOBILE
         MusicTopAreaWidget::instance()->musicBackgroundThemeDownloadFinished();
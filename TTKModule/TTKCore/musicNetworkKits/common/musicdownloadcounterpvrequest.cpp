@@ -13,7 +13,7 @@ MusicDownloadCounterPVRequest::~MusicDownloadCounterPVRequest()
 
 void MusicDownloadCounterPVRequest::startToDownload()
 {
-    m_manager = new QNetworkAccessManager(this);
+    m_manager = M_NETWORK_SESSION_PTR->manager();
 
     QNetworkRequest request;
     request.setUrl(QUrl(MusicUtils::Algorithm::mdII(QURTY_URL, false)));
@@ -21,7 +21,7 @@ void MusicDownloadCounterPVRequest::startToDownload()
     request.setRawHeader("Referer", MusicUtils::Algorithm::mdII(REFER_URL, false).toUtf8());
     request.setRawHeader("Cookie", MusicUtils::Algorithm::mdII(COOKIE_URL, false).toUtf8());
 #ifndef QT_NO_SSL
-    connect(m_manager, SIGNAL(sslErrors(QNetworkReply*,QList<QSslError>)), SLOT(sslErrors(QNetworkReply*,QList<QSslError>)));
+    connect(m_manager, SIGNAL(sslErrors(QNetworkReply*,QList<QSslError>)), SLOT(sslErrors(QNetworkReply*,QList<QSslError>)), Qt::UniqueConnection);
     MusicObject::setSslConfiguration(&request);
 #endif
 
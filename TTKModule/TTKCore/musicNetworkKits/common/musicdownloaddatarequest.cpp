@@ -1,33 +1,125 @@
 #include "musicdownloaddatarequest.h"
 #include "musicdownloadmanager.h"
+#include "musicdownloadlimiter.h"
 #include "musicnumberutils.h"
 
+#include <QCryptographicHash>
+
 MusicDownloadDataRequest::MusicDownloadDataRequest(const QString &url, const QString &save, MusicObject::DownloadType type, QObject *parent)
-    : MusicAbstractDownLoadRequest(url, save, type, parent)
+    : MusicAbstractDownLoadRequest(url, save, type, parent),
+      m_journal(save)
 {
     m_createItemTime = -1;
-    m_redirection = false;
     m_needUpdate = true;
+    m_resumable = false;
+    m_retryCount = 0;
     m_recordType = MusicObject::RecordNull;
+    m_file->setFileName(m_journal.partPath());
+}
+
+MusicDownloadDataRequest::~MusicDownloadDataRequest()
+{
+    saveJournal();
+    releaseSegments();
+}
+
+void MusicDownloadDataRequest::deleteAll()
+{
+    saveJournal();
+    releaseSegments();
+    MusicAbstractDownLoadRequest::deleteAll();
 }
 
 void MusicDownloadDataRequest::startToDownload()
 {
-    if(m_file && (!m_file->exists() || m_file->size() < 4))
+    if(!m_file)
     {
-        if(m_file->open(QIODevice::WriteOnly))
+        return;
+    }
+
+    ///resume from the journal left by the last interrupted download
+    const bool resume = m_journal.read(m_url) && m_file->open(QIODevice::ReadWrite);
+    if(!resume)
+    {
+        m_journal.remove();
+        if(!m_file->open(QIODevice::WriteOnly))
         {
-            m_manager = new QNetworkAccessManager(this);
+            TTK_LOGGER_ERROR("The data file create failed");
+            Q_EMIT downLoadDataChanged("The data file create failed");
+            deleteAll();
+            return;
+        }
+    }
+
+    m_manager = M_NETWORK_SESSION_PTR->manager();
 #ifndef QT_NO_SSL
-            connect(m_manager, SIGNAL(sslErrors(QNetworkReply*,QList<QSslError>)), SLOT(sslErrors(QNetworkReply*,QList<QSslError>)));
+    connect(m_manager, SIGNAL(sslErrors(QNetworkReply*,QList<QSslError>)), SLOT(sslErrors(QNetworkReply*,QList<QSslError>)), Qt::UniqueConnection);
 #endif
-            startRequest(m_url);
+    /// only download music data can that show progress
+    if(m_downloadType == MusicObject::DownloadMusic)
+    {
+        m_createItemTime = MusicTime::timestamp();
+        M_DOWNLOAD_MANAGER_PTR->connectMusicDownload(MusicDownLoadPair(m_createItemTime, this, m_recordType));
+        Q_EMIT createDownloadItem(m_savePath, m_createItemTime);
+    }
+
+    m_requestUrl = m_url;
+    if(!resume)
+    {
+        startRequest(m_requestUrl);
+        return;
+    }
+
+    TTK_LOGGER_INFO(QString("data download resumes at %1 bytes").arg(m_journal.received()));
+    m_resumable = true;
+    m_hasReceived = m_currentReceived = m_journal.received();
+    m_speedTimer.start();
+
+    for(int i = 0; i < m_journal.m_segments.count(); ++i)
+    {
+        m_segmentReplies << nullptr;
+        if(!m_journal.m_segments[i].isFinished())
+        {
+            startSegment(i);
         }
-        else
+    }
+
+    if(m_journal.isFinished())
+    {
+        downLoadFinished();
+    }
+}
+
+qint64 MusicDownloadDataRequest::readLimitedData(qint64 maxSize)
+{
+    qint64 size = 0;
+    for(int i = 0; i < m_segmentReplies.count() && size < maxSize; ++i)
+    {
+        size += readSegmentData(i, maxSize - size);
+    }
+    return size;
+}
+
+qint64 MusicDownloadDataRequest::pendingDataSize() const
+{
+    qint64 size = 0;
+    foreach(const QPointer<QNetworkReply> &reply, m_segmentReplies)
+    {
+        if(reply)
         {
-            TTK_LOGGER_ERROR("The data file create failed");
-            Q_EMIT downLoadDataChanged("The data file create failed");
-            deleteAll();
+            size += reply->bytesAvailable();
+        }
+    }
+    return size;
+}
+
+void MusicDownloadDataRequest::setReadBufferSize(qint64 size)
+{
+    foreach(const QPointer<QNetworkReply> &reply, m_segmentReplies)
+    {
+        if(reply)
+        {
+            reply->setReadBufferSize(size);
         }
     }
 }
@@ -50,63 +142,353 @@ void MusicDownloadDataRequest::startRequest(const QUrl &url)
     request.setUrl(url);
     MusicObject::setSslConfiguration(&request);
 
+    ///the whole data is the first segment until the response tells the size
+    m_resumable = false;
+    m_journal.m_totalSize = -1;
+    m_journal.m_validator.clear();
+    m_journal.m_checksum.clear();
+    m_journal.m_segments.clear();
+    m_journal.m_segments << MusicDownloadSegment();
+    m_segmentReplies.clear();
+
     m_reply = m_manager->get(request);
-    connect(m_reply, SIGNAL(finished()), this, SLOT(downLoadFinished()));
-    connect(m_reply, SIGNAL(error(QNetworkReply::NetworkError)), SLOT(replyError(QNetworkReply::NetworkError)));
-    connect(m_reply, SIGNAL(readyRead()),this, SLOT(downLoadReadyRead()));
-    connect(m_reply, SIGNAL(downloadProgress(qint64, qint64)), SLOT(downloadProgress(qint64, qint64)));
-    /// only download music data can that show progress
-    if(m_downloadType == MusicObject::DownloadMusic && !m_redirection)
+    m_segmentReplies << m_reply;
+    connect(m_reply, SIGNAL(metaDataChanged()), SLOT(segmentMetaDataChanged()));
+    connect(m_reply, SIGNAL(finished()), SLOT(segmentFinished()));
+    connect(m_reply, SIGNAL(readyRead()), SLOT(downLoadReadyRead()));
+    M_DOWNLOAD_LIMITER_PTR->append(this);
+}
+
+void MusicDownloadDataRequest::startSegment(int index)
+{
+    if(!m_manager)
     {
-        m_createItemTime = MusicTime::timestamp();
-        M_DOWNLOAD_MANAGER_PTR->connectMusicDownload(MusicDownLoadPair(m_createItemTime, this, m_recordType));
-        Q_EMIT createDownloadItem(m_savePath, m_createItemTime);
+        return;
     }
+
+    const MusicDownloadSegment &segment = m_journal.m_segments[index];
+    QNetworkRequest request;
+    request.setUrl(m_requestUrl);
+    request.setRawHeader("Range", QString("bytes=%1-%2").arg(segment.offset()).arg(segment.m_end).toUtf8());
+    if(!m_journal.m_validator.isEmpty())
+    {
+        request.setRawHeader("If-Range", m_journal.m_validator.toUtf8());
+    }
+    MusicObject::setSslConfiguration(&request);
+
+    QNetworkReply *reply = m_manager->get(request);
+    connect(reply, SIGNAL(metaDataChanged()), SLOT(segmentMetaDataChanged()));
+    connect(reply, SIGNAL(finished()), SLOT(segmentFinished()));
+    connect(reply, SIGNAL(readyRead()), SLOT(downLoadReadyRead()));
+
+    m_segmentReplies[index] = reply;
+    if(!m_reply)
+    {
+        m_reply = reply;
+    }
+    M_DOWNLOAD_LIMITER_PTR->append(this);
 }
 
-void MusicDownloadDataRequest::downLoadFinished()
+qint64 MusicDownloadDataRequest::readSegmentData(int index, qint64 maxSize)
+{
+    QNetworkReply *reply = m_segmentReplies[index];
+    if(!m_file || !reply || maxSize <= 0)
+    {
+        return 0;
+    }
+
+    ///redirection body is useless
+    if(!reply->attribute(QNetworkRequest::RedirectionTargetAttribute).isNull())
+    {
+        reply->readAll();
+        return 0;
+    }
+
+    MusicDownloadSegment &segment = m_journal.m_segments[index];
+    qint64 size = qMin(maxSize, reply->bytesAvailable());
+    if(segment.m_end >= 0)
+    {
+        size = qMin(size, segment.remain());
+    }
+
+    if(size > 0)
+    {
+        const QByteArray &bytes = reply->read(size);
+        if(!m_file->seek(segment.offset()) || m_file->write(bytes) != bytes.size())
+        {
+            TTK_LOGGER_ERROR("The data file write failed");
+            return 0;
+        }
+
+        size = bytes.size();
+        segment.m_received += size;
+        m_retryCount = 0;
+        downloadProgress(m_journal.received(), m_journal.m_totalSize);
+    }
+    else
+    {
+        size = 0;
+    }
+
+    ///the whole data request runs over the first segment, stop it
+    if(segment.isFinished() && reply->isRunning())
+    {
+        reply->abort();
+    }
+    return size;
+}
+
+void MusicDownloadDataRequest::releaseSegments()
+{
+    foreach(const QPointer<QNetworkReply> &reply, m_segmentReplies)
+    {
+        if(reply)
+        {
+            disconnect(reply, nullptr, this, nullptr);
+            reply->abort();
+            reply->deleteLater();
+        }
+    }
+    m_segmentReplies.clear();
+    m_reply = nullptr;
+}
+
+void MusicDownloadDataRequest::restartDownload()
+{
+    TTK_LOGGER_INFO("remote data changed, data download restarts");
+    releaseSegments();
+
+    QFile::remove(m_journal.journalPath());
+    m_file->resize(0);
+    m_hasReceived = m_currentReceived = 0;
+
+    startRequest(m_url);
+}
+
+void MusicDownloadDataRequest::saveJournal()
+{
+    if(m_resumable && m_file && m_file->isOpen() && !m_journal.isFinished())
+    {
+        m_file->flush();
+        m_journal.write();
+    }
+}
+
+bool MusicDownloadDataRequest::checkIntegrity() const
 {
-    if(!m_file || !m_reply)
+    if(!m_journal.isFinished())
+    {
+        return false;
+    }
+
+    QFile file(m_journal.partPath());
+    if(m_journal.m_totalSize > 0 && file.size() != m_journal.m_totalSize)
+    {
+        return false;
+    }
+
+    if(m_journal.m_checksum.isEmpty())
+    {
+        return true;
+    }
+
+    if(!file.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    while(!file.atEnd())
+    {
+        hash.addData(file.read(MH_MB2B));
+    }
+    return hash.result() == QByteArray::fromBase64(m_journal.m_checksum.toUtf8());
+}
+
+bool MusicDownloadDataRequest::saveDataFile()
+{
+    if(!m_file)
     {
         deleteAll();
-        return;
+        return false;
     }
 
-    m_redirection = false;
     m_speedTimer.stop();
     m_file->flush();
     m_file->close();
 
-    const QVariant &redirectionTarget = m_reply->attribute(QNetworkRequest::RedirectionTargetAttribute);
-    if(m_reply->error() != QNetworkReply::NoError)
+    if(!checkIntegrity())
     {
-        m_file->remove();
+        TTK_LOGGER_ERROR("The data file integrity check failed");
+        m_journal.remove();
+        Q_EMIT downLoadDataChanged("The file create failed");
+        deleteAll();
+        return false;
     }
-    else if(!redirectionTarget.isNull())
+
+    QFile::remove(m_savePath);
+    if(!QFile::rename(m_journal.partPath(), m_savePath))
+    {
+        TTK_LOGGER_ERROR("The data file rename failed");
+        m_journal.remove();
+        Q_EMIT downLoadDataChanged("The file create failed");
+        deleteAll();
+        return false;
+    }
+    m_journal.remove();
+    return true;
+}
+
+void MusicDownloadDataRequest::downLoadFinished()
+{
+    if(!saveDataFile())
     {
-        m_redirection = true;
-        m_reply->deleteLater();
-        m_file->open(QIODevice::WriteOnly);
-        m_file->resize(0);
-        startRequest(m_reply->url().resolved(redirectionTarget.toUrl()));
         return;
     }
-    else
+
+    if(m_needUpdate)
     {
-        if(m_needUpdate)
-        {
-            Q_EMIT downLoadDataChanged(mapCurrentQueryData());
-            TTK_LOGGER_INFO("data download has finished");
-        }
+        Q_EMIT downLoadDataChanged(mapCurrentQueryData());
+        TTK_LOGGER_INFO("data download has finished");
     }
     deleteAll();
 }
 
 void MusicDownloadDataRequest::downLoadReadyRead()
 {
-    if(m_file)
+    ///data is read by the download limiter when speed limited
+    if(M_DOWNLOAD_LIMITER_PTR->isLimited())
+    {
+        return;
+    }
+
+    QNetworkReply *reply = TTKObject_cast(QNetworkReply*, sender());
+    const int index = m_segmentReplies.indexOf(reply);
+    if(index >= 0)
+    {
+        readSegmentData(index, reply->bytesAvailable());
+    }
+}
+
+void MusicDownloadDataRequest::segmentMetaDataChanged()
+{
+    QNetworkReply *reply = TTKObject_cast(QNetworkReply*, sender());
+    const int index = m_segmentReplies.indexOf(reply);
+    if(index < 0)
+    {
+        return;
+    }
+
+    const int code = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if(reply->request().hasRawHeader("Range"))
+    {
+        ///the server ignores the range or the data has changed since the journal
+        if(code == 200 || code == 416)
+        {
+            restartDownload();
+        }
+        return;
+    }
+
+    if(code != 200 || m_journal.m_totalSize > 0 || reply->hasRawHeader("Content-Encoding"))
+    {
+        return;
+    }
+
+    const qint64 total = reply->header(QNetworkRequest::ContentLengthHeader).toLongLong();
+    if(total <= 0)
+    {
+        return;
+    }
+
+    m_journal.m_url = m_url;
+    m_journal.m_totalSize = total;
+    m_journal.m_checksum = reply->rawHeader("Content-MD5");
+    m_journal.m_validator = reply->hasRawHeader("ETag") ? reply->rawHeader("ETag") : reply->rawHeader("Last-Modified");
+    m_journal.m_segments[0].m_end = total - 1;
+
+    m_resumable = reply->rawHeader("Accept-Ranges").toLower() == "bytes";
+    if(!m_resumable)
+    {
+        return;
+    }
+
+    ///split the large data, the running request keeps the first segment
+    const int count = qBound(TTKStatic_cast(qint64, 1), total / DOWNLOAD_SEGMENT_SIZE, TTKStatic_cast(qint64, DOWNLOAD_SEGMENT_COUNT));
+    const qint64 size = total / count;
+    m_journal.m_segments[0].m_end = size - 1;
+    for(int i = 1; i < count; ++i)
+    {
+        m_journal.m_segments << MusicDownloadSegment(i * size, (i == count - 1) ? total - 1 : (i + 1) * size - 1);
+        m_segmentReplies << nullptr;
+        startSegment(i);
+    }
+    m_journal.write();
+}
+
+void MusicDownloadDataRequest::segmentFinished()
+{
+    QNetworkReply *reply = TTKObject_cast(QNetworkReply*, sender());
+    const int index = m_segmentReplies.indexOf(reply);
+    if(index < 0 || !m_file)
+    {
+        return;
+    }
+
+    ///the rest data left by the limiter is small, write it and charge to limiter
+    M_DOWNLOAD_LIMITER_PTR->consume(readSegmentData(index, reply->bytesAvailable()));
+    m_segmentReplies[index] = nullptr;
+    reply->deleteLater();
+
+    const MusicDownloadSegment &segment = m_journal.m_segments[index];
+    const QVariant &redirectionTarget = reply->attribute(QNetworkRequest::RedirectionTargetAttribute);
+    if(!redirectionTarget.isNull())
+    {
+        m_requestUrl = reply->url().resolved(redirectionTarget.toUrl());
+        if(reply->request().hasRawHeader("Range"))
+        {
+            startSegment(index);
+        }
+        else
+        {
+            m_file->resize(0);
+            startRequest(m_requestUrl);
+        }
+        return;
+    }
+
+    if(segment.m_end < 0 && reply->error() == QNetworkReply::NoError)
+    {
+        ///the size is unknown until the whole data request finished
+        m_journal.m_segments[index].m_end = segment.offset() - 1;
+    }
+
+    if(!segment.isFinished())
+    {
+        ///only the dropped connection is worth to retry, not the http error
+        const int code = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+        if(m_resumable && code < 400 && m_retryCount++ < DOWNLOAD_RETRY_COUNT)
+        {
+            TTK_LOGGER_INFO(QString("data download segment %1 dropped at %2, retry").arg(index).arg(segment.offset()));
+            startSegment(index);
+            return;
+        }
+
+        const QNetworkReply::NetworkError error = reply->error();
+        ///keep the partial data for resuming next time
+        saveJournal();
+        m_file->close();
+        if(!m_resumable)
+        {
+            m_journal.remove();
+        }
+        replyError(error);
+        return;
+    }
+
+    if(m_journal.isFinished())
     {
-        m_file->write(m_reply->readAll());
+        downLoadFinished();
     }
 }
 
@@ -117,7 +499,7 @@ void MusicDownloadDataRequest::downloadProgress(qint64 bytesReceived, qint64 byt
     if(m_downloadType == MusicObject::DownloadMusic || m_downloadType == MusicObject::DownloadOther)
     {
         const QString &total = MusicUtils::Number::size2Label(bytesTotal);
-        Q_EMIT downloadProgressChanged(bytesTotal != 0 ? bytesReceived*100.0/bytesTotal : 0, total, m_createItemTime);
+        Q_EMIT downloadProgressChanged(bytesTotal > 0 ? bytesReceived*100.0/bytesTotal : 0, total, m_createItemTime);
     }
 }
 
@@ -129,4 +511,5 @@ void MusicDownloadDataRequest::updateDownloadSpeed()
 
     Q_EMIT downloadSpeedLabelChanged(label, time);
     MusicAbstractDownLoadRequest::updateDownloadSpeed();
+    saveJournal();
 }
@@ -19,9 +19,17 @@
  * with this program; If not, see <http://www.gnu.org/licenses/>.
  ================================================= */
 
+#include "musicdownloadjournal.h"
 #include "musicabstractdownloadrequest.h"
 
+#define DOWNLOAD_SEGMENT_COUNT  4               // max parallel segments of one download
+#define DOWNLOAD_SEGMENT_SIZE   (4 * MH_MB2B)   // min size of one segment
+#define DOWNLOAD_RETRY_COUNT    5               // retry times of a dropped segment
+
 /*! @brief The class of downloading the type of data.
+ * Data goes to a partial file with a sidecar journal, an interrupted download
+ * resumes by http range, and large files are fetched by parallel segments
+ * when the server accepts ranges.
  * @author Greedysky <greedysky@163.com>
  */
 class MUSIC_NETWORK_EXPORT MusicDownloadDataRequest : public MusicAbstractDownLoadRequest
@@ -34,10 +42,29 @@ public:
      */
     MusicDownloadDataRequest(const QString &url, const QString &save, MusicObject::DownloadType type, QObject *parent = nullptr);
 
+    virtual ~MusicDownloadDataRequest();
+
+    /*!
+     * Release the network object.
+     */
+    virtual void deleteAll() override;
+
     /*!
      * Start to download data.
      */
     virtual void startToDownload() override;
+    /*!
+     * Read the received data at most max size by the download limiter.
+     */
+    virtual qint64 readLimitedData(qint64 maxSize) override;
+    /*!
+     * Get the received data size not read yet.
+     */
+    virtual qint64 pendingDataSize() const override;
+    /*!
+     * Set the reply read buffer size, zero means unlimited.
+     */
+    virtual void setReadBufferSize(qint64 size) override;
 
     /*!
      * Set record type.
@@ -80,14 +107,57 @@ public Q_SLOTS:
      */
     void downLoadReadyRead();
 
+private Q_SLOTS:
+    /*!
+     * Download segment response header arrived.
+     */
+    void segmentMetaDataChanged();
+    /*!
+     * Download segment finished.
+     */
+    void segmentFinished();
+
 protected:
     /*!
-     * Start to download data from url.
+     * Start to download whole data from url.
      */
     void startRequest(const QUrl &url);
+    /*!
+     * Start to download the rest range of segment.
+     */
+    void startSegment(int index);
+    /*!
+     * Read at most max size of segment data into file, return the read size.
+     */
+    qint64 readSegmentData(int index, qint64 maxSize);
+    /*!
+     * Abort and release all segment replies.
+     */
+    void releaseSegments();
+    /*!
+     * Drop the partial data and download from the beginning.
+     */
+    void restartDownload();
+    /*!
+     * Write the journal when download can be resumed.
+     */
+    void saveJournal();
+    /*!
+     * Check the completed data size and checksum.
+     */
+    bool checkIntegrity() const;
+    /*!
+     * Move the completed data to the save path.
+     * Return false when it failed, the error is sent and the request is released.
+     */
+    bool saveDataFile();
 
     qint64 m_createItemTime;
-    bool m_redirection, m_needUpdate;
+    bool m_needUpdate, m_resumable;
+    int m_retryCount;
+    QUrl m_requestUrl;
+    MusicDownloadJournal m_journal;
+    QList< QPointer<QNetworkReply> > m_segmentReplies;
     MusicObject::RecordType m_recordType;
 };
 
@@ -16,51 +16,23 @@ void MusicDownloadDataTagRequest::setSongTag(const MusicSongTag &tag)
     m_musicTag = tag;
 }
 
-void MusicDownloadDataTagRequest::startToDownload()
-{
-    if(m_file && (!m_file->exists() || m_file->size() < 4))
-    {
-        if(m_file->open(QIODevice::WriteOnly))
-        {
-            m_manager = new QNetworkAccessManager(this);
-#ifndef QT_NO_SSL
-            connect(m_manager, SIGNAL(sslErrors(QNetworkReply*,QList<QSslError>)), SLOT(sslErrors(QNetworkReply*,QList<QSslError>)));
-#endif
-            startRequest(m_url);
-            disconnect(m_reply, SIGNAL(finished()), this, SLOT(downLoadFinished()));
-            connect(m_reply, SIGNAL(finished()), this, SLOT(downLoadFinished()));
-        }
-        else
-        {
-            TTK_LOGGER_ERROR("The data file create failed");
-            Q_EMIT downLoadDataChanged("The data file create failed");
-            deleteAll();
-        }
-    }
-}
-
 void MusicDownloadDataTagRequest::downLoadFinished()
 {
-    bool save = (m_file != nullptr);
-    MusicDownloadDataRequest::downLoadFinished();
-
-    if(m_redirection)
+    if(!saveDataFile())
     {
         return;
     }
 
-    if(save)
-    {
-        MusicSemaphoreLoop loop;
-        MusicDownloadSourceRequest *download = new MusicDownloadSourceRequest(this);
-        connect(download, SIGNAL(downLoadRawDataChanged(QByteArray)), SLOT(downLoadFinished(QByteArray)));
-        download->startToDownload(m_musicTag.getComment());
-        connect(this, SIGNAL(finished()), &loop, SLOT(quit()));
-        loop.exec();
-    }
+    MusicSemaphoreLoop loop;
+    MusicDownloadSourceRequest *download = new MusicDownloadSourceRequest(this);
+    connect(download, SIGNAL(downLoadRawDataChanged(QByteArray)), SLOT(downLoadFinished(QByteArray)));
+    download->startToDownload(m_musicTag.getComment());
+    connect(this, SIGNAL(finished()), &loop, SLOT(quit()));
+    loop.exec();
 
     Q_EMIT downLoadDataChanged(mapCurrentQueryData());
     TTK_LOGGER_INFO("data download has finished");
+    deleteAll();
 }
 
 void MusicDownloadDataTagRequest::downLoadFinished(const QByteArray &data)
@@ -39,10 +39,6 @@ public:
      * Set custom tags.
      */
     void setSongTag(const MusicSongTag &tag);
-    /*!
-     * Start to download data.
-     */
-    virtual void startToDownload() override;
 
 Q_SIGNALS:
     /*!
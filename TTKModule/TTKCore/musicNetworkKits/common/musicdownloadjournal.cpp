@@ -0,0 +1,99 @@
+#include "musicdownloadjournal.h"
+
+#include <QFile>
+#include <QSettings>
+
+MusicDownloadJournal::MusicDownloadJournal(const QString &path)
+    : m_path(path)
+{
+    m_totalSize = -1;
+}
+
+bool MusicDownloadJournal::read(const QString &url)
+{
+    m_segments.clear();
+    if(!QFile::exists(journalPath()) || !QFile::exists(partPath()))
+    {
+        return false;
+    }
+
+    QSettings settings(journalPath(), QSettings::IniFormat);
+    m_url = settings.value("Url").toString();
+    m_validator = settings.value("Validator").toString();
+    m_checksum = settings.value("Checksum").toString();
+    m_totalSize = settings.value("TotalSize", -1).toLongLong();
+
+    const int count = settings.beginReadArray("Segments");
+    for(int i = 0; i < count; ++i)
+    {
+        settings.setArrayIndex(i);
+        MusicDownloadSegment segment(settings.value("Start").toLongLong(), settings.value("End").toLongLong());
+        segment.m_received = settings.value("Received").toLongLong();
+        m_segments << segment;
+    }
+    settings.endArray();
+
+    ///the partial file must hold all the data journal recorded
+    qint64 end = 0;
+    foreach(const MusicDownloadSegment &segment, m_segments)
+    {
+        end = qMax(end, segment.offset());
+    }
+    return m_url == url && m_totalSize > 0 && !m_segments.isEmpty() && QFile(partPath()).size() >= end;
+}
+
+bool MusicDownloadJournal::write() const
+{
+    QSettings settings(journalPath(), QSettings::IniFormat);
+    settings.clear();
+    settings.setValue("Url", m_url);
+    settings.setValue("Validator", m_validator);
+    settings.setValue("Checksum", m_checksum);
+    settings.setValue("TotalSize", m_totalSize);
+
+    settings.beginWriteArray("Segments", m_segments.count());
+    for(int i = 0; i < m_segments.count(); ++i)
+    {
+        const MusicDownloadSegment &segment = m_segments[i];
+        settings.setArrayIndex(i);
+        settings.setValue("Start", segment.m_start);
+        settings.setValue("End", segment.m_end);
+        settings.setValue("Received", segment.m_received);
+    }
+    settings.endArray();
+    settings.sync();
+    return settings.status() == QSettings::NoError;
+}
+
+void MusicDownloadJournal::remove() const
+{
+    QFile::remove(journalPath());
+    QFile::remove(partPath());
+}
+
+bool MusicDownloadJournal::isFinished() const
+{
+    if(m_segments.isEmpty())
+    {
+        return false;
+    }
+
+    foreach(const MusicDownloadSegment &segment, m_segments)
+    {
+        if(!segment.isFinished())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+qint64 MusicDownloadJournal::received() const
+{
+    qint64 size = 0;
+    foreach(const MusicDownloadSegment &segment, m_segments)
+    {
+        size += segment.m_received;
+    }
+    return size;
+}
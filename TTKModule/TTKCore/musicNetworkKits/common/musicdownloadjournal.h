@@ -0,0 +1,110 @@
+#ifndef MUSICDOWNLOADJOURNAL_H
+#define MUSICDOWNLOADJOURNAL_H
+
+/* =================================================
+ * This file is part of the TTK Music Player project
+ * Copyright (C) 2015 - 2020 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ================================================= */
+
+#include "musicglobaldefine.h"
+
+#define DOWNLOAD_PART_FILE      ".part"     // partial data file suffix
+#define DOWNLOAD_JOURNAL_FILE   ".journal"  // progress journal file suffix
+
+/*! @brief The class of the download byte range segment.
+ * @author Greedysky <greedysky@163.com>
+ */
+typedef struct MUSIC_NETWORK_EXPORT MusicDownloadSegment
+{
+    qint64 m_start;         /*!< first byte offset*/
+    qint64 m_end;           /*!< last byte offset, -1 means to the end*/
+    qint64 m_received;      /*!< received size from start*/
+
+    MusicDownloadSegment()
+    {
+        m_start = 0;
+        m_end = -1;
+        m_received = 0;
+    }
+
+    MusicDownloadSegment(qint64 start, qint64 end)
+    {
+        m_start = start;
+        m_end = end;
+        m_received = 0;
+    }
+
+    inline qint64 offset() const { return m_start + m_received; }
+    inline qint64 remain() const { return m_end < 0 ? -1 : m_end + 1 - offset(); }
+    inline bool isFinished() const { return m_end >= 0 && offset() > m_end; }
+}MusicDownloadSegment;
+TTK_DECLARE_LISTS(MusicDownloadSegment)
+
+/*! @brief The class of the sidecar journal of resumable download.
+ * @author Greedysky <greedysky@163.com>
+ */
+class MUSIC_NETWORK_EXPORT MusicDownloadJournal
+{
+    TTK_DECLARE_MODULE(MusicDownloadJournal)
+public:
+    /*!
+     * Object contsructor by the download save path.
+     */
+    explicit MusicDownloadJournal(const QString &path);
+
+    /*!
+     * Get the partial data file path.
+     */
+    inline QString partPath() const { return m_path + DOWNLOAD_PART_FILE; }
+    /*!
+     * Get the journal file path.
+     */
+    inline QString journalPath() const { return m_path + DOWNLOAD_JOURNAL_FILE; }
+
+    /*!
+     * Read the journal, return false when it does not belong to url or the partial file is lost.
+     */
+    bool read(const QString &url);
+    /*!
+     * Write the journal.
+     */
+    bool write() const;
+    /*!
+     * Remove the journal and the partial data file.
+     */
+    void remove() const;
+
+    /*!
+     * Check all segments are finished.
+     */
+    bool isFinished() const;
+    /*!
+     * Get the received size of all segments.
+     */
+    qint64 received() const;
+
+    QString m_url;          /*!< download url*/
+    QString m_validator;    /*!< server etag or last modified*/
+    QString m_checksum;     /*!< server content md5 in base64*/
+    qint64 m_totalSize;     /*!< total data size*/
+    MusicDownloadSegments m_segments;
+
+private:
+    QString m_path;
+
+};
+
+#endif // MUSICDOWNLOADJOURNAL_H
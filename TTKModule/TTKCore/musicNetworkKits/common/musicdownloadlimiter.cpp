@@ -0,0 +1,133 @@
+#include "musicdownloadlimiter.h"
+#include "musicabstractdownloadrequest.h"
+#include "musicsettingmanager.h"
+
+MusicDownLoadLimiter::MusicDownLoadLimiter()
+    : QObject(nullptr)
+{
+    m_rate = 0;
+    m_tokens = 0;
+
+    m_timer.setInterval(DOWNLOAD_LIMIT_INTERVAL);
+    connect(&m_timer, SIGNAL(timeout()), SLOT(updateTokens()));
+}
+
+void MusicDownLoadLimiter::append(MusicAbstractDownLoadRequest *request)
+{
+    if(!m_requests.contains(request))
+    {
+        m_requests << request;
+    }
+
+    if(!m_timer.isActive())
+    {
+        updateRate();
+        m_clock.start();
+        m_timer.start();
+    }
+    request->setReadBufferSize(readBufferSize());
+}
+
+void MusicDownLoadLimiter::remove(MusicAbstractDownLoadRequest *request)
+{
+    m_requests.removeAll(request);
+    if(m_requests.isEmpty())
+    {
+        m_timer.stop();
+    }
+}
+
+void MusicDownLoadLimiter::consume(qint64 bytes)
+{
+    if(isLimited())
+    {
+        m_tokens -= bytes;
+    }
+}
+
+void MusicDownLoadLimiter::updateTokens()
+{
+    updateRate();
+
+    const qint64 elapsed = m_clock.restart();
+    if(!isLimited())
+    {
+        ///limit closed, flush the data buffered before
+        foreach(MusicAbstractDownLoadRequest *request, m_requests)
+        {
+            request->readLimitedData(request->pendingDataSize());
+        }
+        return;
+    }
+
+    ///the bucket holds at most two intervals of tokens
+    m_tokens = qMin(m_tokens + m_rate * elapsed / MT_S2MS, 2 * m_rate * DOWNLOAD_LIMIT_INTERVAL / MT_S2MS);
+
+    QList<MusicAbstractDownLoadRequest*> pending;
+    foreach(MusicAbstractDownLoadRequest *request, m_requests)
+    {
+        if(request->pendingDataSize() > 0)
+        {
+            pending << request;
+        }
+    }
+
+    ///share tokens equally, what the drained ones left goes to the others
+    while(m_tokens > 0 && !pending.isEmpty())
+    {
+        const qint64 share = qMax(TTKStatic_cast(qint64, 1), m_tokens / pending.count());
+        for(int i = 0; i < pending.count() && m_tokens > 0; )
+        {
+            MusicAbstractDownLoadRequest *request = pending[i];
+            const qint64 size = request->readLimitedData(qMin(share, m_tokens));
+            m_tokens -= size;
+
+            if(size < share || request->pendingDataSize() <= 0)
+            {
+                pending.removeAt(i);
+            }
+            else
+            {
+                ++i;
+            }
+        }
+    }
+
+    ///rotate the order, no download is always served first
+    if(m_requests.count() > 1)
+    {
+        m_requests << m_requests.takeFirst();
+    }
+}
+
+void MusicDownLoadLimiter::updateRate()
+{
+    qint64 rate = 0;
+    if(M_SETTING_PTR->value(MusicSettingManager::DownloadLimit).toInt() == 0)
+    {
+        rate = M_SETTING_PTR->value(MusicSettingManager::DownloadDLoadLimit).toInt() * MH_KB;
+    }
+
+    if(rate == m_rate)
+    {
+        return;
+    }
+
+    m_rate = rate;
+    m_tokens = 0;
+
+    const qint64 size = readBufferSize();
+    foreach(MusicAbstractDownLoadRequest *request, m_requests)
+    {
+        request->setReadBufferSize(size);
+    }
+}
+
+qint64 MusicDownLoadLimiter::readBufferSize() const
+{
+    if(!isLimited())
+    {
+        return 0;
+    }
+    return qBound(TTKStatic_cast(qint64, DOWNLOAD_LIMIT_MIN_BUFFER), m_rate / 4, TTKStatic_cast(qint64, DOWNLOAD_LIMIT_MAX_BUFFER));
+}
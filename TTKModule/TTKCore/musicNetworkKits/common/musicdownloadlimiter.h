@@ -0,0 +1,93 @@
+#ifndef MUSICDOWNLOADLIMITER_H
+#define MUSICDOWNLOADLIMITER_H
+
+/* =================================================
+ * This file is part of the TTK Music Player project
+ * Copyright (C) 2015 - 2020 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ================================================= */
+
+#include <QTimer>
+#include <QElapsedTimer>
+#include "musicsingleton.h"
+
+#define DOWNLOAD_LIMIT_INTERVAL     50          // token refill interval
+#define DOWNLOAD_LIMIT_MIN_BUFFER   (4 * MH_KB) // reply read buffer lower bound
+#define DOWNLOAD_LIMIT_MAX_BUFFER   (256 * MH_KB) // reply read buffer upper bound
+
+class MusicAbstractDownLoadRequest;
+
+/*! @brief The class of the global download speed limiter.
+ * All downloads share one token bucket, tokens are refilled by the timer,
+ * and every pending download gets a fair share of them. The socket reads
+ * are paused by the bounded reply read buffer instead of sleeping.
+ * @author Greedysky <greedysky@163.com>
+ */
+class MUSIC_NETWORK_EXPORT MusicDownLoadLimiter : public QObject
+{
+    Q_OBJECT
+    TTK_DECLARE_MODULE(MusicDownLoadLimiter)
+public:
+    /*!
+     * Add download request to limiter.
+     */
+    void append(MusicAbstractDownLoadRequest *request);
+    /*!
+     * Remove download request from limiter.
+     */
+    void remove(MusicAbstractDownLoadRequest *request);
+
+    /*!
+     * Check the download speed is limited now.
+     */
+    inline bool isLimited() const { return m_rate > 0; }
+    /*!
+     * Charge the data read without limiter, the debt is paid by later tokens.
+     */
+    void consume(qint64 bytes);
+
+private Q_SLOTS:
+    /*!
+     * Refill tokens and share them to the pending downloads.
+     */
+    void updateTokens();
+
+private:
+    /*!
+     * Object contsructor.
+     */
+    MusicDownLoadLimiter();
+
+    /*!
+     * Update the speed limit rate from settings.
+     */
+    void updateRate();
+    /*!
+     * Get the reply read buffer size of current rate.
+     */
+    qint64 readBufferSize() const;
+
+    qint64 m_rate, m_tokens;
+    QTimer m_timer;
+    QElapsedTimer m_clock;
+    QList<MusicAbstractDownLoadRequest*> m_requests;
+
+    DECLARE_SINGLETON_CLASS(MusicDownLoadLimiter)
+};
+
+#define M_DOWNLOAD_LIMITER_PTR GetMusicDownLoadLimiter()
+MUSIC_NETWORK_EXPORT MusicDownLoadLimiter* GetMusicDownLoadLimiter();
+
+#endif // MUSICDOWNLOADLIMITER_H
@@ -1,6 +1,8 @@
 #include "musicdownloadqueuerequest.h"
+#include "musicnumberutils.h"
 
 #include <QStringList>
+#include <algorithm>
 
 MusicDownloadQueueRequest::MusicDownloadQueueRequest(MusicObject::DownloadType  type, QObject *parent)
     : MusicDownloadQueueRequest(MusicDownloadQueueData(), type, parent)
@@ -12,13 +14,13 @@ MusicDownloadQueueRequest::MusicDownloadQueueRequest(const MusicDownloadQueueDat
     : MusicAbstractDownLoadRequest(data.m_url, data.m_savePath, type, parent)
 {
     m_request = nullptr;
-    m_isDownload = false;
-    m_isAbort = false;
+    m_maxCount = DOWNLOAD_QUEUE_COUNT;
+    m_receivedBytes = 0;
 
-    m_manager = new QNetworkAccessManager(this);
+    m_manager = M_NETWORK_SESSION_PTR->manager();
     m_request = new QNetworkRequest();
 #ifndef QT_NO_SSL
-    connect(m_manager, SIGNAL(sslErrors(QNetworkReply*,QList<QSslError>)), SLOT(sslErrors(QNetworkReply*,QList<QSslError>)));
+    connect(m_manager, SIGNAL(sslErrors(QNetworkReply*,QList<QSslError>)), SLOT(sslErrors(QNetworkReply*,QList<QSslError>)), Qt::UniqueConnection);
     MusicObject::setSslConfiguration(m_request);
 #endif
 
@@ -32,6 +34,7 @@ MusicDownloadQueueRequest::MusicDownloadQueueRequest(const MusicDownloadQueueDat
 
 MusicDownloadQueueRequest::~MusicDownloadQueueRequest()
 {
+    abort();
     if(m_request)
     {
         delete m_request;
@@ -42,23 +45,14 @@ MusicDownloadQueueRequest::~MusicDownloadQueueRequest()
 
 void MusicDownloadQueueRequest::startToDownload()
 {
-    if(!m_imageQueue.isEmpty())
-    {
-        startOrderImageQueue();
-    }
+    startOrderImageQueue();
 }
 
 void MusicDownloadQueueRequest::abort()
 {
-    if(m_isDownload && m_reply)
+    foreach(QNetworkReply *reply, m_tasks.keys())
     {
-        m_isAbort = true;
-        m_reply->abort();
-        m_file->close();
-        m_file->remove();
-        delete m_reply;
-        m_reply = nullptr;
-        m_isAbort = false;
+        abortReply(reply);
     }
 }
 
@@ -67,98 +61,206 @@ void MusicDownloadQueueRequest::clear()
     m_imageQueue.clear();
 }
 
+int MusicDownloadQueueRequest::queueDepth() const
+{
+    return m_imageQueue.count() + m_tasks.count();
+}
+
+qint64 MusicDownloadQueueRequest::throughput() const
+{
+    const qint64 elapsed = m_elapsedTimer.isValid() ? m_elapsedTimer.elapsed() : 0;
+    return elapsed > 0 ? m_receivedBytes * MT_S2MS / elapsed : 0;
+}
+
 void MusicDownloadQueueRequest::addImageQueue(const MusicDownloadQueueDatas &datas)
 {
     m_imageQueue = datas;
+    std::stable_sort(m_imageQueue.begin(), m_imageQueue.end(), [](const MusicDownloadQueueData &a, const MusicDownloadQueueData &b)
+    {
+        return a.m_priority > b.m_priority;
+    });
+
+    m_receivedBytes = 0;
+    m_elapsedTimer.start();
 }
 
-void MusicDownloadQueueRequest::startOrderImageQueue()
+void MusicDownloadQueueRequest::setMaxCount(int count)
 {
-    if(!m_imageQueue.isEmpty() && M_NETWORK_PTR->isOnline())
+    m_maxCount = qMax(1, count);
+    startOrderImageQueue();
+}
+
+void MusicDownloadQueueRequest::setPriority(const MusicDownloadQueueData &data)
+{
+    foreach(const MusicDownloadQueueTask &task, m_tasks)
     {
-        if(QFile::exists(m_imageQueue.first().m_savePath))
+        if(task.m_paths.contains(data.m_savePath))
         {
-            Q_EMIT downLoadDataChanged(m_imageQueue.takeFirst().m_savePath);
-            startOrderImageQueue();
+            return;
         }
-        else
+    }
+
+    for(int i=0; i<m_imageQueue.count(); ++i)
+    {
+        if(m_imageQueue[i].m_savePath == data.m_savePath)
         {
-            startDownload(m_imageQueue.first().m_url);
+            m_imageQueue.removeAt(i);
+            break;
         }
     }
+
+    ///insert before the first lower one, keep the order of same priority
+    int index = 0;
+    while(index < m_imageQueue.count() && m_imageQueue[index].m_priority >= data.m_priority)
+    {
+        ++index;
+    }
+    m_imageQueue.insert(index, data);
 }
 
-void MusicDownloadQueueRequest::startDownload(const QString &url)
+void MusicDownloadQueueRequest::cancel(const QString &savePath)
 {
-    m_isDownload = true;
-    delete m_file;
-    m_file = new QFile(m_imageQueue.first().m_savePath, this);
-    if(!m_file->open(QFile::WriteOnly))
+    for(int i=m_imageQueue.count() - 1; i>=0; --i)
     {
-        m_file->close();
-        delete m_file;
-        m_file = nullptr;
-        return;
+        if(m_imageQueue[i].m_savePath == savePath)
+        {
+            m_imageQueue.removeAt(i);
+        }
     }
 
-    if(!m_request || !m_manager)
+    ///the running request goes on while other paths still wait for it
+    foreach(QNetworkReply *reply, m_tasks.keys())
+    {
+        MusicDownloadQueueTask &task = m_tasks[reply];
+        task.m_paths.removeAll(savePath);
+        if(task.m_paths.isEmpty())
+        {
+            abortReply(reply);
+        }
+    }
+    startOrderImageQueue();
+}
+
+void MusicDownloadQueueRequest::startOrderImageQueue()
+{
+    if(!M_NETWORK_PTR->isOnline())
     {
         return;
     }
 
-    m_speedTimer.start();
-    m_request->setUrl(QUrl(url));
-    m_reply = m_manager->get(*m_request);
-    connect(m_reply, SIGNAL(finished()), SLOT(downLoadFinished()));
-    connect(m_reply, SIGNAL(readyRead()), SLOT(readyReadSlot()));
-    connect(m_reply, SIGNAL(error(QNetworkReply::NetworkError)), SLOT(errorSlot(QNetworkReply::NetworkError)));
+    while(!m_imageQueue.isEmpty() && m_tasks.count() < m_maxCount)
+    {
+        const MusicDownloadQueueData &data = m_imageQueue.takeFirst();
+        if(QFile::exists(data.m_savePath))
+        {
+            Q_EMIT downLoadDataChanged(data.m_savePath);
+        }
+        else
+        {
+            startDownload(data);
+        }
+    }
 }
 
-void MusicDownloadQueueRequest::downLoadFinished()
+void MusicDownloadQueueRequest::startDownload(const MusicDownloadQueueData &data)
 {
-    if(m_isAbort || !m_request || !m_manager || !m_reply || !m_file)
+    ///the same url in flight, just wait for its data
+    for(QHash<QNetworkReply*, MusicDownloadQueueTask>::iterator it = m_tasks.begin(); it != m_tasks.end(); ++it)
+    {
+        if(it->m_url == data.m_url)
+        {
+            if(!it->m_paths.contains(data.m_savePath))
+            {
+                it->m_paths << data.m_savePath;
+            }
+            return;
+        }
+    }
+
+    if(!m_request || !m_manager)
     {
         return;
     }
-    m_speedTimer.stop();
 
-    m_file->flush();
-    m_file->close();
-    m_reply->deleteLater();
-    m_reply = nullptr;
-    m_isDownload = false;
-    Q_EMIT downLoadDataChanged(m_imageQueue.takeFirst().m_savePath);
+    m_request->setUrl(QUrl(data.m_url));
+    QNetworkReply *reply = m_manager->get(*m_request);
+    connect(reply, SIGNAL(finished()), SLOT(downLoadFinished()));
+    connect(reply, SIGNAL(readyRead()), SLOT(readyReadSlot()));
 
-    startOrderImageQueue();
+    MusicDownloadQueueTask task;
+    task.m_url = data.m_url;
+    task.m_paths << data.m_savePath;
+    m_tasks.insert(reply, task);
 }
 
-void MusicDownloadQueueRequest::readyReadSlot()
+void MusicDownloadQueueRequest::abortReply(QNetworkReply *reply)
 {
-    if(!m_file || !m_reply)
+    m_tasks.remove(reply);
+    disconnect(reply, nullptr, this, nullptr);
+    reply->abort();
+    reply->deleteLater();
+}
+
+void MusicDownloadQueueRequest::downLoadFinished()
+{
+    QNetworkReply *reply = TTKObject_cast(QNetworkReply*, sender());
+    if(!reply || !m_tasks.contains(reply))
     {
         return;
     }
 
-    m_file->write(m_reply->readAll());
-    m_file->flush();
+    MusicDownloadQueueTask task = m_tasks.take(reply);
+    reply->deleteLater();
+
+    if(reply->error() != QNetworkReply::NoError)
+    {
+        TTK_LOGGER_ERROR(QString("QNetworkReply::NetworkError : %1 %2").arg(reply->error()).arg(reply->errorString()));
+    }
+    else
+    {
+        const QByteArray &bytes = reply->readAll();
+        m_receivedBytes += bytes.size();
+        task.m_buffer.append(bytes);
+
+        ///the queued items of the same url share the data
+        for(int i=m_imageQueue.count() - 1; i>=0; --i)
+        {
+            if(m_imageQueue[i].m_url == task.m_url && !task.m_paths.contains(m_imageQueue[i].m_savePath))
+            {
+                task.m_paths << m_imageQueue.takeAt(i).m_savePath;
+            }
+        }
+
+        ///write the whole data once instead of every chunk
+        foreach(const QString &path, task.m_paths)
+        {
+            QFile file(path);
+            if(file.open(QFile::WriteOnly))
+            {
+                file.write(task.m_buffer);
+                file.close();
+                Q_EMIT downLoadDataChanged(path);
+            }
+        }
+    }
+
+    startOrderImageQueue();
+    if(m_tasks.isEmpty() && m_imageQueue.isEmpty())
+    {
+        TTK_LOGGER_INFO(QString("image queue finished, %1 received at %2").arg(MusicUtils::Number::size2Label(m_receivedBytes))
+                        .arg(MusicUtils::Number::speed2Label(throughput())));
+    }
 }
 
-void MusicDownloadQueueRequest::errorSlot(QNetworkReply::NetworkError code)
+void MusicDownloadQueueRequest::readyReadSlot()
 {
-    if(!m_file || !m_reply)
+    QNetworkReply *reply = TTKObject_cast(QNetworkReply*, sender());
+    if(!reply || !m_tasks.contains(reply))
     {
         return;
     }
-#ifndef TTK_DEBUG
-    Q_UNUSED(code);
-#endif
-    TTK_LOGGER_ERROR(QString("QNetworkReply::NetworkError : %1 %2").arg(code).arg(m_reply->errorString()));
-    m_file->flush();
-    if(!m_isAbort)
-    {
-        m_reply->deleteLater();
-        m_reply = nullptr;
-    }
 
-    startToDownload();
+    const QByteArray &bytes = reply->readAll();
+    m_receivedBytes += bytes.size();
+    m_tasks[reply].m_buffer.append(bytes);
 }
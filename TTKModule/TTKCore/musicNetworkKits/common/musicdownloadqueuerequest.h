@@ -19,8 +19,12 @@
  * with this program; If not, see <http://www.gnu.org/licenses/>.
  ================================================= */
 
+#include <QStringList>
+#include <QElapsedTimer>
 #include "musicabstractdownloadrequest.h"
 
+#define DOWNLOAD_QUEUE_COUNT    4   // default parallel download count
+
 /*! @brief The class of the download queue data.
  * @author Greedysky <greedysky@163.com>
  */
@@ -28,9 +32,25 @@ typedef struct MUSIC_NETWORK_EXPORT MusicDownloadQueueData
 {
     QString m_url;        ///*download url*/
     QString m_savePath;   ///*save local path*/
+    int m_priority;       ///*download priority, higher first*/
+
+    MusicDownloadQueueData()
+    {
+        m_priority = 0;
+    }
 }MusicDownloadQueueData;
 TTK_DECLARE_LISTS(MusicDownloadQueueData)
 
+/*! @brief The class of the download queue task in flight.
+ * @author Greedysky <greedysky@163.com>
+ */
+typedef struct MUSIC_NETWORK_EXPORT MusicDownloadQueueTask
+{
+    QString m_url;          ///*download url*/
+    QStringList m_paths;    ///*save local paths share the url*/
+    QByteArray m_buffer;    ///*received data*/
+}MusicDownloadQueueTask;
+
 /*! @brief The class to download data from queue request.
  * @author Greedysky <greedysky@163.com>
  */
@@ -61,6 +81,19 @@ public:
      * Add image download url and save path to download queue.
      */
     void addImageQueue(const MusicDownloadQueueDatas &datas);
+    /*!
+     * Set the max parallel download count.
+     */
+    void setMaxCount(int count);
+    /*!
+     * Queue data by its priority, such as the visible items, the queued one of the same save path moves.
+     * Nothing changes while it is downloading.
+     */
+    void setPriority(const MusicDownloadQueueData &data);
+    /*!
+     * Cancel the download of save path, such as the items off screen.
+     */
+    void cancel(const QString &savePath);
     /*!
      * Start to download data.
      */
@@ -74,6 +107,15 @@ public:
      */
     void clear();
 
+    /*!
+     * Get the count of queued and running downloads.
+     */
+    int queueDepth() const;
+    /*!
+     * Get the average download throughput in bytes per second.
+     */
+    qint64 throughput() const;
+
 public Q_SLOTS:
     /*!
      * Download data from net finished.
@@ -83,23 +125,26 @@ public Q_SLOTS:
      * Download received data ready.
      */
     void readyReadSlot();
-    /*!
-     * Download reply error.
-     */
-    void errorSlot(QNetworkReply::NetworkError code);
 
 protected:
     /*!
      * Start to download data from url.
      */
-    void startDownload(const QString &url);
+    void startDownload(const MusicDownloadQueueData &data);
     /*!
      * Start to download data in order.
      */
     void startOrderImageQueue();
+    /*!
+     * Abort the download reply and drop its task.
+     */
+    void abortReply(QNetworkReply *reply);
 
-    bool m_isDownload, m_isAbort;
+    int m_maxCount;
+    qint64 m_receivedBytes;
+    QElapsedTimer m_elapsedTimer;
     QList<MusicDownloadQueueData> m_imageQueue;
+    QHash<QNetworkReply*, MusicDownloadQueueTask> m_tasks;
     QNetworkRequest *m_request;
 
 };
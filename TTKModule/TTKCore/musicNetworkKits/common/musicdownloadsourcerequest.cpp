@@ -13,12 +13,12 @@ MusicDownloadSourceRequest::~MusicDownloadSourceRequest()
 
 void MusicDownloadSourceRequest::startToDownload(const QString &url)
 {
-    m_manager = new QNetworkAccessManager(this);
+    m_manager = M_NETWORK_SESSION_PTR->manager();
 
     QNetworkRequest request;
     request.setUrl(url);
 #ifndef QT_NO_SSL
-    connect(m_manager, SIGNAL(sslErrors(QNetworkReply*,QList<QSslError>)), SLOT(sslErrors(QNetworkReply*,QList<QSslError>)));
+    connect(m_manager, SIGNAL(sslErrors(QNetworkReply*,QList<QSslError>)), SLOT(sslErrors(QNetworkReply*,QList<QSslError>)), Qt::UniqueConnection);
     MusicObject::setSslConfiguration(&request);
 #endif
 
@@ -60,6 +60,11 @@ void MusicDownloadSourceRequest::replyError(QNetworkReply::NetworkError)
 #ifndef QT_NO_SSL
 void MusicDownloadSourceRequest::sslErrors(QNetworkReply* reply, const QList<QSslError> &errors)
 {
+    if(!m_reply || reply != m_reply)
+    {
+        return;
+    }
+
     sslErrorsString(reply, errors);
     Q_EMIT downLoadRawDataChanged(QByteArray());
     deleteAll();
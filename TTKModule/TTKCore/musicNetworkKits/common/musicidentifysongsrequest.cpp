@@ -14,9 +14,9 @@
 MusicIdentifySongsRequest::MusicIdentifySongsRequest(QObject *parent)
     : MusicAbstractNetwork(parent)
 {
-    m_manager = new QNetworkAccessManager(this);
+    m_manager = M_NETWORK_SESSION_PTR->manager();
 #ifndef QT_NO_SSL
-    connect(m_manager, SIGNAL(sslErrors(QNetworkReply*,QList<QSslError>)), SLOT(sslErrors(QNetworkReply*,QList<QSslError>)));
+    connect(m_manager, SIGNAL(sslErrors(QNetworkReply*,QList<QSslError>)), SLOT(sslErrors(QNetworkReply*,QList<QSslError>)), Qt::UniqueConnection);
 #endif
 }
 
@@ -0,0 +1,140 @@
+#include "musicnetworksession.h"
+
+#include <QTimer>
+#include <QThread>
+#include <QThreadStorage>
+#include <QCoreApplication>
+#include <QNetworkAccessManager>
+
+/*! @brief The class of the shared network access manager.
+ * @author Greedysky <greedysky@163.com>
+ */
+class MusicNetworkAccessManager : public QNetworkAccessManager
+{
+public:
+    MusicNetworkAccessManager()
+        : QNetworkAccessManager(nullptr)
+    {
+
+    }
+
+protected:
+    virtual QNetworkReply *createRequest(Operation op, const QNetworkRequest &request, QIODevice *outgoingData) override
+    {
+        QNetworkRequest req(request);
+#if TTK_QT_VERSION_CHECK(5,15,0)
+        if(!req.attribute(QNetworkRequest::Http2AllowedAttribute).isValid())
+        {
+            req.setAttribute(QNetworkRequest::Http2AllowedAttribute, true);
+        }
+#elif TTK_QT_VERSION_CHECK(5,8,0)
+        if(!req.attribute(QNetworkRequest::HTTP2AllowedAttribute).isValid())
+        {
+            req.setAttribute(QNetworkRequest::HTTP2AllowedAttribute, true);
+        }
+#endif
+        QNetworkReply *reply = QNetworkAccessManager::createRequest(op, req, outgoingData);
+        new MusicNetworkTrace(reply);
+        return reply;
+    }
+
+};
+
+
+MusicNetworkTrace::MusicNetworkTrace(QNetworkReply *reply)
+    : QObject(reply)
+{
+    m_reply = reply;
+    m_timer.start();
+
+#if !defined(QT_NO_SSL) && TTK_QT_VERSION_CHECK(5,1,0)
+    connect(m_reply, SIGNAL(encrypted()), SLOT(encrypted()));
+#endif
+    connect(m_reply, SIGNAL(metaDataChanged()), SLOT(metaDataChanged()));
+    connect(m_reply, SIGNAL(finished()), SLOT(finished()));
+}
+
+void MusicNetworkTrace::encrypted()
+{
+    if(m_timing.m_connect < 0)
+    {
+        m_timing.m_connect = m_timer.elapsed();
+    }
+}
+
+void MusicNetworkTrace::metaDataChanged()
+{
+    if(m_timing.m_response <= 0)
+    {
+        m_timing.m_response = m_timer.elapsed();
+    }
+}
+
+void MusicNetworkTrace::finished()
+{
+    const qint64 total = m_timer.elapsed();
+    if(m_timing.m_response <= 0)
+    {
+        m_timing.m_response = total;
+    }
+    m_timing.m_transfer = total - m_timing.m_response;
+    m_timing.m_count = 1;
+    m_timing.m_connectCount = m_timing.m_connect >= 0 ? 1 : 0;
+
+    M_NETWORK_SESSION_PTR->record(m_reply->url().host(), m_timing);
+
+    ///replies belong to the shared manager now, release the ones nobody deleted
+    if(m_reply->thread() == qApp->thread())
+    {
+        QTimer::singleShot(NETWORK_REPLY_RELEASE, m_reply, SLOT(deleteLater()));
+    }
+}
+
+
+MusicNetworkSession::MusicNetworkSession()
+    : QObject(nullptr)
+{
+
+}
+
+QNetworkAccessManager *MusicNetworkSession::manager()
+{
+    static QThreadStorage<QNetworkAccessManager*> managers;
+    if(!managers.hasLocalData())
+    {
+        managers.setLocalData(new MusicNetworkAccessManager);
+    }
+    return managers.localData();
+}
+
+void MusicNetworkSession::record(const QString &host, const MusicNetworkTiming &timing)
+{
+    QMutexLocker locker(&m_mutex);
+    MusicNetworkTiming &total = m_timings[host];
+    if(timing.m_connect >= 0)
+    {
+        total.m_connect = qMax(TTKStatic_cast(qint64, 0), total.m_connect) + timing.m_connect;
+        total.m_connectCount += timing.m_connectCount;
+    }
+    total.m_response += timing.m_response;
+    total.m_transfer += timing.m_transfer;
+    total.m_count += timing.m_count;
+}
+
+MusicNetworkTiming MusicNetworkSession::timing(const QString &host)
+{
+    QMutexLocker locker(&m_mutex);
+    MusicNetworkTiming timing = m_timings.value(host);
+    ///only tls requests have a connect time, average it over them alone
+    if(timing.m_connectCount > 0)
+    {
+        timing.m_connect /= timing.m_connectCount;
+    }
+
+    if(timing.m_count > 0)
+    {
+        timing.m_response /= timing.m_count;
+        timing.m_transfer /= timing.m_count;
+    }
+    return timing;
+}
@@ -0,0 +1,122 @@
+#ifndef MUSICNETWORKSESSION_H
+#define MUSICNETWORKSESSION_H
+
+/* =================================================
+ * This file is part of the TTK Music Player project
+ * Copyright (C) 2015 - 2020 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ================================================= */
+
+#include <QMutex>
+#include <QNetworkReply>
+#include <QElapsedTimer>
+#include "musicsingleton.h"
+
+#define NETWORK_REPLY_RELEASE       (60 * MT_S2MS)   // finished reply release delay
+
+/*! @brief The class of the network request timing.
+ * @author Greedysky <greedysky@163.com>
+ */
+typedef struct MUSIC_NETWORK_EXPORT MusicNetworkTiming
+{
+    int m_count;            /*!< request count*/
+    int m_connectCount;     /*!< tls request count*/
+    qint64 m_connect;       /*!< dns\ connect\ tls handshake time, -1 means not a tls request*/
+    qint64 m_response;      /*!< time to first response byte*/
+    qint64 m_transfer;      /*!< body transfer time*/
+
+    MusicNetworkTiming()
+    {
+        m_count = 0;
+        m_connectCount = 0;
+        m_connect = -1;
+        m_response = 0;
+        m_transfer = 0;
+    }
+}MusicNetworkTiming;
+
+/*! @brief The class of the network reply timing trace.
+ * @author Greedysky <greedysky@163.com>
+ */
+class MUSIC_NETWORK_EXPORT MusicNetworkTrace : public QObject
+{
+    Q_OBJECT
+    TTK_DECLARE_MODULE(MusicNetworkTrace)
+public:
+    /*!
+     * Object contsructor.
+     */
+    explicit MusicNetworkTrace(QNetworkReply *reply);
+
+private Q_SLOTS:
+    /*!
+     * Reply tls handshake finished.
+     */
+    void encrypted();
+    /*!
+     * Reply response header arrived.
+     */
+    void metaDataChanged();
+    /*!
+     * Reply finished.
+     */
+    void finished();
+
+private:
+    QNetworkReply *m_reply;
+    QElapsedTimer m_timer;
+    MusicNetworkTiming m_timing;
+
+};
+
+/*! @brief The class of the shared network session.
+ * @author Greedysky <greedysky@163.com>
+ */
+class MUSIC_NETWORK_EXPORT MusicNetworkSession : public QObject
+{
+    Q_OBJECT
+    TTK_DECLARE_MODULE(MusicNetworkSession)
+public:
+    /*!
+     * Get the shared network manager of the calling thread.
+     * Requests to the same host reuse the alive connections, at most six per host.
+     */
+    QNetworkAccessManager *manager();
+
+    /*!
+     * Record the request timing of host.
+     */
+    void record(const QString &host, const MusicNetworkTiming &timing);
+    /*!
+     * Get the average request timing of host.
+     */
+    MusicNetworkTiming timing(const QString &host);
+
+private:
+    /*!
+     * Object contsructor.
+     */
+    MusicNetworkSession();
+
+    QMutex m_mutex;
+    QMap<QString, MusicNetworkTiming> m_timings;
+
+    DECLARE_SINGLETON_CLASS(MusicNetworkSession)
+};
+
+#define M_NETWORK_SESSION_PTR GetMusicNetworkSession()
+MUSIC_NETWORK_EXPORT MusicNetworkSession* GetMusicNetworkSession();
+
+#endif // MUSICNETWORKSESSION_H
@@ -36,7 +36,7 @@ void MusicNetworkThread::networkStateChanged()
 {
     QtConcurrent::run([&]
     {
-        const bool block = M_SETTING_PTR->value(MusicSettingManager::CloseNetWork).toBool();
+        const bool block = M_SETTING_PTR->boolValue(MusicSettingManager::CloseNetWork);
         const QHostInfo &info = QHostInfo::fromName(NETWORK_REQUEST_ADDRESS);
         m_networkState = !info.addresses().isEmpty();
         m_networkState = block ? false : m_networkState;
@@ -1,6 +1,5 @@
 #include "musicbdqueryinterface.h"
 #include "musicnumberutils.h"
-#include "musicsemaphoreloop.h"
 #include "musicalgorithmutils.h"
 #include "musicurlutils.h"
 #include "musicabstractnetwork.h"
@@ -10,7 +9,6 @@
 #include <QNetworkReply>
 #include <QNetworkRequest>
 #include <QSslConfiguration>
-#include <QNetworkAccessManager>
 
 void MusicBDQueryInterface::makeTokenQueryUrl(QNetworkRequest *request, const QString &id)
 {
@@ -29,21 +27,15 @@ void MusicBDQueryInterface::readFromMusicSongAttribute(MusicObject::MusicSongInf
     QNetworkRequest request;
     makeTokenQueryUrl(&request, info->m_songId);
 
-    QNetworkAccessManager manager;
-    MusicSemaphoreLoop loop;
-    QNetworkReply *reply = manager.get(request);
-    QObject::connect(reply, SIGNAL(finished()), &loop, SLOT(quit()));
-    QObject::connect(reply, SIGNAL(error(QNetworkReply::NetworkError)), &loop, SLOT(quit()));
-    loop.exec();
-
-    if(!reply || reply->error() != QNetworkReply::NoError)
+    const QByteArray &bytes = MusicObject::syncNetworkQueryForGet(request);
+    if(bytes.isEmpty())
     {
         return;
     }
 
     QJson::Parser parser;
     bool ok;
-    const QVariant &data = parser.parse(reply->readAll(), &ok);
+    const QVariant &data = parser.parse(bytes, &ok);
     if(ok)
     {
         QVariantMap value = data.toMap();
@@ -147,21 +139,15 @@ void MusicBDQueryInterface::readFromMusicLLAttribute(MusicObject::MusicSongInfor
     request.setRawHeader("User-Agent", MusicUtils::Algorithm::mdII(BD_UA_URL, ALG_UA_KEY, false).toUtf8());
     MusicObject::setSslConfiguration(&request);
 
-    QNetworkAccessManager manager;
-    MusicSemaphoreLoop loop;
-    QNetworkReply *reply = manager.get(request);
-    QObject::connect(reply, SIGNAL(finished()), &loop, SLOT(quit()));
-    QObject::connect(reply, SIGNAL(error(QNetworkReply::NetworkError)), &loop, SLOT(quit()));
-    loop.exec();
-
-    if(!reply || reply->error() != QNetworkReply::NoError)
+    const QByteArray &bytes = MusicObject::syncNetworkQueryForGet(request);
+    if(bytes.isEmpty())
     {
         return;
     }
 
     QJson::Parser parser;
     bool ok;
-    const QVariant &data = parser.parse(reply->readAll(), &ok);
+    const QVariant &data = parser.parse(bytes, &ok);
     if(ok)
     {
         QVariantMap value = data.toMap();
@@ -208,21 +194,15 @@ void MusicBDQueryInterface::readFromMusicPayAttribute(MusicObject::MusicSongInfo
     request.setRawHeader("User-Agent", MusicUtils::Algorithm::mdII(BD_UA_URL, ALG_UA_KEY, false).toUtf8());
     MusicObject::setSslConfiguration(&request);
 
-    QNetworkAccessManager manager;
-    MusicSemaphoreLoop loop;
-    QNetworkReply *reply = manager.get(request);
-    QObject::connect(reply, SIGNAL(finished()), &loop, SLOT(quit()));
-    QObject::connect(reply, SIGNAL(error(QNetworkReply::NetworkError)), &loop, SLOT(quit()));
-    loop.exec();
-
-    if(!reply || reply->error() != QNetworkReply::NoError)
+    const QByteArray &bytes = MusicObject::syncNetworkQueryForGet(request);
+    if(bytes.isEmpty())
     {
         return;
     }
 
     QJson::Parser parser;
     bool ok;
-    const QVariant &data = parser.parse(reply->readAll(), &ok);
+    const QVariant &data = parser.parse(bytes, &ok);
     if(ok)
     {
         QVariantMap value = data.toMap();
@@ -78,6 +78,8 @@ void MusicBDQueryRequest::downLoadFinished()
     TTK_LOGGER_INFO(QString("%1 downLoadFinished").arg(getClassName()));
     m_interrupt = false;
 
+    MusicResolveItems items;
+
     if(m_reply->error() == QNetworkReply::NoError)
     {
         const QByteArray &bytes = m_reply->readAll();
@@ -120,32 +122,18 @@ void MusicBDQueryRequest::downLoadFinished()
                         musicInfo.m_lrcUrl = value["lrclink"].toString();
                         musicInfo.m_smallPicUrl = value["pic_small"].toString().replace("_90", "_500");
                         musicInfo.m_albumName = MusicUtils::String::illegalCharactersReplaced(value["album_title"].toString());
-
-                        if(m_interrupt || !m_manager || m_stateCode != MusicObject::NetworkQuery) return;
-                        readFromMusicSongAttribute(&musicInfo, value["all_rate"].toString(), m_searchQuality, m_queryAllRecords);
-                        if(m_interrupt || !m_manager || m_stateCode != MusicObject::NetworkQuery) return;
-
-                        if(musicInfo.m_songAttrs.isEmpty())
-                        {
-                            continue;
-                        }
-
-                        musicInfo.m_timeLength = findTimeStringByAttrs(musicInfo.m_songAttrs);
-                        MusicSearchedItem item;
-                        item.m_songName = musicInfo.m_songName;
-                        item.m_singerName = musicInfo.m_singerName;
-                        item.m_albumName = musicInfo.m_albumName;
-                        item.m_time = musicInfo.m_timeLength;
-                        item.m_type = mapQueryServerString();
-                        Q_EMIT createSearchedItem(item);
                     }
-                    m_musicSongInfos << musicInfo;
+
+                    MusicResolveItem item;
+                    item.m_info = musicInfo;
+                    item.m_key = value;
+                    items << item;
                 }
             }
         }
     }
 
-    Q_EMIT downLoadDataChanged(QString());
+    startToResolve(items, m_querySimplify ? nullptr : resolveSongInformation);
     deleteAll();
 }
 
@@ -212,3 +200,12 @@ void MusicBDQueryRequest::singleDownLoadFinished()
     Q_EMIT downLoadDataChanged(QString());
     deleteAll();
 }
+
+void MusicBDQueryRequest::resolveSongInformation(MusicObject::MusicSongInformation *info, const QVariantMap &key, const QString &quality, bool all)
+{
+    MusicBDQueryInterface().readFromMusicSongAttribute(info, key["all_rate"].toString(), quality, all);
+    if(!info->m_songAttrs.isEmpty())
+    {
+        info->m_timeLength = findTimeStringByAttrs(info->m_songAttrs);
+    }
+}
@@ -1,13 +1,11 @@
 #include "musickgqueryinterface.h"
 #include "musicnumberutils.h"
-#include "musicsemaphoreloop.h"
 #include "musicalgorithmutils.h"
 #include "musickgqueryrequest.h"
 
 #include <QNetworkReply>
 #include <QNetworkRequest>
 #include <QSslConfiguration>
-#include <QNetworkAccessManager>
 
 void MusicKGQueryInterface::readFromMusicSongAttribute(MusicObject::MusicSongInformation *info, const QString &hash)
 {
@@ -24,21 +22,15 @@ void MusicKGQueryInterface::readFromMusicSongAttribute(MusicObject::MusicSongInf
     request.setRawHeader("User-Agent", MusicUtils::Algorithm::mdII(KG_UA_URL, ALG_UA_KEY, false).toUtf8());
     MusicObject::setSslConfiguration(&request);
 
-    QNetworkAccessManager manager;
-    MusicSemaphoreLoop loop;
-    QNetworkReply *reply = manager.get(request);
-    QObject::connect(reply, SIGNAL(finished()), &loop, SLOT(quit()));
-    QObject::connect(reply, SIGNAL(error(QNetworkReply::NetworkError)), &loop, SLOT(quit()));
-    loop.exec();
-
-    if(!reply || reply->error() != QNetworkReply::NoError)
+    const QByteArray &bytes = MusicObject::syncNetworkQueryForGet(request);
+    if(bytes.isEmpty())
     {
         return;
     }
 
     QJson::Parser parser;
     bool ok;
-    const QVariant &data = parser.parse(reply->readAll(), &ok);
+    const QVariant &data = parser.parse(bytes, &ok);
     if(ok)
     {
         const QVariantMap &value = data.toMap();
@@ -101,21 +93,15 @@ void MusicKGQueryInterface::readFromMusicSongLrcAndPic(MusicObject::MusicSongInf
     request.setRawHeader("User-Agent", MusicUtils::Algorithm::mdII(KG_UA_URL, ALG_UA_KEY, false).toUtf8());
     MusicObject::setSslConfiguration(&request);
 
-    QNetworkAccessManager manager;
-    MusicSemaphoreLoop loop;
-    QNetworkReply *reply = manager.get(request);
-    QObject::connect(reply, SIGNAL(finished()), &loop, SLOT(quit()));
-    QObject::connect(reply, SIGNAL(error(QNetworkReply::NetworkError)), &loop, SLOT(quit()));
-    loop.exec();
-
-    if(!reply || reply->error() != QNetworkReply::NoError)
+    const QByteArray &bytes = MusicObject::syncNetworkQueryForGet(request);
+    if(bytes.isEmpty())
     {
         return;
     }
 
     QJson::Parser parser;
     bool ok;
-    const QVariant &data = parser.parse(reply->readAll(), &ok);
+    const QVariant &data = parser.parse(bytes, &ok);
     if(ok)
     {
         QVariantMap value = data.toMap();
@@ -140,21 +126,15 @@ void MusicKGQueryInterface::readFromMusicSongAlbumInfo(MusicResultsItem *info, c
     request.setRawHeader("User-Agent", MusicUtils::Algorithm::mdII(KG_UA_URL, ALG_UA_KEY, false).toUtf8());
     MusicObject::setSslConfiguration(&request);
 
-    QNetworkAccessManager manager;
-    MusicSemaphoreLoop loop;
-    QNetworkReply *reply = manager.get(request);
-    QObject::connect(reply, SIGNAL(finished()), &loop, SLOT(quit()));
-    QObject::connect(reply, SIGNAL(error(QNetworkReply::NetworkError)), &loop, SLOT(quit()));
-    loop.exec();
-
-    if(!reply || reply->error() != QNetworkReply::NoError)
+    const QByteArray &bytes = MusicObject::syncNetworkQueryForGet(request);
+    if(bytes.isEmpty())
     {
         return;
     }
 
     QJson::Parser parser;
     bool ok;
-    const QVariant &data = parser.parse(reply->readAll(), &ok);
+    const QVariant &data = parser.parse(bytes, &ok);
     if(ok)
     {
         QVariantMap value = data.toMap();
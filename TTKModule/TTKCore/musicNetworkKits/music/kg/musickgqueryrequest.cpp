@@ -82,6 +82,8 @@ void MusicKGQueryRequest::downLoadFinished()
     TTK_LOGGER_INFO(QString("%1 downLoadFinished").arg(getClassName()));
     m_interrupt = false;
 
+    MusicResolveItems items;
+
     if(m_reply->error() == QNetworkReply::NoError)
     {
         const QByteArray &bytes = m_reply->readAll();
@@ -118,36 +120,16 @@ void MusicKGQueryRequest::downLoadFinished()
                     musicInfo.m_discNumber = "1";
                     musicInfo.m_trackNumber = "0";
 
-                    if(m_interrupt || !m_manager || m_stateCode != MusicObject::NetworkQuery) return;
-                    readFromMusicSongLrcAndPic(&musicInfo);
-                    if(m_interrupt || !m_manager || m_stateCode != MusicObject::NetworkQuery) return;
-
-                    if(!m_querySimplify)
-                    {
-                        if(m_interrupt || !m_manager || m_stateCode != MusicObject::NetworkQuery) return;
-                        readFromMusicSongAttribute(&musicInfo, value, m_searchQuality, m_queryAllRecords);
-                        if(m_interrupt || !m_manager || m_stateCode != MusicObject::NetworkQuery) return;
-
-                        if(musicInfo.m_songAttrs.isEmpty())
-                        {
-                            continue;
-                        }
-
-                        MusicSearchedItem item;
-                        item.m_songName = musicInfo.m_songName;
-                        item.m_singerName = musicInfo.m_singerName;
-                        item.m_albumName = musicInfo.m_albumName;
-                        item.m_time = musicInfo.m_timeLength;
-                        item.m_type = mapQueryServerString();
-                        Q_EMIT createSearchedItem(item);
-                    }
-                    m_musicSongInfos << musicInfo;
+                    MusicResolveItem item;
+                    item.m_info = musicInfo;
+                    item.m_key = value;
+                    items << item;
                 }
             }
         }
     }
 
-    Q_EMIT downLoadDataChanged(QString());
+    startToResolve(items, m_querySimplify ? resolveSongLrcAndPic : resolveSongInformation);
     deleteAll();
 }
 
@@ -222,3 +204,18 @@ void MusicKGQueryRequest::singleDownLoadFinished()
     Q_EMIT downLoadDataChanged(QString());
     deleteAll();
 }
+
+void MusicKGQueryRequest::resolveSongInformation(MusicObject::MusicSongInformation *info, const QVariantMap &key, const QString &quality, bool all)
+{
+    MusicKGQueryInterface query;
+    query.readFromMusicSongLrcAndPic(info);
+    query.readFromMusicSongAttribute(info, key, quality, all);
+}
+
+void MusicKGQueryRequest::resolveSongLrcAndPic(MusicObject::MusicSongInformation *info, const QVariantMap &key, const QString &quality, bool all)
+{
+    Q_UNUSED(key);
+    Q_UNUSED(quality);
+    Q_UNUSED(all);
+    MusicKGQueryInterface().readFromMusicSongLrcAndPic(info);
+}
@@ -60,6 +60,16 @@ public Q_SLOTS:
      */
     void singleDownLoadFinished();
 
+protected:
+    /*!
+     * Resolve song attributes of the query result in resolve thread.
+     */
+    static void resolveSongInformation(MusicObject::MusicSongInformation *info, const QVariantMap &key, const QString &quality, bool all);
+    /*!
+     * Resolve song lrc and pic of the query result in resolve thread.
+     */
+    static void resolveSongLrcAndPic(MusicObject::MusicSongInformation *info, const QVariantMap &key, const QString &quality, bool all);
+
 };
 
 #endif // MUSICKGQUERYREQUEST_H
@@ -1,6 +1,5 @@
 #include "musickwartistsimilarrequest.h"
 #include "musickwqueryinterface.h"
-#include "musicsemaphoreloop.h"
 
 MusicKWArtistSimilarRequest::MusicKWArtistSimilarRequest(QObject *parent)
     : MusicSimilarRequest(parent)
@@ -84,21 +83,15 @@ QString MusicKWArtistSimilarRequest::getArtistNameById(const QString &id)
     request.setRawHeader("User-Agent", MusicUtils::Algorithm::mdII(KW_UA_URL, ALG_UA_KEY, false).toUtf8());
     MusicObject::setSslConfiguration(&request);
 
-    QNetworkAccessManager manager;
-    MusicSemaphoreLoop loop;
-    QNetworkReply *reply = manager.get(request);
-    QObject::connect(reply, SIGNAL(finished()), &loop, SLOT(quit()));
-    QObject::connect(reply, SIGNAL(error(QNetworkReply::NetworkError)), &loop, SLOT(quit()));
-    loop.exec();
-
-    if(!reply || reply->error() != QNetworkReply::NoError)
+    QByteArray bytes = MusicObject::syncNetworkQueryForGet(request);
+    if(bytes.isEmpty())
     {
         return name;
     }
 
     QJson::Parser parser;
     bool ok;
-    const QVariant &data = parser.parse(reply->readAll().replace("'", "\""), &ok);
+    const QVariant &data = parser.parse(bytes.replace("'", "\""), &ok);
     if(ok)
     {
         const QVariantMap &value = data.toMap();
@@ -122,21 +115,15 @@ QString MusicKWArtistSimilarRequest::getArtistIdName(const QString &name)
     request.setRawHeader("User-Agent", MusicUtils::Algorithm::mdII(KW_UA_URL, ALG_UA_KEY, false).toUtf8());
     MusicObject::setSslConfiguration(&request);
 
-    QNetworkAccessManager manager;
-    MusicSemaphoreLoop loop;
-    QNetworkReply *reply = manager.get(request);
-    QObject::connect(reply, SIGNAL(finished()), &loop, SLOT(quit()));
-    QObject::connect(reply, SIGNAL(error(QNetworkReply::NetworkError)), &loop, SLOT(quit()));
-    loop.exec();
-
-    if(!reply || reply->error() != QNetworkReply::NoError)
+    QByteArray bytes = MusicObject::syncNetworkQueryForGet(request);
+    if(bytes.isEmpty())
     {
         return QString();
     }
 
     QJson::Parser parser;
     bool ok;
-    const QVariant &data = parser.parse(reply->readAll().replace("'", "\""), &ok);
+    const QVariant &data = parser.parse(bytes.replace("'", "\""), &ok);
 
     QString id;
     if(ok)
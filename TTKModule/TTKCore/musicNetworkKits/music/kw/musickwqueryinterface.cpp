@@ -1,6 +1,5 @@
 #include "musickwqueryinterface.h"
 #include "musicnumberutils.h"
-#include "musicsemaphoreloop.h"
 #include "musicalgorithmutils.h"
 #include "musicabstractnetwork.h"
 
@@ -9,7 +8,6 @@
 #include <QNetworkReply>
 #include <QNetworkRequest>
 #include <QSslConfiguration>
-#include <QNetworkAccessManager>
 
 void MusicKWQueryInterface::readFromMusicLLAttribute(MusicObject::MusicSongInformation *info, const QString &suffix, const QString &format, int bitrate)
 {
@@ -23,27 +21,15 @@ void MusicKWQueryInterface::readFromMusicLLAttribute(MusicObject::MusicSongInfor
                                               MusicUtils::Algorithm::mdII(_SIGN, ALG_UNIMP_KEY, false).toUtf8());
     const QUrl &musicUrl = MusicUtils::Algorithm::mdII(KW_MOVIE_URL, false).arg(QString(parameter));
 
-    QNetworkAccessManager manager;
     QNetworkRequest request;
     request.setUrl(musicUrl);
 //    request.setRawHeader("User-Agent", MusicUtils::Algorithm::mdII(KW_UA_URL, ALG_UA_KEY, false).toUtf8());
     MusicObject::setSslConfiguration(&request);
 
-    MusicSemaphoreLoop loop;
-    QNetworkReply *reply = manager.get(request);
-    QObject::connect(reply, SIGNAL(finished()), &loop, SLOT(quit()));
-    QObject::connect(reply, SIGNAL(error(QNetworkReply::NetworkError)), &loop, SLOT(quit()));
-    loop.exec();
-
-    if(!reply || reply->error() != QNetworkReply::NoError)
-    {
-        return;
-    }
-
-    QByteArray data = reply->readAll();
-    if(!data.isEmpty() && !data.contains("res not found"))
+    const QByteArray &bytes = MusicObject::syncNetworkQueryForGet(request);
+    if(!bytes.isEmpty() && !bytes.contains("res not found"))
     {
-        const QString text(data);
+        const QString text(bytes);
         QRegExp regx(".*url=(.*).*");
 
         if(text.indexOf(regx) != -1)
@@ -223,21 +209,15 @@ void MusicKWQueryInterface::readFromMusicSongPic(MusicObject::MusicSongInformati
     request.setRawHeader("User-Agent", MusicUtils::Algorithm::mdII(KW_UA_URL, ALG_UA_KEY, false).toUtf8());
     MusicObject::setSslConfiguration(&request);
 
-    QNetworkAccessManager manager;
-    MusicSemaphoreLoop loop;
-    QNetworkReply *reply = manager.get(request);
-    QObject::connect(reply, SIGNAL(finished()), &loop, SLOT(quit()));
-    QObject::connect(reply, SIGNAL(error(QNetworkReply::NetworkError)), &loop, SLOT(quit()));
-    loop.exec();
-
-    if(!reply || reply->error() != QNetworkReply::NoError)
+    const QByteArray &bytes = MusicObject::syncNetworkQueryForGet(request);
+    if(bytes.isEmpty())
     {
         return;
     }
 
     QJson::Parser parser;
     bool ok;
-    const QVariant &data = parser.parse(reply->readAll(), &ok);
+    const QVariant &data = parser.parse(bytes, &ok);
     if(ok)
     {
         QVariantMap value = data.toMap();
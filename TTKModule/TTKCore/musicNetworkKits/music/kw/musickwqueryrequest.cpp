@@ -142,6 +142,8 @@ void MusicKWQueryRequest::downLoadFinished()
     TTK_LOGGER_INFO(QString("%1 downLoadFinished").arg(getClassName()));
     m_interrupt = false;
 
+    MusicResolveItems items;
+
     if(m_reply->error() == QNetworkReply::NoError)
     {
         QByteArray bytes = m_reply->readAll();
@@ -181,38 +183,18 @@ void MusicKWQueryRequest::downLoadFinished()
                     if(!m_querySimplify)
                     {
                         musicInfo.m_albumName = MusicUtils::String::illegalCharactersReplaced(value["ALBUM"].toString());
-
-                        if(m_interrupt || !m_manager || m_stateCode != MusicObject::NetworkQuery) return;
-                        readFromMusicSongPic(&musicInfo);
-                        if(m_interrupt || !m_manager || m_stateCode != MusicObject::NetworkQuery) return;
-                        musicInfo.m_lrcUrl = MusicUtils::Algorithm::mdII(KW_SONG_LRC_URL, false).arg(musicInfo.m_songId);
-
-                        ///music normal songs urls
-                        readFromMusicSongAttribute(&musicInfo, value["FORMATS"].toString(), m_searchQuality, m_queryAllRecords);
-                        if(m_interrupt || !m_manager || m_stateCode != MusicObject::NetworkQuery) return;
-
-                        if(musicInfo.m_songAttrs.isEmpty())
-                        {
-                            continue;
-                        }
-                        //
-                        if(!findUrlFileSize(&musicInfo.m_songAttrs)) return;
-                        //
-                        MusicSearchedItem item;
-                        item.m_songName = musicInfo.m_songName;
-                        item.m_singerName = musicInfo.m_singerName;
-                        item.m_albumName = musicInfo.m_albumName;
-                        item.m_time = musicInfo.m_timeLength;
-                        item.m_type = mapQueryServerString();
-                        Q_EMIT createSearchedItem(item);
                     }
-                    m_musicSongInfos << musicInfo;
+
+                    MusicResolveItem item;
+                    item.m_info = musicInfo;
+                    item.m_key = value;
+                    items << item;
                 }
             }
         }
     }
 
-    Q_EMIT downLoadDataChanged(QString());
+    startToResolve(items, m_querySimplify ? nullptr : resolveSongInformation);
     deleteAll();
 }
 
@@ -264,3 +246,22 @@ void MusicKWQueryRequest::singleDownLoadFinished()
     Q_EMIT downLoadDataChanged(QString());
     deleteAll();
 }
+
+void MusicKWQueryRequest::resolveSongInformation(MusicObject::MusicSongInformation *info, const QVariantMap &key, const QString &quality, bool all)
+{
+    MusicKWQueryInterface query;
+    query.readFromMusicSongPic(info);
+    info->m_lrcUrl = MusicUtils::Algorithm::mdII(KW_SONG_LRC_URL, false).arg(info->m_songId);
+
+    ///music normal songs urls
+    query.readFromMusicSongAttribute(info, key["FORMATS"].toString(), quality, all);
+
+    for(int i=0; i<info->m_songAttrs.count(); ++i)
+    {
+        MusicObject::MusicSongAttribute *attr = &info->m_songAttrs[i];
+        if(attr->m_size.isEmpty() || attr->m_size == "-")
+        {
+            attr->m_size = MusicUtils::Number::size2Label(getUrlFileSize(attr->m_url));
+        }
+    }
+}
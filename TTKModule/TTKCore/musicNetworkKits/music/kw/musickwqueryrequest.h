@@ -82,6 +82,12 @@ public Q_SLOTS:
      */
     void singleDownLoadFinished();
 
+protected:
+    /*!
+     * Resolve song attributes of the query result in resolve thread.
+     */
+    static void resolveSongInformation(MusicObject::MusicSongInformation *info, const QVariantMap &key, const QString &quality, bool all);
+
 };
 
 #endif // MUSICKWQUERYREQUEST_H
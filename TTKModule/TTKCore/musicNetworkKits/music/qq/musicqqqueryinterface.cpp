@@ -1,13 +1,11 @@
 #include "musicqqqueryinterface.h"
 #include "musicnumberutils.h"
-#include "musicsemaphoreloop.h"
 #include "musicalgorithmutils.h"
 #include "musicabstractnetwork.h"
 
 #include <QNetworkReply>
 #include <QNetworkRequest>
 #include <QSslConfiguration>
-#include <QNetworkAccessManager>
 
 #define REFER_URL   "M25YVkpIeHVOaVFRY0k3dmFWOFJsOE1tU013ZWV0Sy8="
 
@@ -192,20 +190,12 @@ QString MusicQQQueryInterface::getMusicPath(const QString &file, const QString &
     request.setRawHeader("User-Agent", MusicUtils::Algorithm::mdII(QQ_UA_URL, ALG_UA_KEY, false).toUtf8());
     MusicObject::setSslConfiguration(&request);
 
-    QNetworkAccessManager manager;
-    MusicSemaphoreLoop loop;
-    QNetworkReply *reply = manager.get(request);
-    QObject::connect(reply, SIGNAL(finished()), &loop, SLOT(quit()));
-    QObject::connect(reply, SIGNAL(error(QNetworkReply::NetworkError)), &loop, SLOT(quit()));
-    loop.exec();
-
-    if(!reply || reply->error() != QNetworkReply::NoError)
+    const QByteArray &bytes = MusicObject::syncNetworkQueryForGet(request);
+    if(bytes.isEmpty())
     {
         return QString();
     }
 
-    const QByteArray &bytes = reply->readAll();
-
     QJson::Parser parser;
     bool ok;
     const QVariant &data = parser.parse(bytes, &ok);
@@ -83,6 +83,8 @@ void MusicQQQueryRequest::downLoadFinished()
     TTK_LOGGER_INFO(QString("%1 downLoadFinished").arg(getClassName()));
     m_interrupt = false;
 
+    MusicResolveItems items;
+
     if(m_reply->error() == QNetworkReply::NoError)
     {
         const QByteArray &bytes = m_reply->readAll();
@@ -136,31 +138,18 @@ void MusicQQQueryRequest::downLoadFinished()
                                                   .arg(musicInfo.m_albumId.right(2).left(1))
                                                   .arg(musicInfo.m_albumId.right(1)).arg(musicInfo.m_albumId);
                         musicInfo.m_albumName = MusicUtils::String::illegalCharactersReplaced(value["albumname"].toString());
-
-                        if(m_interrupt || !m_manager || m_stateCode != MusicObject::NetworkQuery) return;
-                        readFromMusicSongAttribute(&musicInfo, value, m_searchQuality, m_queryAllRecords);
-                        if(m_interrupt || !m_manager || m_stateCode != MusicObject::NetworkQuery) return;
-
-                        if(musicInfo.m_songAttrs.isEmpty())
-                        {
-                            continue;
-                        }
-
-                        MusicSearchedItem item;
-                        item.m_songName = musicInfo.m_songName;
-                        item.m_singerName = musicInfo.m_singerName;
-                        item.m_albumName = musicInfo.m_albumName;
-                        item.m_time = musicInfo.m_timeLength;
-                        item.m_type = mapQueryServerString();
-                        Q_EMIT createSearchedItem(item);
                     }
-                    m_musicSongInfos << musicInfo;
+
+                    MusicResolveItem item;
+                    item.m_info = musicInfo;
+                    item.m_key = value;
+                    items << item;
                 }
             }
         }
     }
 
-    Q_EMIT downLoadDataChanged(QString());
+    startToResolve(items, m_querySimplify ? nullptr : resolveSongInformation);
     deleteAll();
 }
 
@@ -248,3 +237,8 @@ void MusicQQQueryRequest::singleDownLoadFinished()
     Q_EMIT downLoadDataChanged(QString());
     deleteAll();
 }
+
+void MusicQQQueryRequest::resolveSongInformation(MusicObject::MusicSongInformation *info, const QVariantMap &key, const QString &quality, bool all)
+{
+    MusicQQQueryInterface().readFromMusicSongAttribute(info, key, quality, all);
+}
@@ -60,6 +60,12 @@ public Q_SLOTS:
      */
     void singleDownLoadFinished();
 
+protected:
+    /*!
+     * Resolve song attributes of the query result in resolve thread.
+     */
+    static void resolveSongInformation(MusicObject::MusicSongInformation *info, const QVariantMap &key, const QString &quality, bool all);
+
 };
 
 #endif // MUSICQQQUERYREQUEST_H
@@ -3,7 +3,7 @@
 MusicWYDownLoadTextRequest::MusicWYDownLoadTextRequest(const QString &url, const QString &save, MusicObject::DownloadType type, QObject *parent)
     : MusicAbstractDownLoadRequest(url, save, type, parent)
 {
-
+    QFile::remove(m_savePath);
 }
 
 void MusicWYDownLoadTextRequest::startToDownload()
@@ -13,12 +13,12 @@ void MusicWYDownLoadTextRequest::startToDownload()
         if(m_file->open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
         {
             m_speedTimer.start();
-            m_manager = new QNetworkAccessManager(this);
+            m_manager = M_NETWORK_SESSION_PTR->manager();
 
             QNetworkRequest request;
             request.setUrl(m_url);
 #ifndef QT_NO_SSL
-            connect(m_manager, SIGNAL(sslErrors(QNetworkReply*,QList<QSslError>)), SLOT(sslErrors(QNetworkReply*,QList<QSslError>)));
+            connect(m_manager, SIGNAL(sslErrors(QNetworkReply*,QList<QSslError>)), SLOT(sslErrors(QNetworkReply*,QList<QSslError>)), Qt::UniqueConnection);
             MusicObject::setSslConfiguration(&request);
 #endif
 
@@ -1,5 +1,4 @@
 #include "musicwyqueryinterface.h"
-#include "musicsemaphoreloop.h"
 #include "musicnumberutils.h"
 #include "musicalgorithmutils.h"
 #include "musicurlutils.h"
@@ -11,7 +10,6 @@
 #include <QNetworkReply>
 #include <QNetworkRequest>
 #include <QSslConfiguration>
-#include <QNetworkAccessManager>
 
 void MusicWYQueryInterface::makeTokenQueryRequest(QNetworkRequest *request)
 {
@@ -48,21 +46,15 @@ void MusicWYQueryInterface::readFromMusicSongAttribute(MusicObject::MusicSongInf
     request.setUrl(musicUrl);
     makeTokenQueryRequest(&request);
 
-    QNetworkAccessManager manager;
-    MusicSemaphoreLoop loop;
-    QNetworkReply *reply = manager.get(request);
-    QObject::connect(reply, SIGNAL(finished()), &loop, SLOT(quit()));
-    QObject::connect(reply, SIGNAL(error(QNetworkReply::NetworkError)), &loop, SLOT(quit()));
-    loop.exec();
-
-    if(!reply || reply->error() != QNetworkReply::NoError)
+    const QByteArray &bytes = MusicObject::syncNetworkQueryForGet(request);
+    if(bytes.isEmpty())
     {
         return;
     }
 
     QJson::Parser parser;
     bool ok;
-    const QVariant &data = parser.parse(reply->readAll(), &ok);
+    const QVariant &data = parser.parse(bytes, &ok);
 
     if(ok)
     {
@@ -191,21 +183,15 @@ void MusicWYQueryInterface::readFromMusicSongAttributeNew(MusicObject::MusicSong
                       MusicUtils::Algorithm::mdII(WY_SONG_PATH_URL, false),
                       MusicUtils::Algorithm::mdII(WY_SONG_PATH_DATA_URL, false).arg(info->m_songId).arg(bitrate*1000));
 
-    QNetworkAccessManager manager;
-    MusicSemaphoreLoop loop;
-    QNetworkReply *reply = manager.post(request, parameter);
-    QObject::connect(reply, SIGNAL(finished()), &loop, SLOT(quit()));
-    QObject::connect(reply, SIGNAL(error(QNetworkReply::NetworkError)), &loop, SLOT(quit()));
-    loop.exec();
-
-    if(!reply || reply->error() != QNetworkReply::NoError)
+    const QByteArray &bytes = MusicObject::syncNetworkQueryForPost(request, parameter);
+    if(bytes.isEmpty())
     {
         return;
     }
 
     QJson::Parser parser;
     bool ok;
-    const QVariant &data = parser.parse(reply->readAll(), &ok);
+    const QVariant &data = parser.parse(bytes, &ok);
     if(ok)
     {
         QVariantMap value = data.toMap();
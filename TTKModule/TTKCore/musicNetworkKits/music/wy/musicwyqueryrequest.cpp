@@ -86,6 +86,8 @@ void MusicWYQueryRequest::downLoadFinished()
     TTK_LOGGER_INFO(QString("%1 downLoadFinished").arg(getClassName()));
     m_interrupt = false;
 
+    MusicResolveItems items;
+
     if(m_reply->error() == QNetworkReply::NoError)
     {
         QJson::Parser parser;
@@ -134,32 +136,16 @@ void MusicWYQueryRequest::downLoadFinished()
                     musicInfo.m_discNumber = value["cd"].toString();
                     musicInfo.m_trackNumber = value["no"].toString();
 
-                    if(!m_querySimplify)
-                    {
-                        if(m_interrupt || !m_manager || m_stateCode != MusicObject::NetworkQuery) return;
-                        readFromMusicSongAttributeNew(&musicInfo, value, m_searchQuality, m_queryAllRecords);
-                        if(m_interrupt || !m_manager || m_stateCode != MusicObject::NetworkQuery) return;
-
-                        if(musicInfo.m_songAttrs.isEmpty())
-                        {
-                            continue;
-                        }
-
-                        MusicSearchedItem item;
-                        item.m_songName = musicInfo.m_songName;
-                        item.m_singerName = musicInfo.m_singerName;
-                        item.m_albumName = musicInfo.m_albumName;
-                        item.m_time = musicInfo.m_timeLength;
-                        item.m_type = mapQueryServerString();
-                        Q_EMIT createSearchedItem(item);
-                    }
-                    m_musicSongInfos << musicInfo;
+                    MusicResolveItem item;
+                    item.m_info = musicInfo;
+                    item.m_key = value;
+                    items << item;
                 }
             }
         }
     }
 
-    Q_EMIT downLoadDataChanged(QString());
+    startToResolve(items, m_querySimplify ? nullptr : resolveSongInformation);
     deleteAll();
 }
 
@@ -244,3 +230,8 @@ void MusicWYQueryRequest::singleDownLoadFinished()
     Q_EMIT downLoadDataChanged(QString());
     deleteAll();
 }
+
+void MusicWYQueryRequest::resolveSongInformation(MusicObject::MusicSongInformation *info, const QVariantMap &key, const QString &quality, bool all)
+{
+    MusicWYQueryInterface().readFromMusicSongAttributeNew(info, key, quality, all);
+}
@@ -4,7 +4,7 @@
 MusicXMDownLoadTextRequest::MusicXMDownLoadTextRequest(const QString &url, const QString &save, MusicObject::DownloadType  type, QObject *parent)
     : MusicAbstractDownLoadRequest(url, save, type, parent)
 {
-
+    QFile::remove(m_savePath);
 }
 
 void MusicXMDownLoadTextRequest::startToDownload()
@@ -14,14 +14,14 @@ void MusicXMDownLoadTextRequest::startToDownload()
         if(m_file->open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
         {
             m_speedTimer.start();
-            m_manager = new QNetworkAccessManager(this);
+            m_manager = M_NETWORK_SESSION_PTR->manager();
 
             m_lrcType = MusicUtils::String::stringSplitToken(m_url);
 
             QNetworkRequest request;
             request.setUrl(m_url);
 #ifndef QT_NO_SSL
-            connect(m_manager, SIGNAL(sslErrors(QNetworkReply*,QList<QSslError>)), SLOT(sslErrors(QNetworkReply*,QList<QSslError>)));
+            connect(m_manager, SIGNAL(sslErrors(QNetworkReply*,QList<QSslError>)), SLOT(sslErrors(QNetworkReply*,QList<QSslError>)), Qt::UniqueConnection);
             MusicObject::setSslConfiguration(&request);
 #endif
 
@@ -73,24 +73,17 @@ void MusicXMQueryInterface::makeTokenQueryUrl(QNetworkRequest *request, bool mod
 
 void MusicXMQueryInterface::readFromMusicSongLrc(MusicObject::MusicSongInformation *info)
 {
-    QNetworkAccessManager manager;
     QNetworkRequest request;
     makeTokenQueryUrl(&request, false,
                       MusicUtils::Algorithm::mdII(XM_SONG_LRC_DATA_URL, false).arg(info->m_songId),
                       MusicUtils::Algorithm::mdII(XM_SONG_LRC_URL, false));
-    MusicSemaphoreLoop loop;
-    QNetworkReply *reply = manager.get(request);
-    QObject::connect(reply, SIGNAL(finished()), &loop, SLOT(quit()));
-    QObject::connect(reply, SIGNAL(error(QNetworkReply::NetworkError)), &loop, SLOT(quit()));
-    loop.exec();
 
-    if(!reply || reply->error() != QNetworkReply::NoError)
+    const QByteArray &bytes = MusicObject::syncNetworkQueryForGet(request);
+    if(bytes.isEmpty())
     {
         return;
     }
 
-    const QByteArray &bytes = reply->readAll();
-
     QJson::Parser parser;
     bool ok;
     const QVariant &data = parser.parse(bytes, &ok);
@@ -1,8 +1,7 @@
 #include "musicabstractdownloadrequest.h"
-#include "musicsettingmanager.h"
 #include "musicdownloadmanager.h"
+#include "musicdownloadlimiter.h"
 #include "musicstringutils.h"
-#include "musiccoreutils.h"
 
 #include <QSslError>
 #include <QNetworkRequest>
@@ -16,11 +15,6 @@ MusicAbstractDownLoadRequest::MusicAbstractDownLoadRequest(const QString &url, c
     m_downloadType = type;
     m_hasReceived = 0;
     m_currentReceived = 0;
-
-    if(QFile::exists(m_savePath))
-    {
-        QFile::remove(m_savePath);
-    }
     m_file = new QFile(m_savePath, this);
 
     M_DOWNLOAD_MANAGER_PTR->connectNetworkMultiValue(this);
@@ -36,10 +30,12 @@ MusicAbstractDownLoadRequest::~MusicAbstractDownLoadRequest()
         m_speedTimer.stop();
     }
     M_DOWNLOAD_MANAGER_PTR->removeNetworkMultiValue(this);
+    M_DOWNLOAD_LIMITER_PTR->remove(this);
 }
 
 void MusicAbstractDownLoadRequest::deleteAll()
 {
+    M_DOWNLOAD_LIMITER_PTR->remove(this);
     MusicAbstractNetwork::deleteAll();
     if(m_file)
     {
@@ -49,6 +45,25 @@ void MusicAbstractDownLoadRequest::deleteAll()
     deleteLater();
 }
 
+qint64 MusicAbstractDownLoadRequest::readLimitedData(qint64 maxSize)
+{
+    Q_UNUSED(maxSize);
+    return 0;
+}
+
+qint64 MusicAbstractDownLoadRequest::pendingDataSize() const
+{
+    return m_reply ? m_reply->bytesAvailable() : 0;
+}
+
+void MusicAbstractDownLoadRequest::setReadBufferSize(qint64 size)
+{
+    if(m_reply)
+    {
+        m_reply->setReadBufferSize(size);
+    }
+}
+
 void MusicAbstractDownLoadRequest::replyError(QNetworkReply::NetworkError)
 {
     TTK_LOGGER_ERROR("Abnormal network connection");
@@ -59,6 +74,11 @@ void MusicAbstractDownLoadRequest::replyError(QNetworkReply::NetworkError)
 #ifndef QT_NO_SSL
 void MusicAbstractDownLoadRequest::sslErrors(QNetworkReply* reply, const QList<QSslError> &errors)
 {
+    if(!m_reply || reply != m_reply)
+    {
+        return;
+    }
+
     sslErrorsString(reply, errors);
     Q_EMIT downLoadDataChanged("The file create failed");
     deleteAll();
@@ -73,17 +93,7 @@ void MusicAbstractDownLoadRequest::downloadProgress(qint64 bytesReceived, qint64
 
 void MusicAbstractDownLoadRequest::updateDownloadSpeed()
 {
-    int delta = m_currentReceived - m_hasReceived;
-    ///limit speed
-    if(M_SETTING_PTR->value(MusicSettingManager::DownloadLimit).toInt() == 0)
-    {
-        const int limitValue = M_SETTING_PTR->value(MusicSettingManager::DownloadDLoadLimit).toInt();
-        if(limitValue != 0 && delta > limitValue * MH_KB)
-        {
-            MusicUtils::Core::sleep(MT_S2MS - limitValue * MH_KB * MT_S2MS / delta);
-            delta = limitValue * MH_KB;
-        }
-    }
+    ///speed limit is done by the download limiter
     m_hasReceived = m_currentReceived;
 }
 
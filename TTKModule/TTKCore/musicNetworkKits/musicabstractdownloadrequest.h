@@ -50,6 +50,20 @@ public:
      */
     virtual void startToDownload() = 0;
 
+    /*!
+     * Read the received data at most max size by the download limiter, return the read size.
+     * Subclass which saves data while downloading should implement this function.
+     */
+    virtual qint64 readLimitedData(qint64 maxSize);
+    /*!
+     * Get the received data size not read yet.
+     */
+    virtual qint64 pendingDataSize() const;
+    /*!
+     * Set the reply read buffer size, zero means unlimited.
+     */
+    virtual void setReadBufferSize(qint64 size);
+
 public Q_SLOTS:
     /*!
      * Get download received and total data.
@@ -1,4 +1,5 @@
 #include "musicabstractnetwork.h"
+#include "musicsemaphoreloop.h"
 
 MusicAbstractNetwork::MusicAbstractNetwork(QObject *parent)
     : QObject(parent)
@@ -17,11 +18,8 @@ MusicAbstractNetwork::~MusicAbstractNetwork()
 
 void MusicAbstractNetwork::deleteAll()
 {
-    if(m_manager)
-    {
-        m_manager->deleteLater();
-        m_manager = nullptr;
-    }
+    ///the manager is shared by the network session, just detach from it
+    m_manager = nullptr;
     if(m_reply)
     {
         m_reply->deleteLater();
@@ -39,6 +37,12 @@ void MusicAbstractNetwork::replyError(QNetworkReply::NetworkError)
 #ifndef QT_NO_SSL
 void MusicAbstractNetwork::sslErrors(QNetworkReply* reply, const QList<QSslError> &errors)
 {
+    ///the session manager reports errors of every request
+    if(!m_reply || reply != m_reply)
+    {
+        return;
+    }
+
     sslErrorsString(reply, errors);
     Q_EMIT downLoadDataChanged(QString());
     deleteAll();
@@ -75,4 +79,37 @@ void setSslConfiguration(QNetworkRequest *request, QSslSocket::PeerVerifyMode mo
     Q_UNUSED(mode);
 #endif
 }
+
+static QByteArray syncNetworkQueryForReply(QNetworkReply *reply)
+{
+    MusicSemaphoreLoop loop;
+    QObject::connect(reply, SIGNAL(finished()), &loop, SLOT(quit()));
+    QObject::connect(reply, SIGNAL(error(QNetworkReply::NetworkError)), &loop, SLOT(quit()));
+    loop.exec();
+
+    if(!reply->isFinished())
+    {
+        reply->abort();
+    }
+
+    QByteArray data;
+    if(reply->error() == QNetworkReply::NoError)
+    {
+        data = reply->readAll();
+    }
+
+    ///the session manager outlives the reply, so release it here
+    delete reply;
+    return data;
+}
+
+QByteArray syncNetworkQueryForGet(const QNetworkRequest &request)
+{
+    return syncNetworkQueryForReply(M_NETWORK_SESSION_PTR->manager()->get(request));
+}
+
+QByteArray syncNetworkQueryForPost(const QNetworkRequest &request, const QByteArray &data)
+{
+    return syncNetworkQueryForReply(M_NETWORK_SESSION_PTR->manager()->post(request, data));
+}
 }
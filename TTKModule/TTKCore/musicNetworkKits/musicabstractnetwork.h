@@ -19,11 +19,13 @@
  * with this program; If not, see <http://www.gnu.org/licenses/>.
  ================================================= */
 
+#include <QPointer>
 #include <QNetworkReply>
 #include <QSslConfiguration>
 
 #include "musictime.h"
 #include "musicnetworkthread.h"
+#include "musicnetworksession.h"
 #include "musicnetworkdefines.h"
 #include "musicalgorithmutils.h"
 #///QJson import
@@ -116,7 +118,7 @@ protected:
     QVariantMap m_headerData;
     volatile bool m_interrupt;
     volatile MusicObject::NetworkCode m_stateCode;
-    QNetworkReply *m_reply;
+    QPointer<QNetworkReply> m_reply;
     QNetworkAccessManager *m_manager;
 
 };
@@ -127,6 +129,16 @@ namespace MusicObject
      * Set request ssl configuration.
      */
     MUSIC_NETWORK_EXPORT void setSslConfiguration(QNetworkRequest *request, QSslSocket::PeerVerifyMode mode = QSslSocket::VerifyNone);
+    /*!
+     * Blocking get request by the shared network session.
+     * Return empty data when the request failed or timed out.
+     */
+    MUSIC_NETWORK_EXPORT QByteArray syncNetworkQueryForGet(const QNetworkRequest &request);
+    /*!
+     * Blocking post request by the shared network session.
+     * Return empty data when the request failed or timed out.
+     */
+    MUSIC_NETWORK_EXPORT QByteArray syncNetworkQueryForPost(const QNetworkRequest &request, const QByteArray &data);
 
 }
 
@@ -2,6 +2,97 @@
 #include "musicsemaphoreloop.h"
 #include "musicnumberutils.h"
 
+#include <QRunnable>
+#include <QThreadPool>
+
+#define QUERY_RESOLVE_THREAD_COUNT  6
+
+/*! @brief The class of the query result resolve runnable.
+ * @author Greedysky <greedysky@163.com>
+ */
+class MusicQueryResolveRunnable : public QRunnable
+{
+public:
+    MusicQueryResolveRunnable(const QSharedPointer<MusicQueryResolveQueue> &queue, MusicQueryResolver resolver,
+                              int index, const MusicResolveItem &item, const QString &quality, bool all)
+        : m_queue(queue), m_resolver(resolver), m_index(index), m_item(item), m_quality(quality), m_all(all)
+    {
+
+    }
+
+    virtual void run() override
+    {
+        if(m_queue->isCancelled())
+        {
+            return;
+        }
+
+        m_resolver(&m_item.m_info, m_item.m_key, m_quality, m_all);
+        m_queue->append(m_index, m_item.m_info);
+    }
+
+private:
+    QSharedPointer<MusicQueryResolveQueue> m_queue;
+    MusicQueryResolver m_resolver;
+    int m_index;
+    MusicResolveItem m_item;
+    QString m_quality;
+    bool m_all;
+
+};
+
+static QThreadPool *queryResolveThreadPool()
+{
+    ///never deleted, pending blocking requests must not hold up the application exit
+    static QThreadPool *pool = nullptr;
+    if(!pool)
+    {
+        pool = new QThreadPool;
+        pool->setMaxThreadCount(QUERY_RESOLVE_THREAD_COUNT);
+    }
+    return pool;
+}
+
+
+MusicQueryResolveQueue::MusicQueryResolveQueue(int count, QObject *parent)
+    : QObject(parent)
+{
+    m_next = 0;
+    m_cancel = false;
+    m_resolved.fill(false, count);
+    m_infos.resize(count);
+}
+
+void MusicQueryResolveQueue::append(int index, const MusicObject::MusicSongInformation &info)
+{
+    m_mutex.lock();
+    m_infos[index] = info;
+    m_resolved[index] = true;
+    m_mutex.unlock();
+
+    Q_EMIT resolved();
+}
+
+MusicObject::MusicSongInformations MusicQueryResolveQueue::takeResolved()
+{
+    QMutexLocker locker(&m_mutex);
+    ///keep the ranking of the server, stop at the first result still resolving
+    MusicObject::MusicSongInformations infos;
+    for(; m_next < m_infos.count() && m_resolved[m_next]; ++m_next)
+    {
+        infos << m_infos[m_next];
+        m_infos[m_next] = MusicObject::MusicSongInformation();
+    }
+    return infos;
+}
+
+bool MusicQueryResolveQueue::isFinished()
+{
+    QMutexLocker locker(&m_mutex);
+    return m_next >= m_infos.count();
+}
+
+
 MusicAbstractQueryRequest::MusicAbstractQueryRequest(QObject *parent)
     : MusicPagingRequest(parent)
 {
@@ -13,6 +104,7 @@ MusicAbstractQueryRequest::MusicAbstractQueryRequest(QObject *parent)
 
 MusicAbstractQueryRequest::~MusicAbstractQueryRequest()
 {
+    stopToResolve();
     deleteAll();
 }
 
@@ -109,3 +201,76 @@ qint64 MusicAbstractQueryRequest::getUrlFileSize(const QString &url)
 
     return size;
 }
+
+void MusicAbstractQueryRequest::startToResolve(const MusicResolveItems &items, MusicQueryResolver resolver)
+{
+    stopToResolve();
+
+    if(!resolver || items.isEmpty())
+    {
+        foreach(const MusicResolveItem &item, items)
+        {
+            m_musicSongInfos << item.m_info;
+        }
+        Q_EMIT downLoadDataChanged(QString());
+        return;
+    }
+
+    m_resolveQueue = QSharedPointer<MusicQueryResolveQueue>(new MusicQueryResolveQueue(items.count()), &QObject::deleteLater);
+    connect(m_resolveQueue.data(), SIGNAL(resolved()), SLOT(resolveFinished()));
+
+    QThreadPool *pool = queryResolveThreadPool();
+    for(int i=0; i<items.count(); ++i)
+    {
+        pool->start(new MusicQueryResolveRunnable(m_resolveQueue, resolver, i, items[i], m_searchQuality, m_queryAllRecords));
+    }
+}
+
+void MusicAbstractQueryRequest::stopToResolve()
+{
+    if(m_resolveQueue)
+    {
+        m_resolveQueue->cancel();
+        m_resolveQueue.clear();
+    }
+}
+
+void MusicAbstractQueryRequest::resolveFinished()
+{
+    if(!m_resolveQueue || m_resolveQueue.data() != sender())
+    {
+        return;
+    }
+
+    if(m_interrupt || !m_manager || m_stateCode != MusicObject::NetworkQuery)
+    {
+        stopToResolve();
+        return;
+    }
+
+    foreach(const MusicObject::MusicSongInformation &info, m_resolveQueue->takeResolved())
+    {
+        if(!m_querySimplify)
+        {
+            if(info.m_songAttrs.isEmpty())
+            {
+                continue;
+            }
+
+            MusicSearchedItem item;
+            item.m_songName = info.m_songName;
+            item.m_singerName = info.m_singerName;
+            item.m_albumName = info.m_albumName;
+            item.m_time = info.m_timeLength;
+            item.m_type = mapQueryServerString();
+            Q_EMIT createSearchedItem(item);
+        }
+        m_musicSongInfos << info;
+    }
+
+    if(m_resolveQueue->isFinished())
+    {
+        m_resolveQueue.clear();
+        Q_EMIT downLoadDataChanged(QString());
+    }
+}
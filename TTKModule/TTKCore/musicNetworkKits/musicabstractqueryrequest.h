@@ -23,6 +23,9 @@
 #include "musicstringutils.h"
 #include "musicpagingrequest.h"
 
+#include <QMutex>
+#include <QSharedPointer>
+
 /*! @brief The class of the searched data item.
  * @author Greedysky <greedysky@163.com>
  */
@@ -78,6 +81,72 @@ typedef struct MUSIC_NETWORK_EXPORT MusicResultsItem
 }MusicResultsItem;
 TTK_DECLARE_LISTS(MusicResultsItem)
 
+/*! @brief The class of the query result waiting for resolving.
+ * @author Greedysky <greedysky@163.com>
+ */
+typedef struct MUSIC_NETWORK_EXPORT MusicResolveItem
+{
+    MusicObject::MusicSongInformation m_info;
+    QVariantMap m_key;
+}MusicResolveItem;
+TTK_DECLARE_LISTS(MusicResolveItem)
+
+/*!
+ * Resolve song attributes of one query result, called in resolve thread.
+ */
+typedef void (*MusicQueryResolver)(MusicObject::MusicSongInformation *info, const QVariantMap &key, const QString &quality, bool all);
+
+/*! @brief The class of the query results resolve queue.
+ * @author Greedysky <greedysky@163.com>
+ */
+class MUSIC_NETWORK_EXPORT MusicQueryResolveQueue : public QObject
+{
+    Q_OBJECT
+    TTK_DECLARE_MODULE(MusicQueryResolveQueue)
+public:
+    /*!
+     * Object contsructor.
+     */
+    explicit MusicQueryResolveQueue(int count, QObject *parent = nullptr);
+
+    /*!
+     * Append the resolved song info at its query result index, thread safe.
+     */
+    void append(int index, const MusicObject::MusicSongInformation &info);
+    /*!
+     * Take the resolved song infos not fetched yet, in query result order.
+     * A result resolved early waits until all results before it are resolved.
+     */
+    MusicObject::MusicSongInformations takeResolved();
+    /*!
+     * Check all query results are resolved.
+     */
+    bool isFinished();
+
+    /*!
+     * Cancel the pending query results.
+     */
+    inline void cancel() { m_cancel = true; }
+    /*!
+     * Check the queue is cancelled.
+     */
+    inline bool isCancelled() const { return m_cancel; }
+
+Q_SIGNALS:
+    /*!
+     * Query result resolved.
+     */
+    void resolved();
+
+private:
+    QMutex m_mutex;
+    int m_next;
+    volatile bool m_cancel;
+    QVector<bool> m_resolved;
+    QVector<MusicObject::MusicSongInformation> m_infos;
+
+};
+
 #define QUERY_WY_INTERFACE      "WangYi"
 #define QUERY_QQ_INTERFACE      "QQ"
 #define QUERY_XM_INTERFACE      "XiaMi"
@@ -196,11 +265,17 @@ Q_SIGNALS:
      */
     void createSearchedItem(const MusicSearchedItem &songItem);
 
+private Q_SLOTS:
+    /*!
+     * Query results resolved in resolve thread.
+     */
+    void resolveFinished();
+
 protected:
     /*!
      * Find time string by attrs.
      */
-    QString findTimeStringByAttrs(const MusicObject::MusicSongAttributes &attrs);
+    static QString findTimeStringByAttrs(const MusicObject::MusicSongAttributes &attrs);
     /*!
      * Find download file size.
      */
@@ -212,13 +287,23 @@ protected:
     /*!
      * Get download file size.
      */
-    qint64 getUrlFileSize(const QString &url);
+    static qint64 getUrlFileSize(const QString &url);
+    /*!
+     * Start to resolve query results concurrently.
+     * Resolved items are created in finish order, null resolver appends items directly.
+     */
+    void startToResolve(const MusicResolveItems &items, MusicQueryResolver resolver);
+    /*!
+     * Stop to resolve the pending query results.
+     */
+    void stopToResolve();
 
     MusicObject::MusicSongInformations m_musicSongInfos;
     QString m_searchText, m_searchQuality;
     QString m_queryServer;
     QueryType m_currentType;
     bool m_queryAllRecords, m_querySimplify;
+    QSharedPointer<MusicQueryResolveQueue> m_resolveQueue;
 
 };
 
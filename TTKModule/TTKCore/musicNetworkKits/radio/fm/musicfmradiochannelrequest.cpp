@@ -20,12 +20,12 @@ MusicFMRadioChannelRequest::~MusicFMRadioChannelRequest()
 void MusicFMRadioChannelRequest::startToDownload(const QString &id)
 {
     Q_UNUSED(id);
-    m_manager = new QNetworkAccessManager(this);
+    m_manager = M_NETWORK_SESSION_PTR->manager();
 
     QNetworkRequest request;
     request.setUrl(QUrl(MusicUtils::Algorithm::mdII(FM_CHANNEL_URL, false)));
 #ifndef QT_NO_SSL
-    connect(m_manager, SIGNAL(sslErrors(QNetworkReply*,QList<QSslError>)), SLOT(sslErrors(QNetworkReply*,QList<QSslError>)));
+    connect(m_manager, SIGNAL(sslErrors(QNetworkReply*,QList<QSslError>)), SLOT(sslErrors(QNetworkReply*,QList<QSslError>)), Qt::UniqueConnection);
     MusicObject::setSslConfiguration(&request);
 #endif
     if(m_cookJar)
@@ -20,12 +20,12 @@ void MusicFMRadioSongsRequest::startToDownload(const QString &id)
 {
     m_cachedID = id;
     m_songInfo = MusicObject::MusicSongInformation();
-    m_manager = new QNetworkAccessManager(this);
+    m_manager = M_NETWORK_SESSION_PTR->manager();
 
     QNetworkRequest request;
     request.setUrl(QUrl(MusicUtils::Algorithm::mdII(FM_SONG_URL, false).arg(id)));
 #ifndef QT_NO_SSL
-    connect(m_manager, SIGNAL(sslErrors(QNetworkReply*,QList<QSslError>)), SLOT(sslErrors(QNetworkReply*,QList<QSslError>)));
+    connect(m_manager, SIGNAL(sslErrors(QNetworkReply*,QList<QSslError>)), SLOT(sslErrors(QNetworkReply*,QList<QSslError>)), Qt::UniqueConnection);
     MusicObject::setSslConfiguration(&request);
 #endif
 
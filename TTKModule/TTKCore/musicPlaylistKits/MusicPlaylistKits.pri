@@ -27,6 +27,9 @@ HEADERS  += \
     $$PWD/musicm3uconfigmanager.h \
     $$PWD/musicplsconfigmanager.h \
     $$PWD/musictkplconfigmanager.h \
+    $$PWD/musictkpbconfigmanager.h \
+    $$PWD/musicplaylistjournal.h \
+    $$PWD/musicplaylistsearchindex.h \
     $$PWD/musicwplconfigmanager.h \
     $$PWD/musicxspfconfigmanager.h \
     $$PWD/musiccsvconfigmanager.h \
@@ -42,6 +45,9 @@ SOURCES += \
     $$PWD/musicm3uconfigmanager.cpp \
     $$PWD/musicplsconfigmanager.cpp \
     $$PWD/musictkplconfigmanager.cpp \
+    $$PWD/musictkpbconfigmanager.cpp \
+    $$PWD/musicplaylistjournal.cpp \
+    $$PWD/musicplaylistsearchindex.cpp \
     $$PWD/musicwplconfigmanager.cpp \
     $$PWD/musicxspfconfigmanager.cpp \
     $$PWD/musiccsvconfigmanager.cpp \
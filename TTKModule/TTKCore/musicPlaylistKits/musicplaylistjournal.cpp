@@ -0,0 +1,480 @@
+#include "musicplaylistjournal.h"
+#include "musictkpbconfigmanager.h"
+
+#include <QDataStream>
+#include <QDateTime>
+#ifdef TTK_GREATER_NEW
+#  include <QtConcurrent/QtConcurrent>
+#else
+#  include <QtConcurrentRun>
+#endif
+
+#define TKPJ_MAGIC                  0x544B504A
+#define TKPJ_VERSION                1
+#define TKPJ_HEADER_SIZE            16
+#define PLAYLIST_JOURNAL_BACKUP     ".bak"
+
+static void writeMusicSongs(QDataStream &stream, const MusicSongs &songs)
+{
+    stream << quint32(songs.count());
+    foreach(const MusicSong &song, songs)
+    {
+        MusicTKPBConfigManager::writeMusicSong(stream, song);
+    }
+}
+
+static bool readMusicSongs(QDataStream &stream, MusicSongs &songs)
+{
+    quint32 count = 0;
+    stream >> count;
+    for(quint32 i=0; i<count && stream.status() == QDataStream::Ok; ++i)
+    {
+        songs << MusicTKPBConfigManager::readMusicSong(stream);
+    }
+    return stream.status() == QDataStream::Ok;
+}
+
+static bool writeSnapshot(const MusicSongItems &items, qint64 generation, const QString &backup)
+{
+    MusicTKPBConfigManager manager;
+    manager.setGeneration(generation);
+    if(!manager.writePlaylistData(items))
+    {
+        return false;
+    }
+
+    ///the backup records are all in the new snapshot now
+    QFile::remove(backup);
+    return true;
+}
+
+
+MusicPlaylistJournal::MusicPlaylistJournal()
+{
+    m_base = 0;
+    m_count = 0;
+
+    m_timer.setSingleShot(true);
+    connect(&m_timer, SIGNAL(timeout()), SIGNAL(compactRequested()));
+}
+
+MusicPlaylistJournal::~MusicPlaylistJournal()
+{
+    m_future.waitForFinished();
+    m_file.close();
+}
+
+bool MusicPlaylistJournal::replay(qint64 generation, MusicSongItems &items)
+{
+    const QString &backup = MUSICJOURNALPATH_FULL + PLAYLIST_JOURNAL_BACKUP;
+    if(generation <= 0)
+    {
+        ///no snapshot to replay the records on
+        QFile::remove(backup);
+        open(0, true);
+        return false;
+    }
+
+    qint64 base = 0, end = 0;
+    const int backupCount = replay(backup, generation, false, items, &base, &end);
+    if(backupCount < 0)
+    {
+        QFile::remove(backup);
+    }
+
+    ///the records after a backup are based on the unfinished snapshot
+    const int count = replay(MUSICJOURNALPATH_FULL, generation, backupCount >= 0, items, &base, &end);
+    if(count < 0)
+    {
+        open(backupCount < 0 ? generation : qMax(QDateTime::currentMSecsSinceEpoch(), generation + 1), true);
+    }
+    else
+    {
+        ///drop the torn record of last crash
+        QFile::resize(MUSICJOURNALPATH_FULL, end);
+        open(base, false);
+        m_count = count;
+    }
+
+    if(backupCount > 0)
+    {
+        m_count += backupCount;
+    }
+
+    if(m_count > 0)
+    {
+        m_timer.start(PLAYLIST_JOURNAL_COMPACT_INTERVAL);
+    }
+
+    for(int i=0; i<items.count(); ++i)
+    {
+        items[i].m_itemIndex = i;
+    }
+    return true;
+}
+
+void MusicPlaylistJournal::compact(const MusicSongItems &items, bool wait)
+{
+    m_timer.stop();
+    if(m_future.isRunning())
+    {
+        if(!wait)
+        {
+            m_timer.start(PLAYLIST_JOURNAL_COMPACT_INTERVAL);
+            return;
+        }
+        m_future.waitForFinished();
+    }
+
+    const QString &path = MUSICJOURNALPATH_FULL;
+    const QString &backup = path + PLAYLIST_JOURNAL_BACKUP;
+    m_file.close();
+
+    ///keep the records until the new snapshot replaced, merge them when last compaction failed
+    if(!QFile::exists(backup))
+    {
+        QFile::rename(path, backup);
+    }
+    else
+    {
+        QFile file(path), backupFile(backup);
+        if(file.open(QFile::ReadOnly) && file.seek(TKPJ_HEADER_SIZE) && backupFile.open(QFile::WriteOnly | QFile::Append))
+        {
+            backupFile.write(file.readAll());
+        }
+        file.close();
+        backupFile.close();
+        QFile::remove(path);
+    }
+
+    const qint64 generation = qMax(QDateTime::currentMSecsSinceEpoch(), m_base + 1);
+    open(generation, true);
+
+    if(wait)
+    {
+        writeSnapshot(items, generation, backup);
+    }
+    else
+    {
+        m_future = QtConcurrent::run(writeSnapshot, items, generation, backup);
+    }
+}
+
+void MusicPlaylistJournal::appendSongs(int list, const MusicSongs &songs)
+{
+    QByteArray record;
+    QDataStream stream(&record, QIODevice::WriteOnly);
+    stream << quint8(AppendSongs) << qint32(list);
+    writeMusicSongs(stream, songs);
+    append(record);
+}
+
+void MusicPlaylistJournal::removeSongs(int list, const TTKIntList &rows)
+{
+    QByteArray record;
+    QDataStream stream(&record, QIODevice::WriteOnly);
+    stream << quint8(RemoveSongs) << qint32(list) << rows;
+    append(record);
+}
+
+void MusicPlaylistJournal::moveSong(int list, int before, int after)
+{
+    QByteArray record;
+    QDataStream stream(&record, QIODevice::WriteOnly);
+    stream << quint8(MoveSong) << qint32(list) << qint32(before) << qint32(after);
+    append(record);
+}
+
+void MusicPlaylistJournal::setSongs(int list, const MusicSongs &songs)
+{
+    QByteArray record;
+    QDataStream stream(&record, QIODevice::WriteOnly);
+    stream << quint8(SetSongs) << qint32(list);
+    writeMusicSongs(stream, songs);
+    append(record);
+}
+
+void MusicPlaylistJournal::setPlayCount(int list, int row, int count)
+{
+    QByteArray record;
+    QDataStream stream(&record, QIODevice::WriteOnly);
+    stream << quint8(SetPlayCount) << qint32(list) << qint32(row) << qint32(count);
+    append(record);
+}
+
+void MusicPlaylistJournal::renameSong(int list, int row, const QString &name)
+{
+    QByteArray record;
+    QDataStream stream(&record, QIODevice::WriteOnly);
+    stream << quint8(RenameSong) << qint32(list) << qint32(row) << name;
+    append(record);
+}
+
+void MusicPlaylistJournal::setSort(int list, const MusicSort &sort)
+{
+    QByteArray record;
+    QDataStream stream(&record, QIODevice::WriteOnly);
+    stream << quint8(SetSort) << qint32(list) << qint32(sort.m_index) << qint32(sort.m_sortType);
+    append(record);
+}
+
+void MusicPlaylistJournal::appendList(const QString &name, const MusicSongs &songs)
+{
+    QByteArray record;
+    QDataStream stream(&record, QIODevice::WriteOnly);
+    stream << quint8(AppendList) << name;
+    writeMusicSongs(stream, songs);
+    append(record);
+}
+
+void MusicPlaylistJournal::removeList(int list)
+{
+    QByteArray record;
+    QDataStream stream(&record, QIODevice::WriteOnly);
+    stream << quint8(RemoveList) << qint32(list);
+    append(record);
+}
+
+void MusicPlaylistJournal::renameList(int list, const QString &name)
+{
+    QByteArray record;
+    QDataStream stream(&record, QIODevice::WriteOnly);
+    stream << quint8(RenameList) << qint32(list) << name;
+    append(record);
+}
+
+void MusicPlaylistJournal::moveList(int before, int after)
+{
+    QByteArray record;
+    QDataStream stream(&record, QIODevice::WriteOnly);
+    stream << quint8(MoveList) << qint32(before) << qint32(after);
+    append(record);
+}
+
+void MusicPlaylistJournal::append(const QByteArray &record)
+{
+    if(!m_file.isOpen())
+    {
+        return;
+    }
+
+    QByteArray frame;
+    QDataStream stream(&frame, QIODevice::WriteOnly);
+    stream << quint32(record.size()) << quint16(qChecksum(record.constData(), record.size()));
+    frame.append(record);
+
+    ///one write for each record, a torn record is dropped when replayed
+    m_file.write(frame);
+    m_file.flush();
+
+    if(++m_count >= PLAYLIST_JOURNAL_COMPACT_COUNT)
+    {
+        m_timer.start(MT_MS);
+    }
+    else if(!m_timer.isActive())
+    {
+        m_timer.start(PLAYLIST_JOURNAL_COMPACT_INTERVAL);
+    }
+}
+
+int MusicPlaylistJournal::replay(const QString &path, qint64 generation, bool newer, MusicSongItems &items, qint64 *base, qint64 *end) const
+{
+    QFile file(path);
+    if(!file.open(QFile::ReadOnly))
+    {
+        return -1;
+    }
+
+    const QByteArray &data = file.readAll();
+    file.close();
+
+    QDataStream stream(data);
+    quint32 magic = 0, version = 0;
+    qint64 journalBase = 0;
+    stream >> magic >> version >> journalBase;
+    if(stream.status() != QDataStream::Ok || magic != TKPJ_MAGIC || version != TKPJ_VERSION)
+    {
+        return -1;
+    }
+
+    if(newer ? journalBase <= generation : journalBase != generation)
+    {
+        return -1;
+    }
+
+    int count = 0;
+    *base = journalBase;
+    *end = TKPJ_HEADER_SIZE;
+    while(!stream.atEnd())
+    {
+        quint32 size = 0;
+        quint16 checksum = 0;
+        stream >> size >> checksum;
+        if(stream.status() != QDataStream::Ok || qint64(size) > data.size() - stream.device()->pos())
+        {
+            break;
+        }
+
+        QByteArray record(size, 0);
+        stream.readRawData(record.data(), size);
+        if(qChecksum(record.constData(), record.size()) != checksum || !apply(record, items))
+        {
+            break;
+        }
+
+        ++count;
+        *end = stream.device()->pos();
+    }
+    return count;
+}
+
+bool MusicPlaylistJournal::apply(const QByteArray &record, MusicSongItems &items) const
+{
+    QDataStream stream(record);
+    quint8 operation = 0;
+    stream >> operation;
+
+    if(operation == AppendList)
+    {
+        MusicSongItem item;
+        stream >> item.m_itemName;
+        if(!readMusicSongs(stream, item.m_songs))
+        {
+            return false;
+        }
+        items << item;
+        return true;
+    }
+
+    qint32 list = -1;
+    stream >> list;
+    if(stream.status() != QDataStream::Ok || list < 0 || list >= items.count())
+    {
+        return false;
+    }
+
+    MusicSongItem *item = &items[list];
+    switch(operation)
+    {
+        case AppendSongs:
+        case SetSongs:
+            {
+                MusicSongs songs;
+                if(!readMusicSongs(stream, songs))
+                {
+                    return false;
+                }
+
+                if(operation == SetSongs)
+                {
+                    item->m_songs.clear();
+                }
+                item->m_songs << songs;
+                return true;
+            }
+        case RemoveSongs:
+            {
+                TTKIntList rows;
+                stream >> rows;
+                ///rows are removed from the last one, check them in the same order
+                for(int i=rows.count() - 1, count = item->m_songs.count(); i>=0; --i, --count)
+                {
+                    if(rows[i] < 0 || rows[i] >= count)
+                    {
+                        return false;
+                    }
+                }
+
+                for(int i=rows.count() - 1; i>=0; --i)
+                {
+                    item->m_songs.removeAt(rows[i]);
+                }
+                return stream.status() == QDataStream::Ok;
+            }
+        case MoveSong:
+            {
+                qint32 before = 0, after = 0;
+                stream >> before >> after;
+                if(before < 0 || before >= item->m_songs.count() || after < 0 || after >= item->m_songs.count())
+                {
+                    return false;
+                }
+                item->m_songs.move(before, after);
+                return true;
+            }
+        case SetPlayCount:
+            {
+                qint32 row = 0, count = 0;
+                stream >> row >> count;
+                if(row < 0 || row >= item->m_songs.count())
+                {
+                    return false;
+                }
+                item->m_songs[row].setMusicPlayCount(count);
+                return true;
+            }
+        case RenameSong:
+            {
+                qint32 row = 0;
+                QString name;
+                stream >> row >> name;
+                if(stream.status() != QDataStream::Ok || row < 0 || row >= item->m_songs.count())
+                {
+                    return false;
+                }
+                item->m_songs[row].setMusicName(name);
+                return true;
+            }
+        case SetSort:
+            {
+                qint32 index = -1, type = 0;
+                stream >> index >> type;
+                item->m_sort.m_index = index;
+                item->m_sort.m_sortType = TTKStatic_cast(Qt::SortOrder, type);
+                return stream.status() == QDataStream::Ok;
+            }
+        case RemoveList:
+            {
+                items.removeAt(list);
+                return true;
+            }
+        case RenameList:
+            {
+                stream >> item->m_itemName;
+                return stream.status() == QDataStream::Ok;
+            }
+        case MoveList:
+            {
+                qint32 after = 0;
+                stream >> after;
+                if(after < 0 || after >= items.count())
+                {
+                    return false;
+                }
+                items.move(list, after);
+                return true;
+            }
+        default: return false;
+    }
+}
+
+bool MusicPlaylistJournal::open(qint64 base, bool truncate)
+{
+    m_file.close();
+    m_file.setFileName(MUSICJOURNALPATH_FULL);
+    m_base = base;
+    m_count = 0;
+
+    if(!m_file.open(truncate ? (QFile::WriteOnly | QFile::Truncate) : (QFile::WriteOnly | QFile::Append)))
+    {
+        return false;
+    }
+
+    if(truncate)
+    {
+        QDataStream stream(&m_file);
+        stream << quint32(TKPJ_MAGIC) << quint32(TKPJ_VERSION) << qint64(base);
+        m_file.flush();
+    }
+    return true;
+}
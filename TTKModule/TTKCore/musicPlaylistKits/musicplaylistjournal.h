@@ -0,0 +1,156 @@
+#ifndef MUSICPLAYLISTJOURNAL_H
+#define MUSICPLAYLISTJOURNAL_H
+
+/* =================================================
+ * This file is part of the TTK Music Player project
+ * Copyright (C) 2015 - 2020 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ================================================= */
+
+#include <QFile>
+#include <QTimer>
+#include <QFuture>
+#include "musicsong.h"
+#include "musicsingleton.h"
+
+#define PLAYLIST_JOURNAL_COMPACT_COUNT      512             // compact after these records
+#define PLAYLIST_JOURNAL_COMPACT_INTERVAL   (5 * MT_M2MS)   // compact the records at least so often
+
+/*! @brief The class of the playlist change journal.
+ * Every playlist change is appended as a small record instead of writing all lists,
+ * the records are replayed onto the tkpb snapshot on startup. The journal is compacted
+ * into a new snapshot in background, the old journal is kept until the snapshot replaced.
+ * @author Greedysky <greedysky@163.com>
+ */
+class MUSIC_CORE_EXPORT MusicPlaylistJournal : public QObject
+{
+    Q_OBJECT
+    TTK_DECLARE_MODULE(MusicPlaylistJournal)
+public:
+    enum Operation
+    {
+        AppendSongs = 1,    /*!< append songs to list*/
+        RemoveSongs,        /*!< remove songs of list by rows*/
+        MoveSong,           /*!< move song in list*/
+        SetSongs,           /*!< replace all songs of list*/
+        SetPlayCount,       /*!< set song play count*/
+        SetSort,            /*!< set list sort*/
+        AppendList,         /*!< append new list*/
+        RemoveList,         /*!< remove list*/
+        RenameList,         /*!< rename list*/
+        MoveList,           /*!< move list*/
+        RenameSong          /*!< rename song in list*/
+    };
+
+    /*!
+     * Replay journal records onto the snapshot items by snapshot generation.
+     * Return false when there is no snapshot to base the journal on.
+     */
+    bool replay(qint64 generation, MusicSongItems &items);
+    /*!
+     * Write items into new snapshot and start new journal.
+     * Write in background unless wait is true.
+     */
+    void compact(const MusicSongItems &items, bool wait = false);
+
+    /*!
+     * Append songs to list.
+     */
+    void appendSongs(int list, const MusicSongs &songs);
+    /*!
+     * Remove songs of list by rows.
+     */
+    void removeSongs(int list, const TTKIntList &rows);
+    /*!
+     * Move song in list.
+     */
+    void moveSong(int list, int before, int after);
+    /*!
+     * Replace all songs of list.
+     */
+    void setSongs(int list, const MusicSongs &songs);
+    /*!
+     * Set song play count.
+     */
+    void setPlayCount(int list, int row, int count);
+    /*!
+     * Rename song in list.
+     */
+    void renameSong(int list, int row, const QString &name);
+    /*!
+     * Set list sort.
+     */
+    void setSort(int list, const MusicSort &sort);
+    /*!
+     * Append new list.
+     */
+    void appendList(const QString &name, const MusicSongs &songs = MusicSongs());
+    /*!
+     * Remove list.
+     */
+    void removeList(int list);
+    /*!
+     * Rename list.
+     */
+    void renameList(int list, const QString &name);
+    /*!
+     * Move list.
+     */
+    void moveList(int before, int after);
+
+Q_SIGNALS:
+    /*!
+     * Journal records need to be compacted into snapshot.
+     */
+    void compactRequested();
+
+private:
+    /*!
+     * Object contsructor.
+     */
+    MusicPlaylistJournal();
+
+    ~MusicPlaylistJournal();
+
+    /*!
+     * Append record into journal.
+     */
+    void append(const QByteArray &record);
+    /*!
+     * Replay journal file records, return -1 when the journal is not based on generation.
+     */
+    int replay(const QString &path, qint64 generation, bool newer, MusicSongItems &items, qint64 *base, qint64 *end) const;
+    /*!
+     * Apply one record onto items.
+     */
+    bool apply(const QByteArray &record, MusicSongItems &items) const;
+    /*!
+     * Open journal file, start new one by base generation when truncate.
+     */
+    bool open(qint64 base, bool truncate);
+
+    QFile m_file;
+    QTimer m_timer;
+    qint64 m_base;
+    int m_count;
+    QFuture<bool> m_future;
+
+    DECLARE_SINGLETON_CLASS(MusicPlaylistJournal)
+};
+
+#define M_PLAYLIST_JOURNAL_PTR GetMusicPlaylistJournal()
+MUSIC_CORE_EXPORT MusicPlaylistJournal* GetMusicPlaylistJournal();
+
+#endif // MUSICPLAYLISTJOURNAL_H
@@ -0,0 +1,336 @@
+#include "musicplaylistsearchindex.h"
+
+#include <QTextCodec>
+#include <algorithm>
+
+#define GB2312_LEVEL1_FIRST     1601
+#define GB2312_LEVEL1_LAST      5589
+#define CJK_UNIFIED_FIRST       0x4E00
+#define CJK_UNIFIED_LAST        0x9FA5
+
+///first area position code of every pinyin initial in gb2312 level 1 characters
+static const int GB2312_INITIALS_POSITION[] = {
+    1601, 1637, 1833, 2078, 2274, 2302, 2433, 2594, 2787, 3106, 3212, 3472,
+    3635, 3722, 3730, 3858, 4027, 4086, 4390, 4558, 4684, 4925, 5249
+};
+static const char GB2312_INITIALS_LETTER[] = "abcdefghjklmnopqrstwxyz";
+
+static inline quint32 bigramKey(const QChar &first, const QChar &second)
+{
+    return (quint32(first.unicode()) << 16) | second.unicode();
+}
+
+static inline void appendId(QVector<int> &ids, int id)
+{
+    ///ids are inserted in ascending order, so the same entry is always the last
+    if(ids.isEmpty() || ids.last() != id)
+    {
+        ids.append(id);
+    }
+}
+
+MusicPlaylistSearchIndex::MusicPlaylistSearchIndex()
+{
+    m_dropped = 0;
+    m_ordered = true;
+    m_entryRowsValid = false;
+}
+
+void MusicPlaylistSearchIndex::reset(const MusicSongs &songs)
+{
+    m_entries.clear();
+    m_rows.clear();
+    m_chars.clear();
+    m_bigrams.clear();
+    m_dropped = 0;
+
+    m_entries.reserve(songs.count());
+    m_rows.reserve(songs.count());
+    append(songs);
+    changed(true);
+}
+
+void MusicPlaylistSearchIndex::append(const MusicSongs &songs)
+{
+    foreach(const MusicSong &song, songs)
+    {
+        const QString &key = foldText(song.getMusicName());
+        m_rows << insertEntry(key, initialsText(key));
+    }
+    changed(m_ordered);
+}
+
+void MusicPlaylistSearchIndex::remove(const TTKIntList &rows)
+{
+    if(rows.isEmpty())
+    {
+        return;
+    }
+
+    ///one pass over all rows instead of removing them one by one
+    QVector<int> alive;
+    alive.reserve(m_rows.count());
+    for(int i=0, index=0; i<m_rows.count(); ++i)
+    {
+        if(index < rows.count() && rows[index] == i)
+        {
+            m_entries[m_rows[i]].m_valid = false;
+            ++m_dropped;
+            ++index;
+        }
+        else
+        {
+            alive << m_rows[i];
+        }
+    }
+
+    m_rows = alive;
+    changed(m_ordered);
+    compact();
+}
+
+void MusicPlaylistSearchIndex::move(int before, int after)
+{
+    if(before == after || before < 0 || after < 0 || before >= m_rows.count() || after >= m_rows.count())
+    {
+        return;
+    }
+
+    const int id = m_rows[before];
+    m_rows.remove(before);
+    m_rows.insert(after, id);
+    changed(false);
+}
+
+void MusicPlaylistSearchIndex::rename(int row, const QString &name)
+{
+    if(row < 0 || row >= m_rows.count())
+    {
+        return;
+    }
+
+    m_entries[m_rows[row]].m_valid = false;
+    ++m_dropped;
+
+    const QString &key = foldText(name);
+    m_rows[row] = insertEntry(key, initialsText(key));
+    changed(false);
+    compact();
+}
+
+TTKIntList MusicPlaylistSearchIndex::search(const QString &text)
+{
+    TTKIntList rows;
+    const QString &key = foldText(text);
+    if(key.isEmpty())
+    {
+        m_lastKey.clear();
+        m_lastIds.clear();
+        for(int i=0; i<m_rows.count(); ++i)
+        {
+            rows << i;
+        }
+        return rows;
+    }
+
+    const bool refine = !m_lastKey.isEmpty() && key.contains(m_lastKey);
+    const QVector<int> *candidates = refine ? &m_lastIds : findCandidates(key);
+
+    QVector<int> ids;
+    if(candidates)
+    {
+        foreach(int id, *candidates)
+        {
+            const Entry &entry = m_entries[id];
+            if(entry.m_valid && (entry.m_key.contains(key) || entry.m_initials.contains(key)))
+            {
+                ids << id;
+            }
+        }
+    }
+    m_lastKey = key;
+    m_lastIds = ids;
+
+    if(!m_entryRowsValid)
+    {
+        m_entryRows.fill(-1, m_entries.count());
+        for(int i=0; i<m_rows.count(); ++i)
+        {
+            m_entryRows[m_rows[i]] = i;
+        }
+        m_entryRowsValid = true;
+    }
+
+    rows.reserve(ids.count());
+    foreach(int id, ids)
+    {
+        rows << m_entryRows[id];
+    }
+
+    ///ids follow rows until songs are moved or renamed
+    if(!m_ordered)
+    {
+        std::sort(rows.begin(), rows.end());
+    }
+    return rows;
+}
+
+QString MusicPlaylistSearchIndex::foldText(const QString &text)
+{
+    bool ascii = true;
+    foreach(const QChar &c, text)
+    {
+        if(c.unicode() >= 0x80)
+        {
+            ascii = false;
+            break;
+        }
+    }
+
+    if(ascii)
+    {
+        return text.toLower();
+    }
+
+    ///decompose the characters and drop the combining marks
+    const QString &normalized = text.normalized(QString::NormalizationForm_KD);
+    QString folded;
+    folded.reserve(normalized.length());
+    foreach(const QChar &c, normalized)
+    {
+        if(c.category() != QChar::Mark_NonSpacing)
+        {
+            folded.append(c.toCaseFolded());
+        }
+    }
+    return folded;
+}
+
+QString MusicPlaylistSearchIndex::initialsText(const QString &text)
+{
+    ///the codec lookup walks the codec list under a lock, do it once
+    static QTextCodec *codec = QTextCodec::codecForName("GBK");
+    if(!codec)
+    {
+        return QString();
+    }
+
+    bool found = false;
+    QString initials(text);
+    for(int i=0; i<initials.length(); ++i)
+    {
+        const ushort u = initials[i].unicode();
+        if(u < CJK_UNIFIED_FIRST || u > CJK_UNIFIED_LAST)
+        {
+            continue;
+        }
+
+        const QByteArray &bytes = codec->fromUnicode(initials.constData() + i, 1);
+        if(bytes.length() != 2)
+        {
+            continue;
+        }
+
+        const int code = (uchar(bytes[0]) - 160) * 100 + (uchar(bytes[1]) - 160);
+        if(code < GB2312_LEVEL1_FIRST || code > GB2312_LEVEL1_LAST)
+        {
+            continue;
+        }
+
+        int index = sizeof(GB2312_INITIALS_POSITION) / sizeof(int) - 1;
+        while(index > 0 && code < GB2312_INITIALS_POSITION[index])
+        {
+            --index;
+        }
+        initials[i] = QChar(GB2312_INITIALS_LETTER[index]);
+        found = true;
+    }
+    return found ? initials : QString();
+}
+
+int MusicPlaylistSearchIndex::insertEntry(const QString &key, const QString &initials)
+{
+    const int id = m_entries.count();
+    Entry entry;
+    entry.m_key = key;
+    entry.m_initials = initials;
+    entry.m_valid = true;
+    m_entries << entry;
+
+    insertGrams(key, id);
+    insertGrams(initials, id);
+    return id;
+}
+
+void MusicPlaylistSearchIndex::insertGrams(const QString &text, int id)
+{
+    for(int i=0; i<text.length(); ++i)
+    {
+        appendId(m_chars[text[i].unicode()], id);
+        if(i + 1 < text.length())
+        {
+            appendId(m_bigrams[bigramKey(text[i], text[i + 1])], id);
+        }
+    }
+}
+
+const QVector<int>* MusicPlaylistSearchIndex::findCandidates(const QString &key) const
+{
+    if(key.length() == 1)
+    {
+        QHash<quint32, QVector<int> >::const_iterator it = m_chars.constFind(key[0].unicode());
+        return it != m_chars.constEnd() ? &it.value() : nullptr;
+    }
+
+    ///every bigram of key must be in the entry, so the rarest one bounds the candidates
+    const QVector<int> *candidates = nullptr;
+    for(int i=0; i<key.length() - 1; ++i)
+    {
+        QHash<quint32, QVector<int> >::const_iterator it = m_bigrams.constFind(bigramKey(key[i], key[i + 1]));
+        if(it == m_bigrams.constEnd())
+        {
+            return nullptr;
+        }
+
+        if(!candidates || it.value().count() < candidates->count())
+        {
+            candidates = &it.value();
+        }
+    }
+    return candidates;
+}
+
+void MusicPlaylistSearchIndex::changed(bool ordered)
+{
+    m_ordered = ordered;
+    m_entryRowsValid = false;
+    m_lastKey.clear();
+    m_lastIds.clear();
+}
+
+void MusicPlaylistSearchIndex::compact()
+{
+    if(m_dropped <= m_rows.count())
+    {
+        return;
+    }
+
+    QVector<Entry> entries;
+    entries.reserve(m_rows.count());
+    foreach(int id, m_rows)
+    {
+        entries << m_entries[id];
+    }
+
+    m_entries.clear();
+    m_rows.clear();
+    m_chars.clear();
+    m_bigrams.clear();
+    m_dropped = 0;
+
+    foreach(const Entry &entry, entries)
+    {
+        m_rows << insertEntry(entry.m_key, entry.m_initials);
+    }
+    changed(true);
+}
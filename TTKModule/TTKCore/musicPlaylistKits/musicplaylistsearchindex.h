@@ -0,0 +1,119 @@
+#ifndef MUSICPLAYLISTSEARCHINDEX_H
+#define MUSICPLAYLISTSEARCHINDEX_H
+
+/* =================================================
+ * This file is part of the TTK Music Player project
+ * Copyright (C) 2015 - 2020 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ================================================= */
+
+#include "musicsong.h"
+
+/*! @brief The class of the playlist search index.
+ * Song names are folded to lower case without diacritics, chinese characters also
+ * get their pinyin initials. Both are indexed by characters and bigrams per list,
+ * the index follows list changes instead of being rebuilt on every search.
+ * @author Greedysky <greedysky@163.com>
+ */
+class MUSIC_CORE_EXPORT MusicPlaylistSearchIndex
+{
+    TTK_DECLARE_MODULE(MusicPlaylistSearchIndex)
+public:
+    /*!
+     * Object contsructor.
+     */
+    MusicPlaylistSearchIndex();
+
+    /*!
+     * Rebuild the index by songs.
+     */
+    void reset(const MusicSongs &songs);
+    /*!
+     * Append songs to the end of the index.
+     */
+    void append(const MusicSongs &songs);
+    /*!
+     * Remove songs by rows in ascending order.
+     */
+    void remove(const TTKIntList &rows);
+    /*!
+     * Move song from before row to after row.
+     */
+    void move(int before, int after);
+    /*!
+     * Update song name at row.
+     */
+    void rename(int row, const QString &name);
+    /*!
+     * Get indexed song count.
+     */
+    inline int count() const { return m_rows.count(); }
+
+    /*!
+     * Search rows whose song name matches the text, in ascending order.
+     * A query containing the previous one only refines the previous result.
+     */
+    TTKIntList search(const QString &text);
+
+    /*!
+     * Fold text to lower case without diacritics.
+     */
+    static QString foldText(const QString &text);
+    /*!
+     * Replace chinese characters of folded text by pinyin initials.
+     * Return empty string if there is no chinese character.
+     */
+    static QString initialsText(const QString &text);
+
+private:
+    /*!
+     * Insert folded entry and return its id.
+     */
+    int insertEntry(const QString &key, const QString &initials);
+    /*!
+     * Add characters and bigrams of text to entry id.
+     */
+    void insertGrams(const QString &text, int id);
+    /*!
+     * Get candidate ids of folded key.
+     */
+    const QVector<int>* findCandidates(const QString &key) const;
+    /*!
+     * Entries or rows changed, drop the cached state.
+     */
+    void changed(bool ordered);
+    /*!
+     * Rebuild all grams if dropped entries are more than alive ones.
+     */
+    void compact();
+
+    typedef struct Entry
+    {
+        QString m_key;
+        QString m_initials;
+        bool m_valid;
+    }Entry;
+
+    QVector<Entry> m_entries;
+    QVector<int> m_rows, m_entryRows;
+    QHash<quint32, QVector<int> > m_chars, m_bigrams;
+    int m_dropped;
+    bool m_ordered, m_entryRowsValid;
+    QString m_lastKey;
+    QVector<int> m_lastIds;
+
+};
+
+#endif // MUSICPLAYLISTSEARCHINDEX_H
@@ -0,0 +1,170 @@
+#include "musictkpbconfigmanager.h"
+#include "musicnumberutils.h"
+#include "musicfileutils.h"
+
+#include <QDataStream>
+#include <QFileInfo>
+#include <QDateTime>
+
+#define TKPB_MAGIC      0x544B5042
+#define TKPB_VERSION    2
+
+MusicTKPBConfigManager::MusicTKPBConfigManager()
+    : MusicPlaylistInterface()
+{
+    m_data = nullptr;
+    m_generation = 0;
+}
+
+MusicTKPBConfigManager::~MusicTKPBConfigManager()
+{
+    if(m_data)
+    {
+        m_file.unmap(m_data);
+    }
+    m_file.close();
+}
+
+bool MusicTKPBConfigManager::readConfig(const QString &name)
+{
+    m_file.setFileName(name);
+    if(!m_file.open(QFile::ReadOnly) || m_file.size() <= 0)
+    {
+        return false;
+    }
+
+    m_data = m_file.map(0, m_file.size());
+    return m_data != nullptr;
+}
+
+bool MusicTKPBConfigManager::readPlaylistData(MusicSongItems &items)
+{
+    if(!m_data)
+    {
+        return false;
+    }
+
+    ///no copy of the mapped data, pages are loaded when parsed
+    const QByteArray &data = QByteArray::fromRawData(TTKReinterpret_cast(const char*, m_data), m_file.size());
+    QDataStream stream(data);
+
+    quint32 magic = 0, version = 0, itemCount = 0;
+    qint64 generation = 0, modified = 0, size = 0;
+    stream >> magic >> version >> generation >> modified >> size >> itemCount;
+    if(magic != TKPB_MAGIC || version != TKPB_VERSION)
+    {
+        return false;
+    }
+
+    ///the tkpl file is changed by others after the snapshot written
+    const QFileInfo info(MUSICPATH_FULL);
+    if(info.exists() && (info.size() != size || info.lastModified().toMSecsSinceEpoch() != modified))
+    {
+        return false;
+    }
+
+    MusicSongItems snapshot;
+    for(quint32 i=0; i<itemCount && stream.status() == QDataStream::Ok; ++i)
+    {
+        MusicSongItem item;
+        qint32 index = 0, sortIndex = -1, sortType = 0;
+        quint32 songCount = 0;
+        stream >> item.m_itemName >> index >> sortIndex >> sortType >> songCount;
+        item.m_itemIndex = index;
+        item.m_sort.m_index = sortIndex;
+        item.m_sort.m_sortType = TTKStatic_cast(Qt::SortOrder, sortType);
+
+        item.m_songs.reserve(songCount);
+        for(quint32 j=0; j<songCount && stream.status() == QDataStream::Ok; ++j)
+        {
+            item.m_songs << readMusicSong(stream);
+        }
+        snapshot << item;
+    }
+
+    if(stream.status() != QDataStream::Ok)
+    {
+        return false;
+    }
+
+    items << snapshot;
+    m_generation = generation;
+    return true;
+}
+
+bool MusicTKPBConfigManager::writePlaylistData(const MusicSongItems &items)
+{
+    return writePlaylistData(items, MUSICSNAPSHOTPATH_FULL);
+}
+
+bool MusicTKPBConfigManager::writePlaylistData(const MusicSongItems &items, const QString &path)
+{
+    if(items.isEmpty())
+    {
+        return false;
+    }
+
+    ///the snapshot is bound to the tkpl file written before it
+    const QFileInfo info(MUSICPATH_FULL);
+    if(m_generation <= 0)
+    {
+        m_generation = QDateTime::currentMSecsSinceEpoch();
+    }
+
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream << quint32(TKPB_MAGIC) << quint32(TKPB_VERSION) << qint64(m_generation) << qint64(info.lastModified().toMSecsSinceEpoch())
+           << qint64(info.size()) << quint32(items.count());
+
+    for(int i=0; i<items.count(); ++i)
+    {
+        const MusicSongItem &item = items[i];
+        stream << item.m_itemName << qint32(i) << qint32(item.m_sort.m_index) << qint32(item.m_sort.m_sortType) << quint32(item.m_songs.count());
+        foreach(const MusicSong &song, item.m_songs)
+        {
+            writeMusicSong(stream, song);
+        }
+    }
+
+    if(stream.status() != QDataStream::Ok)
+    {
+        return false;
+    }
+
+    ///a mapped file can not be replaced on windows
+    if(m_data)
+    {
+        m_file.unmap(m_data);
+        m_data = nullptr;
+        m_file.close();
+    }
+    return MusicUtils::File::writeFileAtomic(path, data);
+}
+
+void MusicTKPBConfigManager::writeMusicSong(QDataStream &stream, const MusicSong &song)
+{
+    stream << song.getMusicPath() << song.getMusicName() << song.getMusicPlayTime() << song.getMusicType()
+           << qint32(song.getMusicPlayCount()) << qint64(song.getMusicSize()) << qint64(song.getMusicAddTime());
+}
+
+MusicSong MusicTKPBConfigManager::readMusicSong(QDataStream &stream)
+{
+    QString path, musicName, playTime, type;
+    qint32 playCount = 0;
+    qint64 musicSize = 0, addTime = 0;
+    stream >> path >> musicName >> playTime >> type >> playCount >> musicSize >> addTime;
+
+    ///build song from the snapshot values, the file is stat'ed when the song is shown
+    MusicSong song;
+    song.setMusicPath(path);
+    song.setMusicName(musicName);
+    song.setMusicPlayTime(playTime);
+    song.setMusicType(type);
+    song.setMusicPlayCount(playCount);
+    song.setMusicSize(musicSize);
+    song.setMusicSizeStr(MusicUtils::Number::size2Label(musicSize));
+    song.setMusicAddTime(addTime);
+    song.setMusicAddTimeStr(QString::number(addTime));
+    song.setMusicStatDeferred(true);
+    return song;
+}
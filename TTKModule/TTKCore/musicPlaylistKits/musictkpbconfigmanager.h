@@ -0,0 +1,86 @@
+#ifndef MUSICTKPBCONFIGMANAGER_H
+#define MUSICTKPBCONFIGMANAGER_H
+
+/* =================================================
+ * This file is part of the TTK Music Player project
+ * Copyright (C) 2015 - 2020 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ================================================= */
+
+#include "musicplaylistinterface.h"
+
+class QDataStream;
+
+/*! @brief The class of the tkpb binary playlist snapshot config manager.
+ * The snapshot is memory mapped on startup and keeps file size, type and add time,
+ * so loading needs no file stat. The tkpl file stays the import and export format.
+ * @author Greedysky <greedysky@163.com>
+ */
+class MUSIC_CORE_EXPORT MusicTKPBConfigManager : public MusicPlaylistInterface
+{
+    TTK_DECLARE_MODULE(MusicTKPBConfigManager)
+public:
+    /*!
+     * Object contsructor.
+     */
+    explicit MusicTKPBConfigManager();
+
+    ~MusicTKPBConfigManager();
+
+    /*!
+     * Map the snapshot file by given name.
+     * Return false when it is missing, broken or out of date with the tkpl file.
+     */
+    bool readConfig(const QString &name = MUSICSNAPSHOTPATH_FULL);
+
+    /*!
+     * Read datas from config file.
+     */
+    virtual bool readPlaylistData(MusicSongItems &items) override;
+    /*!
+     * Write music datas into snapshot file.
+     */
+    bool writePlaylistData(const MusicSongItems &items);
+    /*!
+     * Write datas into config file.
+     */
+    virtual bool writePlaylistData(const MusicSongItems &items, const QString &path) override;
+
+    /*!
+     * Set snapshot generation for writing.
+     */
+    inline void setGeneration(qint64 generation) { m_generation = generation; }
+    /*!
+     * Get snapshot generation, the playlist journal is based on it.
+     */
+    inline qint64 generation() const { return m_generation; }
+
+    /*!
+     * Write music song into data stream.
+     */
+    static void writeMusicSong(QDataStream &stream, const MusicSong &song);
+    /*!
+     * Read music song from data stream.
+     */
+    static MusicSong readMusicSong(QDataStream &stream);
+
+private:
+    QFile m_file;
+    uchar *m_data;
+    qint64 m_generation;
+
+};
+
+#endif // MUSICTKPBCONFIGMANAGER_H
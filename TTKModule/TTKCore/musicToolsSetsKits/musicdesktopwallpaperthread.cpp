@@ -4,7 +4,14 @@
 #include "musicextractwrap.h"
 
 #include <QTimer>
+#include <QBuffer>
 #include <QPixmap>
+#include <QImageReader>
+#ifdef TTK_GREATER_NEW
+#  include <QtConcurrent/QtConcurrent>
+#else
+#  include <QtConcurrentRun>
+#endif
 
 MusicDesktopWallpaperThread::MusicDesktopWallpaperThread(QObject *parent)
     : QObject(parent)
@@ -14,9 +21,13 @@ MusicDesktopWallpaperThread::MusicDesktopWallpaperThread(QObject *parent)
     m_run = false;
     m_random = false;
     m_currentImageIndex = 0;
+    m_nextImageIndex = -1;
     m_timer = new QTimer(this);
     connect(m_timer, SIGNAL(timeout()), SLOT(timeout()));
 
+    m_watcher = new QFutureWatcher<QImage>(this);
+    connect(m_watcher, SIGNAL(finished()), SLOT(loadImageFinished()));
+
     setInterval(20 * MT_S2MS);
 }
 
@@ -39,12 +50,57 @@ bool MusicDesktopWallpaperThread::isRunning() const
 void MusicDesktopWallpaperThread::setRandom(bool random)
 {
     m_random = random;
+    m_nextImageIndex = -1;
 }
+
 void MusicDesktopWallpaperThread::setImagePath(const QStringList &list)
 {
+    if(m_path != list)
+    {
+        m_nextImageIndex = -1;
+    }
     m_path = list;
 }
 
+void MusicDesktopWallpaperThread::setTargetSize(const QSize &size)
+{
+    if(m_size != size)
+    {
+        m_prefetchPath.clear();
+    }
+    m_size = size;
+}
+
+QImage MusicDesktopWallpaperThread::loadImage(const QString &path, const QSize &size)
+{
+    QByteArray data;
+    if(QFileInfo(path).suffix().toLower() == TTS_FILE_PREFIX)
+    {
+        MusicSkinConfigItem item;
+        MusicExtractWrap::outputSkin(data, &item, path);
+    }
+    else
+    {
+        QFile file(path);
+        if(file.open(QIODevice::ReadOnly))
+        {
+            data = file.readAll();
+            file.close();
+        }
+    }
+
+    QBuffer buffer(&data);
+    QImageReader reader(&buffer);
+    if(size.isValid())
+    {
+        reader.setScaledSize(size);
+    }
+
+    QImage image;
+    reader.read(&image);
+    return image;
+}
+
 #if defined Q_OS_WIN
 HWND MusicDesktopWallpaperThread::findDesktopIconWnd()
 {
@@ -88,9 +144,14 @@ void MusicDesktopWallpaperThread::timeout()
         return;
     }
 
+    QString path;
     if(!m_path.isEmpty())
     {
-        if(m_random) ///random mode
+        if(m_nextImageIndex >= 0 && m_nextImageIndex < m_path.size())
+        {
+            m_currentImageIndex = m_nextImageIndex;
+        }
+        else if(m_random) ///random mode
         {
             m_currentImageIndex = MusicTime::random(m_path.size());
         }
@@ -98,14 +159,57 @@ void MusicDesktopWallpaperThread::timeout()
         {
             m_currentImageIndex = 0;
         }
+        path = m_path[m_currentImageIndex];
+    }
+    else
+    {
+        path = M_BACKGROUND_PTR->getBackgroundUrl();
+    }
 
-        Q_EMIT updateBackground(QPixmap(m_path[m_currentImageIndex]));
+    ///use the prefetched image if it is the one to show
+    if(!m_prefetchPath.isEmpty() && m_prefetchPath == path)
+    {
+        m_watcher->setFuture(m_prefetch);
     }
     else
     {
-        MusicBackgroundImage image;
-        MusicExtractWrap::outputSkin(&image, M_BACKGROUND_PTR->getBackgroundUrl());
+        m_watcher->setFuture(QtConcurrent::run(MusicDesktopWallpaperThread::loadImage, path, m_size));
+    }
+
+    m_prefetchPath.clear();
+    m_nextImageIndex = -1;
+}
+
+void MusicDesktopWallpaperThread::loadImageFinished()
+{
+    const QImage &image = m_watcher->result();
+    if(!image.isNull())
+    {
+        Q_EMIT updateBackground(QPixmap::fromImage(image));
+    }
+
+    if(m_run)
+    {
+        prefetchImage();
+    }
+}
 
-        Q_EMIT updateBackground(image.m_pix);
+void MusicDesktopWallpaperThread::prefetchImage()
+{
+    if(m_path.isEmpty())
+    {
+        return;
     }
+
+    if(m_random) ///random mode
+    {
+        m_nextImageIndex = MusicTime::random(m_path.size());
+    }
+    else
+    {
+        m_nextImageIndex = (m_currentImageIndex + 1) % m_path.size();
+    }
+
+    m_prefetchPath = m_path[m_nextImageIndex];
+    m_prefetch = QtConcurrent::run(MusicDesktopWallpaperThread::loadImage, m_prefetchPath, m_size);
 }
@@ -19,6 +19,8 @@
  * with this program; If not, see <http://www.gnu.org/licenses/>.
  ================================================= */
 
+#include <QImage>
+#include <QFutureWatcher>
 #include "musicobject.h"
 #include "musicglobaldefine.h"
 
@@ -63,6 +65,15 @@ public:
      * Set image path.
      */
     void setImagePath(const QStringList &list);
+    /*!
+     * Set target size that images are scaled to.
+     */
+    void setTargetSize(const QSize &size);
+
+    /*!
+     * Decode image or skin file and scale it to size, thread safe.
+     */
+    static QImage loadImage(const QString &path, const QSize &size);
 
 #if defined Q_OS_WIN
     /*!
@@ -95,11 +106,26 @@ public Q_SLOTS:
      */
     void timeout();
 
+private Q_SLOTS:
+    /*!
+     * Current image decode finished.
+     */
+    void loadImageFinished();
+
 protected:
+    /*!
+     * Decode the next image in rotation on the worker pool.
+     */
+    void prefetchImage();
+
     bool m_run, m_random;
-    int m_currentImageIndex;
+    int m_currentImageIndex, m_nextImageIndex;
+    QSize m_size;
     QTimer *m_timer;
     QStringList m_path;
+    QString m_prefetchPath;
+    QFuture<QImage> m_prefetch;
+    QFutureWatcher<QImage> *m_watcher;
 
 };
 
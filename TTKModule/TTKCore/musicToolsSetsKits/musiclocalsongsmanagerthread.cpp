@@ -1,11 +1,98 @@
 #include "musiclocalsongsmanagerthread.h"
 #include "musicformats.h"
+#include "musicobject.h"
 #include "musicfileutils.h"
 
+#include <QDir>
+#include <QMutex>
+#include <QTimer>
+#include <QDateTime>
+#include <QDataStream>
+#include <QWaitCondition>
+#include <QFileSystemWatcher>
+#ifdef TTK_GREATER_NEW
+#  include <QtConcurrent/QtConcurrent>
+#else
+#  include <QtConcurrentRun>
+#endif
+#include <algorithm>
+
+#define DIR_CACHE_MAGIC     0x54544B4C
+#define DIR_CACHE_VERSION   1
+#define DIR_RACY_INTERVAL   2 * MT_S2MS
+#define BATCH_INTERVAL      100
+#define IDLE_INTERVAL       100
+#define WATCH_INTERVAL      MT_S2MS
+#define WATCH_MAX_COUNT     4096
+
+///dirs waiting to be read by one scan worker
+typedef struct MusicLocalSongsWorkQueue
+{
+    QMutex m_mutex;
+    QStringList m_dirs;
+}MusicLocalSongsWorkQueue;
+
+static bool takeDirectory(const QVector<MusicLocalSongsWorkQueue*> &queues, int index, QString &path)
+{
+    ///the owner takes the newest dir, depth first keeps its queue short
+    MusicLocalSongsWorkQueue *queue = queues[index];
+    {
+        QMutexLocker locker(&queue->m_mutex);
+        if(!queue->m_dirs.isEmpty())
+        {
+            path = queue->m_dirs.takeLast();
+            return true;
+        }
+    }
+
+    ///the others steal the oldest dir, which is the shallowest and holds the most work
+    for(int i=1; i<queues.count(); ++i)
+    {
+        queue = queues[(index + i) % queues.count()];
+        QMutexLocker locker(&queue->m_mutex);
+        if(!queue->m_dirs.isEmpty())
+        {
+            path = queue->m_dirs.takeFirst();
+            return true;
+        }
+    }
+    return false;
+}
+
+static inline int loadPending(const QAtomicInt &pending)
+{
+#if TTK_QT_VERSION_CHECK(5,0,0)
+    return pending.loadAcquire();
+#else
+    return pending;
+#endif
+}
+
+static bool isUnderDirectory(const QString &path, const QStringList &roots)
+{
+    foreach(const QString &root, roots)
+    {
+        if(path == root || path.startsWith(root.endsWith("/") ? root : root + "/"))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 MusicLocalSongsManagerThread::MusicLocalSongsManagerThread(QObject *parent)
     : MusicAbstractThread(parent)
 {
+    m_cacheLoaded = false;
 
+    m_watchTimer = new QTimer(this);
+    m_watchTimer->setSingleShot(true);
+    m_watchTimer->setInterval(WATCH_INTERVAL);
+    connect(m_watchTimer, SIGNAL(timeout()), SLOT(updateFileLists()));
+
+    m_watcher = new QFileSystemWatcher(this);
+    connect(m_watcher, SIGNAL(directoryChanged(QString)), SLOT(directoryChanged()));
+    connect(this, SIGNAL(finished()), SLOT(updateWatchDirs()));
 }
 
 void MusicLocalSongsManagerThread::setFindFilePath(const QString &path)
@@ -18,18 +105,287 @@ void MusicLocalSongsManagerThread::setFindFilePath(const QStringList &path)
     m_path = path;
 }
 
+void MusicLocalSongsManagerThread::directoryChanged()
+{
+    ///changes come in bursts, rescan once they settle down
+    m_watchTimer->start();
+}
+
+void MusicLocalSongsManagerThread::updateFileLists()
+{
+    if(isRunning())
+    {
+        m_watchTimer->start();
+        return;
+    }
+
+    TTK_LOGGER_INFO("watched dirs changed, refetch");
+    start();
+}
+
+void MusicLocalSongsManagerThread::updateWatchDirs()
+{
+    ///a newer scan is running, it updates the dirs when finished
+    if(isRunning())
+    {
+        return;
+    }
+
+    const QStringList &dirs = m_watcher->directories();
+    if(!dirs.isEmpty())
+    {
+        m_watcher->removePaths(dirs);
+    }
+
+    if(!m_watchDirs.isEmpty())
+    {
+        m_watcher->addPaths(m_watchDirs);
+    }
+}
+
 void MusicLocalSongsManagerThread::run()
 {
     MusicAbstractThread::run();
 
-    QFileInfoList list;
+    const QStringList &filter = MusicFormats::supportFormatsFilterString();
+    loadDirCache(filter);
+
+    const int count = qMax(1, QThread::idealThreadCount());
+    QVector<MusicLocalSongsWorkQueue*> queues;
+    for(int i=0; i<count; ++i)
+    {
+        queues << new MusicLocalSongsWorkQueue;
+    }
+
+    QStringList roots;
+    QAtomicInt pending;
     foreach(const QString &path, m_path)
     {
-        if(m_running)
+        const QDir dir(path);
+        if(dir.exists())
+        {
+            roots << dir.absolutePath();
+            queues[pending.fetchAndAddOrdered(1) % count]->m_dirs << roots.last();
+        }
+    }
+
+    QMutex mutex, idleMutex;
+    QWaitCondition idleCondition;
+    QFileInfoList batch;
+    QHash<QString, MusicLocalSongsDirCache> caches;
+
+    QList< QFuture<void> > futures;
+    for(int i=0; i<count; ++i)
+    {
+        futures << QtConcurrent::run([&, i]()
+        {
+            QHash<QString, MusicLocalSongsDirCache> visited;
+            while(m_running)
+            {
+                QString path;
+                if(!takeDirectory(queues, i, path))
+                {
+                    ///every wake is sent with the idle mutex held, so looking again under it misses none,
+                    ///the timeout notices a stop
+                    QMutexLocker locker(&idleMutex);
+                    if(loadPending(pending) == 0)
+                    {
+                        break;
+                    }
+
+                    if(!takeDirectory(queues, i, path))
+                    {
+                        idleCondition.wait(&idleMutex, IDLE_INTERVAL);
+                        continue;
+                    }
+                }
+
+                const MusicLocalSongsDirCache &cache = readDirectory(path, filter);
+                if(!cache.m_dirs.isEmpty())
+                {
+                    ///count the sub dirs before this dir is done, so pending never drops to zero too early
+                    pending.fetchAndAddOrdered(cache.m_dirs.count());
+                    queues[i]->m_mutex.lock();
+                    queues[i]->m_dirs << cache.m_dirs;
+                    queues[i]->m_mutex.unlock();
+
+                    QMutexLocker locker(&idleMutex);
+                    idleCondition.wakeAll();
+                }
+
+                if(!cache.m_files.isEmpty())
+                {
+                    QFileInfoList files;
+                    foreach(const QString &file, cache.m_files)
+                    {
+                        files << QFileInfo(file);
+                    }
+
+                    QMutexLocker locker(&mutex);
+                    batch << files;
+                }
+
+                visited.insert(path, cache);
+                if(!pending.deref())
+                {
+                    QMutexLocker locker(&idleMutex);
+                    idleCondition.wakeAll();
+                }
+            }
+
+            QMutexLocker locker(&mutex);
+            for(QHash<QString, MusicLocalSongsDirCache>::const_iterator it = visited.constBegin(); it != visited.constEnd(); ++it)
+            {
+                caches.insert(it.key(), it.value());
+            }
+        });
+    }
+
+    ///send the files found so far in batches, the full list keeps the same order
+    QFileInfoList list;
+    while(true)
+    {
+        bool finished = true;
+        for(int i=0; i<futures.count(); ++i)
+        {
+            finished = finished && futures[i].isFinished();
+        }
+
+        QFileInfoList files;
+        mutex.lock();
+        files = batch;
+        batch.clear();
+        mutex.unlock();
+
+        if(!files.isEmpty())
+        {
+            list << files;
+            Q_EMIT appendSongNamePath(files);
+        }
+
+        if(finished)
+        {
+            break;
+        }
+        msleep(BATCH_INTERVAL);
+    }
+    qDeleteAll(queues);
+
+    if(!m_running)
+    {
+        ///the scan is stopped, the visited dirs are only a part of the tree
+        m_watchDirs.clear();
+        return;
+    }
+
+    ///the dirs not visited under the roots are removed from disk
+    for(QHash<QString, MusicLocalSongsDirCache>::iterator it = m_caches.begin(); it != m_caches.end(); )
+    {
+        if(isUnderDirectory(it.key(), roots))
+        {
+            it = m_caches.erase(it);
+        }
+        else
         {
-            list << MusicUtils::File::getFileListByDir(path, MusicFormats::supportFormatsFilterString(), true);
+            ++it;
         }
     }
+
+    QVector< QPair<int, QString> > depths;
+    depths.reserve(caches.count());
+    for(QHash<QString, MusicLocalSongsDirCache>::const_iterator it = caches.constBegin(); it != caches.constEnd(); ++it)
+    {
+        m_caches.insert(it.key(), it.value());
+        depths << QPair<int, QString>(it.key().count("/"), it.key());
+    }
+    saveDirCache(filter);
+
+    ///inotify watches are limited per user, keep the shallow dirs first
+    std::sort(depths.begin(), depths.end());
+    m_watchDirs.clear();
+    for(int i=0; i<depths.count() && i<WATCH_MAX_COUNT; ++i)
+    {
+        m_watchDirs << depths[i].second;
+    }
+
     ///The name and path search ended when sending the corresponding
     Q_EMIT setSongNamePath(list);
 }
+
+MusicLocalSongsDirCache MusicLocalSongsManagerThread::readDirectory(const QString &path, const QStringList &filter) const
+{
+    ///the dir mtime changes only when its own entries change, so every dir still needs a stat
+    const qint64 modified = QFileInfo(path).lastModified().toMSecsSinceEpoch();
+    const QHash<QString, MusicLocalSongsDirCache>::const_iterator it = m_caches.constFind(path);
+    if(it != m_caches.constEnd() && it->m_modified == modified)
+    {
+        return it.value();
+    }
+
+    MusicLocalSongsDirCache cache;
+    ///the dir may change again in the same time slice, never trust a fresh mtime
+    if(QDateTime::currentMSecsSinceEpoch() - modified > DIR_RACY_INTERVAL)
+    {
+        cache.m_modified = modified;
+    }
+
+    const QDir dir(path);
+    foreach(const QString &name, dir.entryList(filter, QDir::Files | QDir::Hidden | QDir::NoSymLinks))
+    {
+        cache.m_files << dir.absoluteFilePath(name);
+    }
+
+    foreach(const QString &name, dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot))
+    {
+        cache.m_dirs << dir.absoluteFilePath(name);
+    }
+    return cache;
+}
+
+void MusicLocalSongsManagerThread::loadDirCache(const QStringList &filter)
+{
+    if(m_cacheLoaded)
+    {
+        return;
+    }
+
+    m_cacheLoaded = true;
+    QFile file(LOCALSCANPATH_FULL);
+    if(!file.open(QFile::ReadOnly))
+    {
+        return;
+    }
+
+    QDataStream stream(&file);
+    quint32 magic = 0, version = 0, count = 0;
+    QStringList filters;
+    stream >> magic >> version >> filters >> count;
+    ///the cached files are only valid for the same formats
+    if(magic != DIR_CACHE_MAGIC || version != DIR_CACHE_VERSION || filters != filter)
+    {
+        return;
+    }
+
+    m_caches.reserve(count);
+    for(quint32 i=0; i<count && stream.status() == QDataStream::Ok; ++i)
+    {
+        QString path;
+        MusicLocalSongsDirCache cache;
+        stream >> path >> cache.m_modified >> cache.m_files >> cache.m_dirs;
+        m_caches.insert(path, cache);
+    }
+}
+
+void MusicLocalSongsManagerThread::saveDirCache(const QStringList &filter) const
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream << quint32(DIR_CACHE_MAGIC) << quint32(DIR_CACHE_VERSION) << filter << quint32(m_caches.count());
+    for(QHash<QString, MusicLocalSongsDirCache>::const_iterator it = m_caches.constBegin(); it != m_caches.constEnd(); ++it)
+    {
+        stream << it.key() << it->m_modified << it->m_files << it->m_dirs;
+    }
+
+    ///replace old cache only when the new one is completely written
+    MusicUtils::File::writeFileAtomic(LOCALSCANPATH_FULL, data);
+}
@@ -22,6 +22,24 @@
 #include <QFileInfoList>
 #include "musicabstractthread.h"
 
+class QTimer;
+class QFileSystemWatcher;
+
+/*! @brief The class of the local songs dir cache item.
+ * @author Greedysky <greedysky@163.com>
+ */
+typedef struct MUSIC_TOOLSET_EXPORT MusicLocalSongsDirCache
+{
+    qint64 m_modified;
+    QStringList m_files;
+    QStringList m_dirs;
+
+    MusicLocalSongsDirCache()
+    {
+        m_modified = -1;
+    }
+}MusicLocalSongsDirCache;
+
 /*! @brief The class of the local songs manager thread.
  * @author Greedysky <greedysky@163.com>
  */
@@ -45,19 +63,54 @@ public:
     void setFindFilePath(const QStringList &path);
 
 Q_SIGNALS:
+    /*!
+     * Send the part of files searched so far.
+     */
+    void appendSongNamePath(const QFileInfoList &name);
     /*!
      * Send the searched file or path.
      */
     void setSongNamePath(const QFileInfoList &name);
 
+private Q_SLOTS:
+    /*!
+     * Watched directory changed.
+     */
+    void directoryChanged();
+    /*!
+     * Rescan the changed directories.
+     */
+    void updateFileLists();
+    /*!
+     * Watch the directories of the last scan.
+     */
+    void updateWatchDirs();
+
 protected:
     /*!
      * Thread run now.
      */
     virtual void run() override;
+    /*!
+     * List the files and sub dirs of given dir, reuse the cache if the dir is unchanged.
+     */
+    MusicLocalSongsDirCache readDirectory(const QString &path, const QStringList &filter) const;
+    /*!
+     * Load the dir cache from disk.
+     */
+    void loadDirCache(const QStringList &filter);
+    /*!
+     * Save the dir cache to disk.
+     */
+    void saveDirCache(const QStringList &filter) const;
 
 protected:
     QStringList m_path;
+    QStringList m_watchDirs;
+    bool m_cacheLoaded;
+    QHash<QString, MusicLocalSongsDirCache> m_caches;
+    QTimer *m_watchTimer;
+    QFileSystemWatcher *m_watcher;
 
 };
 
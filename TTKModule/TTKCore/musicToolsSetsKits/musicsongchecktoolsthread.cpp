@@ -31,7 +31,7 @@ void MusicSongCheckToolsRenameThread::run()
                     return;
                 }
 
-                if(!tag.read(song.getMusicPath()))
+                if(!tag.read(song.getMusicPath(), false))
                 {
                     continue;
                 }
@@ -94,7 +94,7 @@ void MusicSongCheckToolsDuplicateThread::run()
                     return;
                 }
 
-                if(!tag.read(song.getMusicPath()))
+                if(!tag.read(song.getMusicPath(), false))
                 {
                     continue;
                 }
@@ -149,7 +149,7 @@ void MusicSongCheckToolsQualityThread::run()
                 return;
             }
 
-            if(!tag.read(song.getMusicPath()))
+            if(!tag.read(song.getMusicPath(), false))
             {
                 continue;
             }
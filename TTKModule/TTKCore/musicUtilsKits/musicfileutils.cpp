@@ -2,6 +2,13 @@
 #include "musicwidgetheaders.h"
 
 #include <QDirIterator>
+#if TTK_QT_VERSION_CHECK(5,1,0)
+#  include <QSaveFile>
+#elif defined Q_OS_WIN
+#  include <qt_windows.h>
+#else
+#  include <stdio.h>
+#endif
 
 quint64 MusicUtils::File::dirSize(const QString &dirName)
 {
@@ -124,6 +131,42 @@ bool MusicUtils::File::removeRecursively(const QString &dir)
     return success;
 }
 
+bool MusicUtils::File::writeFileAtomic(const QString &path, const QByteArray &data)
+{
+#if TTK_QT_VERSION_CHECK(5,1,0)
+    QSaveFile file(path);
+    if(!file.open(QFile::WriteOnly))
+    {
+        return false;
+    }
+
+    file.write(data);
+    return file.commit();
+#else
+    const QString &temp = path + ".tmp";
+    QFile file(temp);
+    if(!file.open(QFile::WriteOnly))
+    {
+        return false;
+    }
+
+    const bool written = file.write(data) == data.size() && file.flush();
+    file.close();
+    if(!written)
+    {
+        QFile::remove(temp);
+        return false;
+    }
+
+    ///replace the old file in one step, a crash leaves either the old or the new one
+#  ifdef Q_OS_WIN
+    return MoveFileExW(TTKReinterpret_cast(LPCWSTR, temp.utf16()), TTKReinterpret_cast(LPCWSTR, path.utf16()), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+#  else
+    return ::rename(QFile::encodeName(temp).constData(), QFile::encodeName(path).constData()) == 0;
+#  endif
+#endif
+}
+
 QString MusicUtils::File::getOpenFileDialog(QWidget *obj, const QString &title, const QString &filter)
 {
     return QFileDialog::getOpenFileName(obj, title, QDir::currentPath(), filter);
@@ -49,6 +49,10 @@ namespace MusicUtils
          * Dir remove recursively.
          */
         MUSIC_UTILS_EXPORT bool removeRecursively(const QString &dir);
+        /*!
+         * Write data to file, the old file is replaced only when the new one is completely written.
+         */
+        MUSIC_UTILS_EXPORT bool writeFileAtomic(const QString &path, const QByteArray &data);
 
         /*!
          * Get open file dialog.
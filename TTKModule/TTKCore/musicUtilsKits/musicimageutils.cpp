@@ -1,11 +1,21 @@
 #include "musicimageutils.h"
 #include "musicobject.h"
 #include "qalg/qimagewrap.h"
+#include "qalg/qparallelwrap.h"
 
 #include <QBitmap>
 #include <QBuffer>
 #include <QPainter>
 
+#define IMAGE_THREAD_PIXELS     (512 * 512)
+#define GAUSS_BOX_RADIUS        8
+
+///get the 32 bit format that keeps image alpha
+static QImage::Format rgbFormat(const QImage &image)
+{
+    return image.hasAlphaChannel() ? QImage::Format_ARGB32 : QImage::Format_RGB32;
+}
+
 QPixmap MusicUtils::Image::pixmapToRound(const QPixmap &input, int ratioX, int ratioY)
 {
     return pixmapToRound(input, QRect(QPoint(0, 0), input.size()), ratioX, ratioY);
@@ -99,27 +109,48 @@ void MusicUtils::Image::fusionPixmap(QImage &back, const QImage &front, const QP
 QPixmap MusicUtils::Image::grayScalePixmap(const QPixmap &input, int radius)
 {
     QImage pix = input.toImage();
-    for(int w=0; w<pix.width(); w++)
+    pix = pix.convertToFormat(rgbFormat(pix));
+
+    uchar table[256];
+    for(int i=0; i<256; ++i)
     {
-        for(int h=0; h<pix.height(); h++)
+        table[i] = qBound(0, i + radius, 255);
+    }
+
+    const int width = pix.width(), bytes = pix.bytesPerLine();
+    uchar *bits = pix.bits();
+    QParallelWrap::render(pix.height(), width * pix.height(), IMAGE_THREAD_PIXELS, [&](int from, int to)
+    {
+        for(int h=from; h<to; ++h)
         {
-            int gray = qGray(pix.pixel(w, h)) + radius;
-                gray = qBound(0, gray, 255);
-            const QRgb rgb = qRgb(gray, gray, gray);
-            pix.setPixel(w, h, rgb);
+            QRgb *line = TTKReinterpret_cast(QRgb*, bits + h * bytes);
+            for(int w=0; w<width; ++w)
+            {
+                const int gray = table[qGray(line[w])];
+                line[w] = qRgb(gray, gray, gray);
+            }
         }
-    }
+    });
     return QPixmap::fromImage(pix);
 }
 
 int MusicUtils::Image::grayScaleAverage(const QImage &input, int width, int height)
 {
-    int average = 0;
-    for(int w=0; w<width; w++)
+    const QImage &pix = input.convertToFormat(rgbFormat(input));
+    width = qMin(width, pix.width());
+    height = qMin(height, pix.height());
+    if(width <= 0 || height <= 0)
+    {
+        return 0;
+    }
+
+    qint64 average = 0;
+    for(int h=0; h<height; ++h)
     {
-        for(int h=0; h<height; h++)
+        const QRgb *line = TTKReinterpret_cast(const QRgb*, pix.constScanLine(h));
+        for(int w=0; w<width; ++w)
         {
-            average += qBound(0, qGray(input.pixel(w, h)), 255);
+            average += qGray(line[w]);
         }
     }
     return average / (width * height);
@@ -135,6 +166,8 @@ QImage MusicUtils::Image::gaussPixmap(const QImage &input, int radius)
 void MusicUtils::Image::gaussPixmap(QImage &input, int radius)
 {
     QImageWrap::QGaussBlur wrap;
+    ///exact kernel cost grows with radius, large ones go to box approximation
+    wrap.setMode(radius > GAUSS_BOX_RADIUS ? QImageWrap::QGaussBlur::Box : QImageWrap::QGaussBlur::Exact);
     wrap.render((int*)input.bits(), input.width(), input.height(), radius);
 }
 
@@ -145,16 +178,34 @@ int MusicUtils::Image::reRenderAlpha(int alpha, int value)
 
 void MusicUtils::Image::reRenderImage(int delta, const QImage *input, QImage *output)
 {
-    for(int w=0; w<input->width(); w++)
+    if(input->isNull())
     {
-        for(int h=0; h<input->height(); h++)
+        return;
+    }
+
+    ///same format of the same image keeps the data, so render in place
+    *output = input->convertToFormat(rgbFormat(*input));
+
+    uchar table[256];
+    for(int i=0; i<256; ++i)
+    {
+        table[i] = colorBurnTransform(i, delta);
+    }
+
+    const int width = output->width(), bytes = output->bytesPerLine();
+    uchar *bits = output->bits();
+    QParallelWrap::render(output->height(), width * output->height(), IMAGE_THREAD_PIXELS, [&](int from, int to)
+    {
+        for(int h=from; h<to; ++h)
         {
-            const QRgb rgb = input->pixel(w, h);
-            output->setPixel(w, h, qRgb(colorBurnTransform(qRed(rgb), delta),
-                                        colorBurnTransform(qGreen(rgb), delta),
-                                        colorBurnTransform(qBlue(rgb), delta)));
+            QRgb *line = TTKReinterpret_cast(QRgb*, bits + h * bytes);
+            for(int w=0; w<width; ++w)
+            {
+                const QRgb rgb = line[w];
+                line[w] = qRgb(table[qRed(rgb)], table[qGreen(rgb)], table[qBlue(rgb)]);
+            }
         }
-    }
+    });
 }
 
 int MusicUtils::Image::colorBurnTransform(int c, int delta)
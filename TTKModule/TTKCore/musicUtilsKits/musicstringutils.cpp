@@ -120,7 +120,7 @@ QString MusicUtils::String::artistName(const QString &value, const QString &key)
     const QStringList &s = stringSplit(value);
     if(s.count() >= 2)
     {
-        if(M_SETTING_PTR->value(MusicSettingManager::OtherSongFormat).toInt() == 0)
+        if(M_SETTING_PTR->intValue(MusicSettingManager::OtherSongFormat) == 0)
         {
             const int index = value.indexOf(key);
             return value.left(index).trimmed();
@@ -139,7 +139,7 @@ QString MusicUtils::String::songName(const QString &value, const QString &key)
     const QStringList &s = stringSplit(value);
     if(s.count() >= 2)
     {
-        if(M_SETTING_PTR->value(MusicSettingManager::OtherSongFormat).toInt() == 0)
+        if(M_SETTING_PTR->intValue(MusicSettingManager::OtherSongFormat) == 0)
         {
             const int index = value.indexOf(key) + 1;
             return value.right(value.length() - index).trimmed();
@@ -40,12 +40,8 @@ void MusicAbstractSongsListTableWidget::selectRow(int index)
 
 int MusicAbstractSongsListTableWidget::allRowsHeight() const
 {
-    int height = 0;
-    for(int i=0; i<rowCount(); ++i)
-    {
-        height += rowHeight(i);
-    }
-    return height;
+    ///the header keeps the sum of section sizes, no need to walk every row
+    return verticalHeader()->length();
 }
 
 void MusicAbstractSongsListTableWidget::setParentToolIndex(int index)
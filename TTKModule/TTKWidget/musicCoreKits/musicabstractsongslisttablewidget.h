@@ -94,7 +94,7 @@ public Q_SLOTS:
     /*!
      * Open music file information widget.
      */
-    void musicFileInformation();
+    virtual void musicFileInformation();
     /*!
      * To search song mv by song name.
      */
@@ -54,6 +54,20 @@ qint64 MusicLrcContainer::getTotalTime() const
     return m_totalTime;
 }
 
+void MusicLrcContainer::startLrcMask(MusicLrcManager *manager, qint64 intervaltime) const
+{
+    qint64 start = 0;
+    MusicLrcWords words;
+    if(m_lrcAnalysis && m_lrcAnalysis->findWords(m_currentTime, start, words))
+    {
+        manager->startLrcMask(start, intervaltime, words);
+    }
+    else
+    {
+        manager->startLrcMask(intervaltime);
+    }
+}
+
 void MusicLrcContainer::currentLrcCustom()
 {
     Q_EMIT changeCurrentLrcColorCustom();
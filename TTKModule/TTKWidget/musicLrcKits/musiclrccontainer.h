@@ -158,6 +158,10 @@ protected:
      * Set setting parameter by diff type.
      */
     void applySettingParameter(const QString &t);
+    /*!
+     * Start lrc mask of current line by the play position and word timings.
+     */
+    void startLrcMask(MusicLrcManager *manager, qint64 intervaltime) const;
 
     bool m_linkLocalLrc;
     qint64 m_currentTime, m_totalTime;
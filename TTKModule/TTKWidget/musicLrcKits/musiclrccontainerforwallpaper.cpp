@@ -120,6 +120,7 @@ void MusicLrcContainerForWallpaper::start(bool immediate)
     if(m_wallThread)
     {
         m_wallThread->setImagePath(M_BACKGROUND_PTR->getArtistPhotoPathList());
+        m_wallThread->setTargetSize(M_SETTING_PTR->value(MusicSettingManager::ScreenSize).toSize());
 
         if(!m_wallThread->isRunning())
         {
@@ -152,7 +153,7 @@ void MusicLrcContainerForWallpaper::updateAnimationLrc()
     {
         m_musicLrcContainer[i]->setText(m_lrcAnalysis->getText(i - length));
     }
-    m_musicLrcContainer[MUSIC_LRC_INTERIOR_MAX_LINE / 2]->startLrcMask(m_animationFreshTime);
+    startLrcMask(m_musicLrcContainer[MUSIC_LRC_INTERIOR_MAX_LINE / 2], m_animationFreshTime);
 }
 
 void MusicLrcContainerForWallpaper::initCurrentLrc(const QString &str)
@@ -1,4 +1,5 @@
 #include "musiclrcmanager.h"
+#include "musicapplication.h"
 #include "musicwidgetutils.h"
 
 #include <QFile>
@@ -139,6 +140,11 @@ MusicLrcManager::MusicLrcManager(QWidget *parent)
     m_lrcMaskWidthInterval = 0;
     m_speedLevel = 1;
     m_transparent = 100;
+    m_lrcStartTime = -1;
+    m_lrcIntervalTime = 0;
+    m_frameCount = 0;
+    m_frameTime = 0;
+    m_lastFrameTime = 0;
 
     m_timer = new QTimer(this);
     connect(m_timer, SIGNAL(timeout()), SLOT(setUpdateMask()));
@@ -170,12 +176,14 @@ void MusicLrcManager::setFontFamily(int index)
         }
         m_font.setFamily(family[index]);
     }
+    invalidateLrcLayer();
 }
 
 void MusicLrcManager::setFontType(int type)
 {
     m_font.setBold((type == 1 || type == 3));
     m_font.setItalic((type == 2 || type == 3));
+    invalidateLrcLayer();
 }
 
 void MusicLrcManager::setSelfGeometry(const QPoint &point)
@@ -228,12 +236,23 @@ void MusicLrcManager::setLrcFontSize(int size)
 }
 
 void MusicLrcManager::startLrcMask(qint64 intervaltime)
+{
+    m_elapsedTimer.start();
+    startLrcMask(-1, intervaltime, MusicLrcWords());
+}
+
+void MusicLrcManager::startLrcMask(qint64 start, qint64 intervaltime, const MusicLrcWords &words)
 {
     m_intervalCount = 0.0f;
     m_geometry.setX(MusicUtils::Widget::fontTextWidth(m_font, text()));
 
-    const float count = intervaltime / m_speedLevel;
-    m_lrcMaskWidthInterval = (count != 0) ? m_geometry.x() / count : 0;
+    ///the line mask ends before the next line as the speed level
+    m_lrcStartTime = start;
+    m_lrcIntervalTime = intervaltime * LRC_PER_TIME / m_speedLevel;
+    m_lrcWords = words;
+    updateWordWidth();
+
+    m_lrcMaskWidthInterval = 0;
     m_lrcMaskWidth = 0;
     m_timer->start(LRC_PER_TIME);
 }
@@ -266,18 +285,177 @@ void MusicLrcManager::setLinearGradientColor(const MusicLrcColor &color)
     }
     m_maskLinearGradient = maskLinearGradient;
 
+    invalidateLrcLayer();
     update();
 }
 
 void MusicLrcManager::setUpdateMask()
 {
-    //At a fixed period of time covered length increases.
-    m_lrcMaskWidth += m_lrcMaskWidthInterval;
+    //The covered length follows the clock, not the timer ticks
+    const qint64 elapsed = (m_lrcStartTime < 0) ? m_elapsedTimer.elapsed() : MusicApplication::instance()->position() - m_lrcStartTime;
+    const float width = getLrcMaskWidth(elapsed);
+    m_lrcMaskWidthInterval = width - m_lrcMaskWidth;
+    m_lrcMaskWidth = width;
+
+    if(m_lrcMaskWidth >= m_geometry.x())
+    {
+        m_timer->stop();
+    }
     update();
 }
 
 void MusicLrcManager::setText(const QString &str)
 {
+    if(str != text())
+    {
+        m_lrcWords.clear();
+    }
+
     m_geometry.setX(MusicUtils::Widget::fontTextWidth(m_font, str));
     QLabel::setText(str);
+    updateWordWidth();
+    invalidateLrcLayer();
+}
+
+float MusicLrcManager::getLrcMaskWidth(qint64 elapsed) const
+{
+    if(elapsed <= 0)
+    {
+        return 0;
+    }
+
+    if(m_lrcWords.isEmpty())
+    {
+        if(elapsed >= m_lrcIntervalTime)
+        {
+            return m_geometry.x();
+        }
+        return m_geometry.x() * elapsed / m_lrcIntervalTime;
+    }
+
+    float width = 0;
+    for(int i=0; i<m_lrcWords.count(); ++i)
+    {
+        const MusicLrcWord &word = m_lrcWords[i];
+        if(elapsed < word.m_offset)
+        {
+            break;
+        }
+
+        if(elapsed < word.m_offset + word.m_duration)
+        {
+            return width + (m_lrcWordWidths[i] - width) * (elapsed - word.m_offset) / word.m_duration;
+        }
+        width = m_lrcWordWidths[i];
+    }
+    return width;
+}
+
+void MusicLrcManager::updateWordWidth()
+{
+    m_lrcWordWidths.clear();
+
+    const QString &str = text();
+    int length = 0;
+    foreach(const MusicLrcWord &word, m_lrcWords)
+    {
+        length += word.m_length;
+        m_lrcWordWidths << MusicUtils::Widget::fontTextWidth(m_font, str.left(length));
+    }
+
+    ///the word timings do not match current text, use the line timing
+    if(length != str.length())
+    {
+        m_lrcWords.clear();
+        m_lrcWordWidths.clear();
+    }
+}
+
+QFont MusicLrcManager::getLrcLayerFont() const
+{
+    return m_font;
+}
+
+void MusicLrcManager::updateLrcLayerFont()
+{
+    if(!m_lrcLayer.m_dirty)
+    {
+        return;
+    }
+
+    m_lrcLayer.m_dirty = false;
+    m_lrcLayer.m_font = getLrcLayerFont();
+    m_lrcLayer.m_textWidth = MusicUtils::Widget::fontTextWidth(m_lrcLayer.m_font, text());
+    m_lrcLayer.m_textHeight = MusicUtils::Widget::fontTextHeight(m_lrcLayer.m_font);
+    m_linearGradient.setFinalStop(0, m_lrcLayer.m_textHeight);
+    m_maskLinearGradient.setFinalStop(0, m_lrcLayer.m_textHeight);
+    ///render the layers again by the new font and stops
+    m_lrcLayer.m_textLayer = QPixmap();
+}
+
+void MusicLrcManager::drawLrcLayers(QPainter *painter, int x, int y, int flags, const QColor &shadow, int maskWidth)
+{
+    QElapsedTimer timer;
+    timer.start();
+    updateLrcLayerFont();
+
+    const QSize size(m_geometry.x() + 1, m_geometry.y() + 1);
+#if TTK_QT_VERSION_CHECK(5,6,0)
+    const qreal ratio = devicePixelRatioF();
+#elif TTK_QT_VERSION_CHECK(5,0,0)
+    const qreal ratio = devicePixelRatio();
+#else
+    const qreal ratio = 1;
+#endif
+
+    if(m_lrcLayer.m_textLayer.isNull() || m_lrcLayer.m_size != size || m_lrcLayer.m_shadow != shadow ||
+       m_lrcLayer.m_top != y || m_lrcLayer.m_flags != flags || m_lrcLayer.m_ratio != ratio)
+    {
+        m_lrcLayer.m_size = size;
+        m_lrcLayer.m_shadow = shadow;
+        m_lrcLayer.m_top = y;
+        m_lrcLayer.m_flags = flags;
+        m_lrcLayer.m_ratio = ratio;
+        m_lrcLayer.m_textLayer = createLrcLayer(y, flags, QPen(m_linearGradient, 0), shadow, ratio);
+        m_lrcLayer.m_maskLayer = createLrcLayer(y, flags, QPen(m_maskLinearGradient, 0), QColor(), ratio);
+    }
+
+    //Only composite the layers, the mask layer is clipped by the mask width
+    painter->drawPixmap(x, y, m_lrcLayer.m_textLayer);
+    maskWidth = qMin(maskWidth, size.width());
+    if(maskWidth > 0)
+    {
+        painter->drawPixmap(QRectF(x, y, maskWidth, size.height()), m_lrcLayer.m_maskLayer, QRectF(0, 0, maskWidth * ratio, size.height() * ratio));
+    }
+
+    ///kept for the frame time accessors, never logged per frame
+    m_lastFrameTime = timer.nsecsElapsed();
+    m_frameTime += m_lastFrameTime;
+    ++m_frameCount;
+}
+
+QPixmap MusicLrcManager::createLrcLayer(int y, int flags, const QPen &pen, const QColor &shadow, qreal ratio) const
+{
+    const int width = m_geometry.x(), height = m_geometry.y();
+    QPixmap pix(QSize(width + 1, height + 1) * ratio);
+    pix.fill(Qt::transparent);
+#if TTK_QT_VERSION_CHECK(5,0,0)
+    pix.setDevicePixelRatio(ratio);
+#endif
+
+    QPainter painter(&pix);
+    painter.setRenderHints(QPainter::Antialiasing | QPainter::SmoothPixmapTransform);
+    painter.setFont(m_lrcLayer.m_font);
+    //Keep the gradient at the same place as drawing on the widget
+    painter.translate(0, -y);
+
+    if(shadow.isValid())
+    {
+        painter.setPen(shadow);
+        painter.drawText(1, y + 1, width, height, flags, text());
+    }
+
+    painter.setPen(pen);
+    painter.drawText(0, y, width, height, flags, text());
+    return pix;
 }
@@ -23,7 +23,8 @@
 #include <QAction>
 #include <QPainter>
 #include <QMouseEvent>
-#include "musicglobaldefine.h"
+#include <QElapsedTimer>
+#include "musiclrctimeline.h"
 #include "musicwidgetheaders.h"
 
 #define LRC_PER_TIME        30
@@ -79,6 +80,32 @@ public:
 
 };
 
+/*! @brief The class of the lrc line cached layers.
+ * @author Greedysky <greedysky@163.com>
+ */
+typedef struct MUSIC_LRC_EXPORT MusicLrcLayer
+{
+    bool m_dirty;       ///text, font or colors changed
+    QFont m_font;
+    int m_textWidth, m_textHeight;
+    QSize m_size;
+    QColor m_shadow;
+    int m_top, m_flags;
+    qreal m_ratio;
+    QPixmap m_textLayer, m_maskLayer;
+
+    MusicLrcLayer()
+    {
+        m_dirty = true;
+        m_textWidth = 0;
+        m_textHeight = 0;
+        m_top = 0;
+        m_flags = 0;
+        m_ratio = 0;
+    }
+}MusicLrcLayer;
+
+
 /*! @brief The class of the lrc manager base.
  * @author Greedysky <greedysky@163.com>
  */
@@ -99,9 +126,14 @@ public:
      */
     void startTimerClock();
     /*!
-     * Start timer clock to draw lrc mask.
+     * Start timer clock to draw lrc mask, the mask follows the elapsed time.
      */
     void startLrcMask(qint64 intervaltime);
+    /*!
+     * Start timer clock to draw lrc mask, the mask follows the play position
+     * from the line start time, and the word timings if any.
+     */
+    void startLrcMask(qint64 start, qint64 intervaltime, const MusicLrcWords &words);
     /*!
      * Stop timer clock to draw lrc mask.
      */
@@ -164,6 +196,15 @@ public:
      */
     inline int getFirstFontSize() const { return m_font.pointSize(); }
 
+    /*!
+     * Get the draw time of the last lrc frame in nanoseconds.
+     */
+    inline qint64 getLastFrameTime() const { return m_lastFrameTime; }
+    /*!
+     * Get the average draw time of all lrc frames in nanoseconds.
+     */
+    inline qint64 getAverageFrameTime() const { return m_frameCount == 0 ? 0 : m_frameTime / m_frameCount; }
+
 public Q_SLOTS:
     /*!
      * Time out to calculate lrc mask line length.
@@ -175,6 +216,36 @@ public Q_SLOTS:
     void setText(const QString &str);
 
 protected:
+    /*!
+     * Get lrc mask line length by the elapsed time of current line.
+     */
+    float getLrcMaskWidth(qint64 elapsed) const;
+    /*!
+     * Update the text width before every word end.
+     */
+    void updateWordWidth();
+    /*!
+     * Get the font of the lrc layers.
+     */
+    virtual QFont getLrcLayerFont() const;
+    /*!
+     * Mark the cached font, text size and layers out of date.
+     */
+    inline void invalidateLrcLayer() { m_lrcLayer.m_dirty = true; }
+    /*!
+     * Measure the layer font, text size and gradient stops again if out of date.
+     */
+    void updateLrcLayerFont();
+    /*!
+     * Draw lrc line by the cached text and mask layers, rebuild them when
+     * out of date or size, shadow and device ratio changed.
+     */
+    void drawLrcLayers(QPainter *painter, int x, int y, int flags, const QColor &shadow, int maskWidth);
+    /*!
+     * Render lrc text into a transparent layer.
+     */
+    QPixmap createLrcLayer(int y, int flags, const QPen &pen, const QColor &shadow, qreal ratio) const;
+
     QLinearGradient m_linearGradient, m_maskLinearGradient;
     QFont m_font;
     QTimer *m_timer;
@@ -183,6 +254,14 @@ protected:
     int m_lrcPerWidth, m_transparent, m_speedLevel;
     QPoint m_geometry;
 
+    qint64 m_lrcStartTime, m_lrcIntervalTime;
+    QElapsedTimer m_elapsedTimer;
+    MusicLrcWords m_lrcWords;
+    QList<float> m_lrcWordWidths;
+
+    MusicLrcLayer m_lrcLayer;
+    qint64 m_frameCount, m_frameTime, m_lastFrameTime;
+
 };
 
 #endif // MUSICLRCMANAGER_H
@@ -1,6 +1,5 @@
 #include "musiclrcmanagerfordesktop.h"
 #include "musicsettingmanager.h"
-#include "musicwidgetutils.h"
 
 MusicLrcManagerForDesktop::MusicLrcManagerForDesktop(QWidget *parent)
     : MusicLrcManager(parent)
@@ -20,37 +19,24 @@ MusicLrcManagerHorizontalDesktop::MusicLrcManagerHorizontalDesktop(QWidget *pare
 void MusicLrcManagerHorizontalDesktop::paintEvent(QPaintEvent *)
 {
     QPainter painter(this);
-    painter.setFont(m_font);
     painter.setRenderHints(QPainter::Antialiasing | QPainter::SmoothPixmapTransform);
 
-    const int fontHeight = MusicUtils::Widget::fontTextHeight(m_font);
-    const int begin = (rect().height() - fontHeight) / 2;
-    m_linearGradient.setFinalStop(0, fontHeight);
-    m_maskLinearGradient.setFinalStop(0, fontHeight);
+    updateLrcLayerFont();
+    const int begin = (rect().height() - m_lrcLayer.m_textHeight) / 2;
 
     if(m_geometry.x() + m_intervalCount >= m_lrcPerWidth && m_lrcMaskWidth >= m_lrcPerWidth / 2)
     {
         m_intervalCount -= m_lrcMaskWidthInterval;
     }
 
-    //Draw the underlying text, such as shadow, will make the effect more clearly,
-    //and more texture
-    painter.setPen(QColor(0, 0, 0, 2*m_transparent));
-    painter.drawText(m_intervalCount + 1, begin + 1, m_geometry.x(), m_geometry.y(), Qt::AlignLeft, text());
-
-    //Then draw a gradient in the above
-    painter.setPen(QPen(m_linearGradient, 0));
-    painter.drawText(m_intervalCount, begin, m_geometry.x(), m_geometry.y(), Qt::AlignLeft, text());
-
     int offsetValue = m_lrcMaskWidth;
     if(!M_SETTING_PTR->value(MusicSettingManager::OtherLrcKTVMode).toBool())
     {
         offsetValue = (m_lrcMaskWidth != 0) ? m_geometry.x() : m_lrcMaskWidth;
     }
 
-    //Set lyrics mask
-    painter.setPen(QPen(m_maskLinearGradient, 0));
-    painter.drawText(m_intervalCount, begin, offsetValue, 60, Qt::AlignLeft, text());
+    //Draw the cached shadow and gradient text, then the lyrics mask in the above
+    drawLrcLayers(&painter, m_intervalCount, begin, Qt::AlignLeft, QColor(0, 0, 0, 2*m_transparent), offsetValue);
 }
 
 
@@ -63,11 +49,6 @@ MusicLrcManagerVerticalDesktop::MusicLrcManagerVerticalDesktop(QWidget *parent)
 void MusicLrcManagerVerticalDesktop::paintEvent(QPaintEvent *)
 {
     QPainter painter(this);
-    painter.setFont(m_font);
-
-    const int fontHeight = MusicUtils::Widget::fontTextHeight(m_font);
-    m_linearGradient.setFinalStop(0, fontHeight);
-    m_maskLinearGradient.setFinalStop(0, fontHeight);
 
     if(m_geometry.x() + m_intervalCount >= m_lrcPerWidth && m_lrcMaskWidth >= m_lrcPerWidth / 2)
     {
@@ -77,23 +58,13 @@ void MusicLrcManagerVerticalDesktop::paintEvent(QPaintEvent *)
     painter.translate(m_geometry.y(), 0);
     painter.rotate(MA_90);
 
-    //Draw the underlying text, such as shadow, will make the effect more clearly,
-    //and more texture
-    painter.setPen(QColor(0, 0, 0, 2*m_transparent));
-    painter.drawText(m_intervalCount + 1, 1, m_geometry.x(), m_geometry.y(), Qt::AlignLeft, text());
-
-    //Then draw a gradient in the above
-    painter.setPen(QPen(m_linearGradient, 0));
-    painter.drawText(m_intervalCount, 0, m_geometry.x(), m_geometry.y(), Qt::AlignLeft, text());
-
     int offsetValue = m_lrcMaskWidth;
     if(!M_SETTING_PTR->value(MusicSettingManager::OtherLrcKTVMode).toBool())
     {
         offsetValue = (m_lrcMaskWidth != 0) ? m_geometry.x() : m_lrcMaskWidth;
     }
 
-    //Set lyrics mask
-    painter.setPen(QPen(m_maskLinearGradient, 0));
-    painter.drawText(m_intervalCount, 0, offsetValue, 60, Qt::AlignLeft, text());
+    //Draw the cached shadow and gradient text, then the lyrics mask in the above
+    drawLrcLayers(&painter, m_intervalCount, 0, Qt::AlignLeft, QColor(0, 0, 0, 2*m_transparent), offsetValue);
     painter.translate(-m_geometry.y(), 0);
 }
@@ -1,6 +1,5 @@
 #include "musiclrcmanagerforinterior.h"
 #include "musicsettingmanager.h"
-#include "musicwidgetutils.h"
 
 MusicLrcManagerForInterior::MusicLrcManagerForInterior(QWidget *parent)
     : MusicLrcManager(parent)
@@ -19,41 +18,29 @@ void MusicLrcManagerForInterior::paintEvent(QPaintEvent *)
     QPainter painter(this);
     painter.setRenderHints(QPainter::Antialiasing | QPainter::SmoothPixmapTransform);
 
-    QFont font(m_font);
-    int ttplus = font.pointSize() - m_gradientFontSize;
-    font.setPointSize(ttplus = (ttplus < 0) ? 0 : ttplus);
-    painter.setFont(font);
-    m_geometry.setX(MusicUtils::Widget::fontTextWidth(font, text()));
-
-    const int fontHeight = MusicUtils::Widget::fontTextHeight(font);
-    m_linearGradient.setFinalStop(0, fontHeight);
-    m_maskLinearGradient.setFinalStop(0, fontHeight);
+    //The font and text size are measured again only when text, font or colors changed
+    updateLrcLayerFont();
+    m_geometry.setX(m_lrcLayer.m_textWidth);
 
     if(m_geometry.x() + m_intervalCount >= m_lrcPerWidth && m_lrcMaskWidth >= m_lrcPerWidth / 2)
     {
         m_intervalCount -= m_lrcMaskWidthInterval;
     }
-    //Draw the underlying text, such as shadow, will make the effect more clearly, and more texture
-    ttplus = 2.55*m_gradientTransparent;
-    painter.setPen(QColor(0, 0, 0, ttplus));
-
-    ttplus = (m_lrcPerWidth - m_geometry.x()) / 2.0;
-    painter.drawText((ttplus < 0 ? m_intervalCount : ttplus) + 1, 1,
-                     m_geometry.x(), m_geometry.y(), Qt::AlignLeft | Qt::AlignVCenter, text());
-
-    //Then draw a gradient in the above
-    painter.setPen(QPen(m_linearGradient, 0));
-    painter.drawText(ttplus < 0 ? m_intervalCount : ttplus, 0,
-                     m_geometry.x(), m_geometry.y(), Qt::AlignLeft | Qt::AlignVCenter, text());
-
     int offsetValue = m_lrcMaskWidth;
-    if(!M_SETTING_PTR->value(MusicSettingManager::OtherLrcKTVMode).toBool())
+    if(!M_SETTING_PTR->boolValue(MusicSettingManager::OtherLrcKTVMode))
     {
         offsetValue = (m_lrcMaskWidth != 0) ? m_geometry.x() : m_lrcMaskWidth;
     }
 
-    //Set lyrics mask
-    painter.setPen(QPen(m_maskLinearGradient, 0));
-    painter.drawText(ttplus < 0 ? m_intervalCount : ttplus, 0,
-                     offsetValue, m_geometry.y(), Qt::AlignLeft | Qt::AlignVCenter, text());
+    //Draw the cached shadow and gradient text, then the lyrics mask in the above
+    const QColor shadow(0, 0, 0, TTKStatic_cast(int, 2.55*m_gradientTransparent));
+    const int left = (m_lrcPerWidth - m_geometry.x()) / 2.0;
+    drawLrcLayers(&painter, left < 0 ? m_intervalCount : left, 0, Qt::AlignLeft | Qt::AlignVCenter, shadow, offsetValue);
+}
+
+QFont MusicLrcManagerForInterior::getLrcLayerFont() const
+{
+    QFont font(m_font);
+    font.setPointSize(qMax(font.pointSize() - m_gradientFontSize, 0));
+    return font;
 }
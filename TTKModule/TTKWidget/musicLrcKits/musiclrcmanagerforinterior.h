@@ -43,7 +43,7 @@ public:
     /*!
      * Set adjust font size.
      */
-    inline void setFontSize(int size) { m_gradientFontSize = size; }
+    inline void setFontSize(int size) { m_gradientFontSize = size; invalidateLrcLayer(); }
     /*!
      * Set adjust transparent by value.
      */
@@ -54,6 +54,10 @@ protected:
      * Override the widget event.
      */
     virtual void paintEvent(QPaintEvent *event) override;
+    /*!
+     * Get the font of the lrc layers, adjusted by the font size.
+     */
+    virtual QFont getLrcLayerFont() const override;
 
     int m_gradientFontSize;
     int m_gradientTransparent;
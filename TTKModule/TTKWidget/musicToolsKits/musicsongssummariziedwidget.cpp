@@ -14,10 +14,41 @@
 #include "musiclrcdownloadbatchwidget.h"
 #include "musicapplication.h"
 #include "musictoastlabel.h"
+#include "musicplaylistjournal.h"
+#include "musicplaylistsearchindex.h"
+
+#ifdef TTK_GREATER_NEW
+#  include <QtConcurrent/QtConcurrent>
+#else
+#  include <QtConcurrentRun>
+#endif
+#include <QTimer>
+#include <QEventLoop>
 
 #define  ITEM_MIN_COUNT             4
 #define  ITEM_MAX_COUNT             10
 #define  RECENT_ITEM_MAX_COUNT      50
+#define  IMPORT_CHUNK_COUNT         32
+#define  IMPORT_POLL_INTERVAL       50
+
+static MusicSongs readMusicSongsByPath(const QStringList &paths, bool useInfo)
+{
+    MusicSongs songs;
+    MusicSongTag tag;
+    foreach(const QString &path, paths)
+    {
+        ///no cover here, pixmaps must stay in the gui thread
+        const bool state = tag.read(path, false);
+        const QString &time = state ? tag.getLengthString() : "-";
+        QString name;
+        if(useInfo && state && !tag.getTitle().isEmpty() && !tag.getArtist().isEmpty())
+        {
+            name = tag.getArtist() + " - "+ tag.getTitle();
+        }
+        songs << MusicSong(path, 0, time, name);
+    }
+    return songs;
+}
 
 MusicSongsSummariziedWidget::MusicSongsSummariziedWidget(QWidget *parent)
     : MusicSongsToolBoxWidget(parent)
@@ -40,6 +71,7 @@ MusicSongsSummariziedWidget::MusicSongsSummariziedWidget(QWidget *parent)
 
     M_CONNECTION_PTR->setValue(getClassName(), this);
     M_CONNECTION_PTR->poolConnect(MusicSongSearchTableWidget::getClassName(), getClassName());
+    connect(M_PLAYLIST_JOURNAL_PTR, SIGNAL(compactRequested()), SLOT(compactMusicLists()));
 }
 
 MusicSongsSummariziedWidget::~MusicSongsSummariziedWidget()
@@ -123,6 +155,7 @@ void MusicSongsSummariziedWidget::appendMusicLists(const MusicSongItems &names)
         item->m_itemIndex = ++m_itemIndexRaise;
         checkCurrentNameExist(item->m_itemName);
         createWidgetItem(item);
+        M_PLAYLIST_JOURNAL_PTR->appendList(item->m_itemName, item->m_songs);
     }
 }
 
@@ -133,35 +166,92 @@ void MusicSongsSummariziedWidget::importMusicSongsByPath(QStringList &filelist)
         m_musicSongSearchWidget->close();
     }
 
+    const MusicSongItem *item = &m_songItems[m_currentImportIndex];
+    ///the list may be moved or removed in the nested event loop, find it by its unique index each time
+    const int itemIndex = item->m_itemIndex;
+    QSet<QString> paths;
+    foreach(const MusicSong &song, item->m_songs)
+    {
+        paths.insert(song.getMusicPath());
+    }
+
+    QStringList files;
+    foreach(const QString &path, filelist)
+    {
+        QString p(path);
+        p.replace("\\", "/");
+        if(!paths.contains(p))
+        {
+            paths.insert(p);
+            files << path;
+        }
+    }
+    filelist = files;
+
     MusicProgressWidget progress;
     progress.show();
     progress.setTitle(tr("Import File Mode"));
     progress.setRange(0, filelist.count());
 
-    MusicSongTag tag;
-    MusicSongItem *item = &m_songItems[m_currentImportIndex];
-    int i=0;
+    ///read tags in thread pool by chunks, append finished chunks in order
+    const bool useInfo = M_SETTING_PTR->value(MusicSettingManager::OtherUseInfo).toBool();
+    QList< QFuture<MusicSongs> > futures;
+    for(int i=0; i<filelist.count(); i+=IMPORT_CHUNK_COUNT)
+    {
+        futures << QtConcurrent::run(readMusicSongsByPath, filelist.mid(i, IMPORT_CHUNK_COUNT), useInfo);
+    }
 
-    foreach(const QString &path, filelist)
+    QEventLoop loop;
+    QTimer timer;
+    timer.setInterval(IMPORT_POLL_INTERVAL);
+    connect(&timer, SIGNAL(timeout()), &loop, SLOT(quit()));
+    timer.start();
+
+    int index = 0, value = 0;
+    while(index < futures.count())
     {
-        if(item->m_songs.contains(MusicSong(path)))
+        int id = -1;
+        for(int i=0; i<m_songItems.count(); ++i)
         {
-            filelist.removeAll(path);
-            continue;
+            if(m_songItems[i].m_itemIndex == itemIndex)
+            {
+                id = i;
+                break;
+            }
         }
 
-        const bool state = tag.read(path);
-        const QString &time = state ? tag.getLengthString() : "-";
-        QString name;
-        if(M_SETTING_PTR->value(MusicSettingManager::OtherUseInfo).toBool() && state && !tag.getTitle().isEmpty() && !tag.getArtist().isEmpty())
+        if(id == -1)
         {
-            name = tag.getArtist() + " - "+ tag.getTitle();
+            ///the list is gone, the running chunks are left to finish and dropped
+            break;
+        }
+
+        MusicSongItem *songItem = &m_songItems[id];
+        const int count = songItem->m_songs.count();
+        while(index < futures.count() && futures[index].isFinished())
+        {
+            songItem->m_songs << futures[index++].result();
+        }
+
+        if(count != songItem->m_songs.count())
+        {
+            M_PLAYLIST_JOURNAL_PTR->appendSongs(id, songItem->m_songs.mid(count));
+            MusicPlaylistSearchIndex *searchIndex = findSearchIndex(id);
+            if(searchIndex)
+            {
+                searchIndex->append(songItem->m_songs.mid(count));
+            }
+            value += songItem->m_songs.count() - count;
+            progress.setValue(value);
+            songItem->m_itemObject->updateSongsFileName(songItem->m_songs);
+            setItemTitle(songItem);
+        }
+
+        if(index < futures.count())
+        {
+            loop.exec();
         }
-        item->m_songs << MusicSong(path, 0, time, name);
-        progress.setValue(++i);
     }
-    item->m_itemObject->updateSongsFileName(item->m_songs);
-    setItemTitle(item);
 
     MusicSongsToolBoxWidget::setCurrentIndex(m_currentImportIndex);
 
@@ -236,25 +326,30 @@ QString MusicSongsSummariziedWidget::mapFilePathBySongIndex(int toolIndex, int i
 
 void MusicSongsSummariziedWidget::searchFileListCache(int index)
 {
-    TTKIntList searchResult;
-    const QStringList searchedSongs(getMusicSongsFileName(m_currentIndex));
     QString text;
     if(m_musicSongSearchWidget)
     {
         text = m_musicSongSearchWidget->getSearchedText();
     }
 
-    for(int j=0; j<searchedSongs.count(); ++j)
+    MusicSongItem *songItem = &m_songItems[m_currentIndex];
+    MusicPlaylistSearchIndex *searchIndex = findSearchIndex(m_currentIndex);
+    if(!searchIndex)
     {
-        if(searchedSongs[j].contains(text, Qt::CaseInsensitive))
-        {
-            searchResult << j;
-        }
+        searchIndex = new MusicPlaylistSearchIndex;
+        searchIndex->reset(songItem->m_songs);
+        m_searchIndexs.insert(m_currentIndex, searchIndex);
+    }
+    else if(searchIndex->count() != songItem->m_songs.count())
+    {
+        ///some list change is not followed, just rebuild it
+        searchIndex->reset(songItem->m_songs);
     }
+
+    const TTKIntList &searchResult = searchIndex->search(text);
     m_searchFileListIndex = text.count();
     m_searchfileListCache.insert(index, searchResult);
 
-    MusicSongItem *songItem = &m_songItems[m_currentIndex];
     TTKStatic_cast(MusicSongsListTableWidget*, songItem->m_itemObject)->setMusicSongsSearchedFileName(&songItem->m_songs, searchResult);
 
     if(index == 0)
@@ -382,6 +477,8 @@ void MusicSongsSummariziedWidget::deleteRowItem(int index)
     item = m_songItems.takeAt(id);
     removeItem(item.m_itemObject);
     delete item.m_itemObject;
+    M_PLAYLIST_JOURNAL_PTR->removeList(id);
+    clearSearchIndexs();
 
     resetToolIndex();
 }
@@ -408,7 +505,9 @@ void MusicSongsSummariziedWidget::deleteRowItems()
         MusicSongItem item = m_songItems.takeLast();
         removeItem(item.m_itemObject);
         delete item.m_itemObject;
+        M_PLAYLIST_JOURNAL_PTR->removeList(i);
     }
+    clearSearchIndexs();
 }
 
 void MusicSongsSummariziedWidget::deleteRowItemAll(int index)
@@ -451,6 +550,7 @@ void MusicSongsSummariziedWidget::changRowItemName(int index, const QString &nam
     MusicSongItem *item = &m_songItems[id];
     item->m_itemName = name;
     setItemTitle(item);
+    M_PLAYLIST_JOURNAL_PTR->renameList(id, name);
 }
 
 void MusicSongsSummariziedWidget::addNewFiles(int index)
@@ -515,6 +615,8 @@ void MusicSongsSummariziedWidget::swapDragItemIndex(int before, int after)
     swapItem(before, after);
     MusicSongItem item = m_songItems.takeAt(before);
     m_songItems.insert(after, item);
+    M_PLAYLIST_JOURNAL_PTR->moveList(before, after);
+    clearSearchIndexs();
 
     resetToolIndex();
 }
@@ -615,11 +717,25 @@ void MusicSongsSummariziedWidget::musicListSongToLovestListAt(bool oper, int row
         item->m_songs << song;
         w->updateSongsFileName(item->m_songs);
         setItemTitle(item);
+        M_PLAYLIST_JOURNAL_PTR->appendSongs(MUSIC_LOVEST_LIST, MusicSongs() << song);
+        MusicPlaylistSearchIndex *searchIndex = findSearchIndex(MUSIC_LOVEST_LIST);
+        if(searchIndex)
+        {
+            searchIndex->append(MusicSongs() << song);
+        }
     }
     else        ///Remove to lovest list
     {
-        if(item->m_songs.removeOne(song))
+        const int index = item->m_songs.indexOf(song);
+        if(index != -1)
         {
+            item->m_songs.removeAt(index);
+            M_PLAYLIST_JOURNAL_PTR->removeSongs(MUSIC_LOVEST_LIST, TTKIntList() << index);
+            MusicPlaylistSearchIndex *searchIndex = findSearchIndex(MUSIC_LOVEST_LIST);
+            if(searchIndex)
+            {
+                searchIndex->remove(TTKIntList() << index);
+            }
             w->clearAllItems();
             w->updateSongsFileName(item->m_songs);
             setItemTitle(item);
@@ -643,11 +759,25 @@ void MusicSongsSummariziedWidget::musicSongToLovestListAt(bool oper, int row)
         item->m_songs << song;
         w->updateSongsFileName(item->m_songs);
         setItemTitle(item);
+        M_PLAYLIST_JOURNAL_PTR->appendSongs(MUSIC_LOVEST_LIST, MusicSongs() << song);
+        MusicPlaylistSearchIndex *searchIndex = findSearchIndex(MUSIC_LOVEST_LIST);
+        if(searchIndex)
+        {
+            searchIndex->append(MusicSongs() << song);
+        }
     }
     else        ///Remove to lovest list
     {
-        if(item->m_songs.removeOne(song))
+        const int index = item->m_songs.indexOf(song);
+        if(index != -1)
         {
+            item->m_songs.removeAt(index);
+            M_PLAYLIST_JOURNAL_PTR->removeSongs(MUSIC_LOVEST_LIST, TTKIntList() << index);
+            MusicPlaylistSearchIndex *searchIndex = findSearchIndex(MUSIC_LOVEST_LIST);
+            if(searchIndex)
+            {
+                searchIndex->remove(TTKIntList() << index);
+            }
             w->clearAllItems();
             w->updateSongsFileName(item->m_songs);
             setItemTitle(item);
@@ -664,6 +794,12 @@ void MusicSongsSummariziedWidget::addNetMusicSongToList(const QString &name, con
     item->m_songs << MusicSong(path, 0, time, musicSong);
     item->m_itemObject->updateSongsFileName(item->m_songs);
     setItemTitle(item);
+    M_PLAYLIST_JOURNAL_PTR->appendSongs(MUSIC_NETWORK_LIST, MusicSongs() << item->m_songs.last());
+    MusicPlaylistSearchIndex *searchIndex = findSearchIndex(MUSIC_NETWORK_LIST);
+    if(searchIndex)
+    {
+        searchIndex->append(MusicSongs() << item->m_songs.last());
+    }
 
     if(play)
     {
@@ -730,6 +866,12 @@ void MusicSongsSummariziedWidget::setDeleteItemAt(const TTKIntList &index, bool
         }
     }
 
+    M_PLAYLIST_JOURNAL_PTR->removeSongs(cIndex, index);
+    MusicPlaylistSearchIndex *searchIndex = findSearchIndex(cIndex);
+    if(searchIndex)
+    {
+        searchIndex->remove(index);
+    }
     MusicApplication::instance()->setDeleteItemAt(deleteFiles, fileRemove, cIndex == m_currentPlayToolIndex, cIndex);
 
     setItemTitle(item);
@@ -764,6 +906,12 @@ void MusicSongsSummariziedWidget::setMusicIndexSwaped(int before, int after, int
         }
     }
     songs = *names;
+    M_PLAYLIST_JOURNAL_PTR->moveSong(m_currentIndex, before, after);
+    MusicPlaylistSearchIndex *searchIndex = findSearchIndex(m_currentIndex);
+    if(searchIndex)
+    {
+        searchIndex->move(before, after);
+    }
 
     if(m_currentIndex == m_currentPlayToolIndex)
     {
@@ -771,6 +919,39 @@ void MusicSongsSummariziedWidget::setMusicIndexSwaped(int before, int after, int
     }
 }
 
+void MusicSongsSummariziedWidget::setMusicSongRenamed(int index, int row, const QString &name)
+{
+    if(index < 0 || index >= m_songItems.count())
+    {
+        return;
+    }
+
+    MusicSongs *songs = &m_songItems[index].m_songs;
+    if(row < 0 || row >= songs->count())
+    {
+        return;
+    }
+
+    (*songs)[row].setMusicName(name);
+    M_PLAYLIST_JOURNAL_PTR->renameSong(index, row, name);
+    setMusicSongChanged(index, row);
+}
+
+void MusicSongsSummariziedWidget::setMusicSongChanged(int index, int row)
+{
+    if(index < 0 || index >= m_songItems.count())
+    {
+        return;
+    }
+
+    const MusicSongs &songs = m_songItems[index].m_songs;
+    MusicPlaylistSearchIndex *searchIndex = findSearchIndex(index);
+    if(searchIndex && row >= 0 && row < songs.count())
+    {
+        searchIndex->rename(row, songs[row].getMusicName());
+    }
+}
+
 void MusicSongsSummariziedWidget::isCurrentIndex(bool &state)
 {
     const int cIndex = m_toolDeleteChanged ? m_currentDeleteIndex : m_currentIndex;
@@ -794,6 +975,7 @@ void MusicSongsSummariziedWidget::setMusicPlayCount(int index)
     {
         MusicSong *song = &(*songs)[index];
         song->setMusicPlayCount(song->getMusicPlayCount() + 1);
+        M_PLAYLIST_JOURNAL_PTR->setPlayCount(m_currentPlayToolIndex, index, song->getMusicPlayCount());
     }
 }
 
@@ -820,10 +1002,22 @@ void MusicSongsSummariziedWidget::setRecentMusicSongs(int index)
         {
             musics->takeFirst();
             w->clearAllItems();
+            M_PLAYLIST_JOURNAL_PTR->removeSongs(MUSIC_RECENT_LIST, TTKIntList() << 0);
+            MusicPlaylistSearchIndex *searchIndex = findSearchIndex(MUSIC_RECENT_LIST);
+            if(searchIndex)
+            {
+                searchIndex->remove(TTKIntList() << 0);
+            }
         }
 
         music.setMusicPlayCount(music.getMusicPlayCount() + 1);
         musics->append(music);
+        M_PLAYLIST_JOURNAL_PTR->appendSongs(MUSIC_RECENT_LIST, MusicSongs() << music);
+        MusicPlaylistSearchIndex *searchIndex = findSearchIndex(MUSIC_RECENT_LIST);
+        if(searchIndex)
+        {
+            searchIndex->append(MusicSongs() << music);
+        }
         w->updateSongsFileName(*musics);
 
         const QString title(QString("%1[%2]").arg(item->m_itemName).arg(musics->count()));
@@ -837,6 +1031,7 @@ void MusicSongsSummariziedWidget::setRecentMusicSongs(int index)
             if(music == *song)
             {
                 song->setMusicPlayCount(song->getMusicPlayCount() + 1);
+                M_PLAYLIST_JOURNAL_PTR->setPlayCount(MUSIC_RECENT_LIST, i, song->getMusicPlayCount());
                 break;
             }
         }
@@ -848,6 +1043,11 @@ void MusicSongsSummariziedWidget::getMusicLists(MusicSongItems &songs)
     songs = m_songItems;
 }
 
+void MusicSongsSummariziedWidget::compactMusicLists()
+{
+    M_PLAYLIST_JOURNAL_PTR->compact(m_songItems);
+}
+
 void MusicSongsSummariziedWidget::updateCurrentArtist()
 {
     if(m_currentPlayToolIndex < 0)
@@ -901,13 +1101,14 @@ void MusicSongsSummariziedWidget::musicListSongSortBy(int index)
     {
         (*songs)[i].setMusicSort(sort);
     }
-    if(m_songItems[id].m_sort.m_sortType == Qt::DescendingOrder)
-    {
-        std::sort(songs->begin(), songs->end());
-    }
-    else
+    ///the list order is the reverse of the toolbox sort order
+    MusicSong::sortSongs(songs, sort, m_songItems[id].m_sort.m_sortType == Qt::DescendingOrder ? Qt::AscendingOrder : Qt::DescendingOrder);
+    M_PLAYLIST_JOURNAL_PTR->setSort(id, m_songItems[id].m_sort);
+    M_PLAYLIST_JOURNAL_PTR->setSongs(id, *songs);
+    MusicPlaylistSearchIndex *searchIndex = findSearchIndex(id);
+    if(searchIndex)
     {
-        std::sort(songs->begin(), songs->end(), std::greater<MusicSong>());
+        searchIndex->reset(*songs);
     }
 
     w->clearAllItems();
@@ -983,6 +1184,7 @@ void MusicSongsSummariziedWidget::addNewRowItem(const QString &name)
     item.m_itemName = name;
     m_songItems << item;
     createWidgetItem(&m_songItems.last());
+    M_PLAYLIST_JOURNAL_PTR->appendList(name);
 }
 
 void MusicSongsSummariziedWidget::createWidgetItem(MusicSongItem *item)
@@ -1003,6 +1205,8 @@ void MusicSongsSummariziedWidget::createWidgetItem(MusicSongItem *item)
     connect(w, SIGNAL(isSearchFileListEmpty(bool&)), SLOT(isSearchFileListEmpty(bool&)));
     connect(w, SIGNAL(deleteItemAt(TTKIntList,bool)), SLOT(setDeleteItemAt(TTKIntList,bool)));
     connect(w, SIGNAL(getMusicIndexSwaped(int,int,int,MusicSongs&)), SLOT(setMusicIndexSwaped(int,int,int,MusicSongs&)));
+    connect(w, SIGNAL(musicListSongRenamed(int,int,QString)), SLOT(setMusicSongRenamed(int,int,QString)));
+    connect(w, SIGNAL(musicListSongChanged(int,int)), SLOT(setMusicSongChanged(int,int)));
     connect(w, SIGNAL(musicListSongToLovestListAt(bool,int)), SLOT(musicListSongToLovestListAt(bool,int)));
     connect(w, SIGNAL(showFloatWidget()), SLOT(showFloatWidget()));
     connect(w, SIGNAL(musicListSongSortBy(int)), SLOT(musicListSongSortBy(int)));
@@ -1020,6 +1224,7 @@ void MusicSongsSummariziedWidget::clearAllLists()
     {
         delete m_songItems.takeLast().m_itemObject;
     }
+    clearSearchIndexs();
 }
 
 void MusicSongsSummariziedWidget::setItemTitle(MusicSongItem *item)
@@ -1075,6 +1280,17 @@ void MusicSongsSummariziedWidget::resetToolIndex()
     MusicPlayedListPopWidget::instance()->resetToolIndex(pairs);
 }
 
+MusicPlaylistSearchIndex *MusicSongsSummariziedWidget::findSearchIndex(int index) const
+{
+    return m_searchIndexs.value(index);
+}
+
+void MusicSongsSummariziedWidget::clearSearchIndexs()
+{
+    qDeleteAll(m_searchIndexs);
+    m_searchIndexs.clear();
+}
+
 void MusicSongsSummariziedWidget::resizeEvent(QResizeEvent *event)
 {
     MusicSongsToolBoxWidget::resizeEvent(event);
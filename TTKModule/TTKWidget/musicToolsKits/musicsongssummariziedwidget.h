@@ -29,6 +29,7 @@ class MusicSongCheckToolsWidget;
 class MusicSongsListFunctionWidget;
 class MusicLocalSongSearchDialog;
 class MusicLrcDownloadBatchWidget;
+class MusicPlaylistSearchIndex;
 
 /*! @brief The class of the songs summarizied widget.
  * @author Greedysky <greedysky@163.com>
@@ -202,6 +203,14 @@ public Q_SLOTS:
      * Swap the current play index when user drag and drop.
      */
     void setMusicIndexSwaped(int before, int after, int play, MusicSongs &songs);
+    /*!
+     * Rename the song of list, record it and update the search index.
+     */
+    void setMusicSongRenamed(int index, int row, const QString &name);
+    /*!
+     * Update the changed song of list in search index.
+     */
+    void setMusicSongChanged(int index, int row);
     /*!
      * Check is current play stack widget.
      */
@@ -222,6 +231,10 @@ public Q_SLOTS:
      * Get music datas from container.
      */
     void getMusicLists(MusicSongItems &songs);
+    /*!
+     * Compact playlist journal records into snapshot.
+     */
+    void compactMusicLists();
     /*!
      * Update current artist when it download finished.
      */
@@ -282,6 +295,14 @@ protected:
      * Get current played list.
      */
     void resetToolIndex();
+    /*!
+     * Get search index of list, null if the list is not searched yet.
+     */
+    MusicPlaylistSearchIndex *findSearchIndex(int index) const;
+    /*!
+     * Delete all search indexs.
+     */
+    void clearSearchIndexs();
     /*!
      * Override the widget event.
      */
@@ -295,6 +316,7 @@ protected:
     MusicSongItems m_songItems;
     MusicSongsToolBoxMaskWidget *m_listMaskWidget;
     TTKIntListMap m_searchfileListCache;
+    QHash<int, MusicPlaylistSearchIndex*> m_searchIndexs;
     MusicSongCheckToolsWidget *m_songCheckToolsWidget;
     MusicSongsListFunctionWidget *m_listFunctionWidget;
     MusicLocalSongSearchDialog *m_musicSongSearchWidget;
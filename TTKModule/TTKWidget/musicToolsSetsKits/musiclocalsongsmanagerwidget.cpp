@@ -16,6 +16,30 @@
 #include <QButtonGroup>
 #include <QStyledItemDelegate>
 
+static bool isSameFiles(const QFileInfoList &before, const QFileInfoList &after)
+{
+    if(before.count() != after.count())
+    {
+        return false;
+    }
+
+    ///the scan order differs from time to time, only compare the paths
+    QSet<QString> paths;
+    foreach(const QFileInfo &info, before)
+    {
+        paths.insert(info.absoluteFilePath());
+    }
+
+    foreach(const QFileInfo &info, after)
+    {
+        if(!paths.contains(info.absoluteFilePath()))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 MusicLocalSongsManagerWidget::MusicLocalSongsManagerWidget(QWidget *parent)
     : MusicAbstractMoveWidget(parent),
       m_ui(new Ui::MusicLocalSongsManagerWidget)
@@ -97,10 +121,12 @@ MusicLocalSongsManagerWidget::MusicLocalSongsManagerWidget(QWidget *parent)
 #endif
 
     m_runTypeChanged = false;
+    m_scanStreamed = false;
     addDrivesList();
     m_ui->filterComboBox->setCurrentIndex(-1);
 
     m_thread = new MusicLocalSongsManagerThread(this);
+    connect(m_thread, SIGNAL(appendSongNamePath(QFileInfoList)), SLOT(appendSongNamePath(QFileInfoList)));
     connect(m_thread, SIGNAL(setSongNamePath(QFileInfoList)), SLOT(setSongNamePath(QFileInfoList)));
 
     M_CONNECTION_PTR->setValue(getClassName(), this);
@@ -206,24 +232,55 @@ void MusicLocalSongsManagerWidget::itemDoubleClicked(int row, int)
     Q_EMIT addSongToPlay(QStringList(m_fileNames[row].absoluteFilePath()));
 }
 
+void MusicLocalSongsManagerWidget::appendSongNamePath(const QFileInfoList &name)
+{
+    ///the rescan of watched dirs only shows the whole list
+    if(!m_scanStreamed)
+    {
+        return;
+    }
+
+    m_fileNames << name;
+    m_ui->songlistsTable->addItems(name);
+    m_ui->songCountLabel->setText(tr("showSongCount%1").arg(m_fileNames.count()));
+}
+
 void MusicLocalSongsManagerWidget::setSongNamePath(const QFileInfoList &name)
 {
     TTK_LOGGER_INFO("stop fetch");
     loadingLabelState(false);
 
     m_ui->songlistsTable->setFiles(name);
-    setShowlistButton();
+    if(m_scanStreamed)
+    {
+        ///the rows are added while fetching, in the same order of the list
+        m_scanStreamed = false;
+        m_fileNames = name;
+        m_ui->songCountLabel->setText(tr("showSongCount%1").arg(m_fileNames.count()));
+        controlEnabled(true, false);
+    }
+    else if(m_ui->stackedWidget->currentIndex() == LOCAL_MANAGER_INDEX_0 && !isSameFiles(name, m_fileNames))
+    {
+        setShowlistButton();
+    }
 }
 
 void MusicLocalSongsManagerWidget::filterScanChanged(int index)
 {
     TTK_LOGGER_INFO("start fetch");
     m_thread->stopAndQuitThread();
+    ///drop the results of the stopped scan still waiting in the event queue
+    QCoreApplication::removePostedEvents(this, QEvent::MetaCall);
 
     if(index == 0)
     {
         if(!filterIndexChanged())
         {
+            ///keep the files found before the scan is stopped
+            if(m_scanStreamed)
+            {
+                setSongNamePath(m_fileNames);
+            }
             return;
         }
     }
@@ -231,10 +288,23 @@ void MusicLocalSongsManagerWidget::filterScanChanged(int index)
     {
         if(!filterIndexCustChanged())
         {
+            ///keep the files found before the scan is stopped
+            if(m_scanStreamed)
+            {
+                setSongNamePath(m_fileNames);
+            }
             return;
         }
     }
 
+    m_runTypeChanged = false;
+    m_scanStreamed = true;
+    m_ui->stackedWidget->setCurrentIndex(LOCAL_MANAGER_INDEX_0);
+    controlEnabled(false);
+    m_fileNames.clear();
+    m_ui->songlistsTable->setRowCount(0);
+    m_ui->songCountLabel->setText(tr("showSongCount%1").arg(0));
+
     loadingLabelState(true);
     m_thread->start();
 }
@@ -297,7 +367,7 @@ void MusicLocalSongsManagerWidget::setShowArtButton()
                 break;
             }
 
-            if(tag.read(info.absoluteFilePath()))
+            if(tag.read(info.absoluteFilePath(), false))
             {
                 QString artString = tag.getArtist().trimmed();
                 if(artString.isEmpty())
@@ -342,7 +412,7 @@ void MusicLocalSongsManagerWidget::setShowAlbumButton()
                 break;
             }
 
-            if(tag.read(info.absoluteFilePath()))
+            if(tag.read(info.absoluteFilePath(), false))
             {
                 QString albumString = tag.getAlbum().trimmed();
                 if(albumString.isEmpty())
@@ -393,7 +463,7 @@ void MusicLocalSongsManagerWidget::clearAllItems()
 
 void MusicLocalSongsManagerWidget::addAllItems(const QFileInfoList &fileName)
 {
-    m_ui->songlistsTable->setRowCount(fileName.count()); //reset row count
+    m_ui->songlistsTable->setRowCount(0); //reset row count
     m_ui->songCountLabel->setText(tr("showSongCount%1").arg(fileName.count()));
     m_ui->songlistsTable->addItems(fileName);
 }
@@ -483,9 +553,12 @@ bool MusicLocalSongsManagerWidget::filterIndexCustChanged()
     return true;
 }
 
-void MusicLocalSongsManagerWidget::controlEnabled(bool state)
+void MusicLocalSongsManagerWidget::controlEnabled(bool state, bool clear)
 {
-    clearAllItems();
+    if(clear)
+    {
+        clearAllItems();
+    }
     m_ui->searchLineEdit->clear();
     m_searchfileListCache.clear();
 
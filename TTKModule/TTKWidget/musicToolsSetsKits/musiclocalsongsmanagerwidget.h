@@ -79,6 +79,10 @@ public Q_SLOTS:
      * Item cell on double click by row and col.
      */
     void itemDoubleClicked(int row, int col);
+    /*!
+     * Append the part of files searched so far.
+     */
+    void appendSongNamePath(const QFileInfoList &name);
     /*!
      * Send the searched file or path.
      */
@@ -139,15 +143,15 @@ protected:
      */
     bool filterIndexCustChanged();
     /*!
-     * Control enable or disable.
+     * Control enable or disable, clear the items shown if needed.
      */
-    void controlEnabled(bool state);
+    void controlEnabled(bool state, bool clear = true);
     /*!
      * Loading label disable.
      */
     void loadingLabelState(bool state);
 
-    bool m_runTypeChanged;
+    bool m_runTypeChanged, m_scanStreamed;
     Ui::MusicLocalSongsManagerWidget *m_ui;
     QFileInfoList m_fileNames;
     MusicLocalSongsManagerThread *m_thread;
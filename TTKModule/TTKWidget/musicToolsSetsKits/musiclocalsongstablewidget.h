@@ -41,7 +41,7 @@ public:
      */
     void clear();
     /*!
-     * Add show list items.
+     * Append show list items.
      */
     void addItems(const QFileInfoList &path);
     /*!
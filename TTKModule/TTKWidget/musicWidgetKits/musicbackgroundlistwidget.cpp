@@ -1,10 +1,15 @@
 #include "musicbackgroundlistwidget.h"
-#include "musicextractwrap.h"
 #include "musictoastlabel.h"
 #include "musicwidgetutils.h"
+#include "musicextractwrap.h"
 
 #include <QPainter>
 #include <QMouseEvent>
+#ifdef TTK_GREATER_NEW
+#  include <QtConcurrent/QtConcurrent>
+#else
+#  include <QtConcurrentRun>
+#endif
 
 #define ITEM_COUNT      4
 
@@ -20,31 +25,46 @@ MusicBackgroundListItem::MusicBackgroundListItem(QWidget *parent)
     m_closeSet = false;
     m_showNameMask = true;
     m_selectedMask = true;
+    m_thumbnailWatcher = nullptr;
 }
 
 void MusicBackgroundListItem::updatePixImage()
 {
     if(!m_path.isEmpty())
     {
-        MusicBackgroundImage image;
-        if(MusicExtractWrap::outputSkin(&image, m_path))
-        {
-            updatePixImage(image);
-        }
+        ///show a placeholder tile until the thumbnail is ready
+        QPixmap pix(size());
+        pix.fill(QColor(0, 0, 0, 50));
+        setPixmap(pix);
+
+        delete m_thumbnailWatcher;
+        m_thumbnailWatcher = new QFutureWatcher<MusicSkinThumbnail>(this);
+        connect(m_thumbnailWatcher, SIGNAL(finished()), SLOT(thumbnailFinished()));
+        m_thumbnailWatcher->setFuture(QtConcurrent::run(MusicSkinThumbnailCache::load, m_path, size()));
     }
 }
 
 void MusicBackgroundListItem::updatePixImage(const MusicBackgroundImage &image)
 {
+    delete m_thumbnailWatcher;
+    m_thumbnailWatcher = nullptr;
+
     m_imageInfo = image.m_item;
     setPixmap(image.m_pix.scaled(size()));
 }
 
 bool MusicBackgroundListItem::contains(const MusicSkinConfigItem &item) const
 {
-    if(item.isValid() && m_imageInfo.isValid())
+    ///the thumbnail is still loading, read the skin config only instead of waiting for it
+    MusicSkinConfigItem info = m_imageInfo;
+    if(m_thumbnailWatcher && !MusicExtractWrap::outputSkin(&info, m_path))
     {
-        return item.m_name == m_imageInfo.m_name;
+        return false;
+    }
+
+    if(item.isValid() && info.isValid())
+    {
+        return item.m_name == info.m_name;
     }
     return false;
 }
@@ -73,6 +93,24 @@ void MusicBackgroundListItem::setShowNameEnabled(bool s)
     update();
 }
 
+void MusicBackgroundListItem::thumbnailFinished()
+{
+    if(!m_thumbnailWatcher)
+    {
+        return;
+    }
+
+    const MusicSkinThumbnail &thumbnail = m_thumbnailWatcher->result();
+    m_thumbnailWatcher->deleteLater();
+    m_thumbnailWatcher = nullptr;
+
+    if(thumbnail.isValid())
+    {
+        m_imageInfo = thumbnail.m_item;
+        setPixmap(QPixmap::fromImage(thumbnail.m_image));
+    }
+}
+
 void MusicBackgroundListItem::mousePressEvent(QMouseEvent *event)
 {
     QLabel::mousePressEvent(event);
@@ -211,18 +249,16 @@ void MusicBackgroundListWidget::createItem(const QString &icon, bool state)
     m_items << item;
 }
 
-void MusicBackgroundListWidget::updateItem(const MusicBackgroundImage &image, const QString &path)
+void MusicBackgroundListWidget::updateItem(int index, const MusicBackgroundImage &image, const QString &path)
 {
-    foreach(MusicBackgroundListItem *item, m_items)
+    ///downloads finish out of order, each one goes to its own item
+    MusicBackgroundListItem *item = m_items.value(index);
+    if(item && item->getFileName().isEmpty())
     {
-        if(item->getFileName().isEmpty())
-        {
-            item->setShowNameEnabled(false);
-            item->setSelectEnabled(false);
-            item->setFileName(path);
-            item->updatePixImage(image);
-            break;
-        }
+        item->setShowNameEnabled(false);
+        item->setSelectEnabled(false);
+        item->setFileName(path);
+        item->updatePixImage(image);
     }
 }
 
@@ -311,6 +347,7 @@ void MusicBackgroundListWidget::itemCloseClicked(MusicBackgroundListItem *item)
     const int index = find(item);
     const int cIndex = find(m_currentItem);
     QFile::remove(item->getFilePath());
+    MusicSkinThumbnailCache::remove(item->getFilePath());
     m_items.takeAt(index)->deleteLater();
 
     if(index == cIndex)
@@ -21,8 +21,9 @@
 
 #include <QLabel>
 #include <QGridLayout>
+#include <QFutureWatcher>
 #include "musicuiobject.h"
-#include "musicbackgroundconfigmanager.h"
+#include "musicskinthumbnailcache.h"
 
 /*! @brief The class of the background list item.
  * @author Greedysky <greedysky@163.com>
@@ -55,7 +56,7 @@ public:
     inline QString getFilePath() const { return m_path; }
 
     /*!
-     * Update pix image.
+     * Update pix image by thumbnail decoded on the worker pool.
      */
     void updatePixImage();
     /*!
@@ -113,6 +114,12 @@ Q_SIGNALS:
      */
     void itemClicked(MusicBackgroundListItem *item);
 
+private Q_SLOTS:
+    /*!
+     * Thumbnail decode finished.
+     */
+    void thumbnailFinished();
+
 protected:
     /*!
      * Override the widget event.
@@ -126,6 +133,7 @@ protected:
     bool m_closeMask, m_closeSet, m_showNameMask;
     QString m_name, m_path;
     MusicSkinConfigItem m_imageInfo;
+    QFutureWatcher<MusicSkinThumbnail> *m_thumbnailWatcher;
 
 };
 
@@ -169,9 +177,9 @@ public:
     void createItem(const QString &icon, bool state);
 
     /*!
-     * Update item by backgroud image.
+     * Update item by index and backgroud image.
      */
-    void updateItem(const MusicBackgroundImage &image, const QString &path);
+    void updateItem(int index, const MusicBackgroundImage &image, const QString &path);
 
     /*!
      * Current item contains or not.
@@ -204,6 +212,10 @@ public:
      * Item count.
      */
     inline int count() const { return m_items.count(); }
+    /*!
+     * Get item by index.
+     */
+    inline MusicBackgroundListItem* item(int index) const { return m_items.value(index); }
 
 Q_SIGNALS:
     /*!
@@ -4,8 +4,11 @@
 #include "musicwidgetheaders.h"
 
 #include <QDir>
+#include <QTimer>
 #include <QButtonGroup>
 
+#define VISIBLE_PRIORITY    1
+
 MusicBackgroundRemoteWidget::MusicBackgroundRemoteWidget(QWidget *parent)
     : QWidget(parent)
 {
@@ -22,6 +25,12 @@ MusicBackgroundRemoteWidget::MusicBackgroundRemoteWidget(QWidget *parent)
 
     m_downloadQueue = new MusicDownloadQueueRequest(MusicObject::DownloadBigBackground, this);
     connect(m_downloadQueue, SIGNAL(downLoadDataChanged(QString)), SLOT(downLoadFinished(QString)));
+
+    ///scrolling moves the widget many times a frame, check the visible items once
+    m_visibleTimer = new QTimer(this);
+    m_visibleTimer->setSingleShot(true);
+    m_visibleTimer->setInterval(0);
+    connect(m_visibleTimer, SIGNAL(timeout()), SLOT(updateVisibleItems()));
 }
 
 MusicBackgroundRemoteWidget::~MusicBackgroundRemoteWidget()
@@ -44,13 +53,28 @@ void MusicBackgroundRemoteWidget::downLoadFinished(const QString &data)
         return;
     }
 
+    int index = -1;
+    for(int i=0; i<m_queueDatas.count(); ++i)
+    {
+        if(m_queueDatas[i].m_savePath == data)
+        {
+            index = i;
+            break;
+        }
+    }
+
+    if(index == -1)
+    {
+        return;
+    }
+
     MusicBackgroundImage image;
     outputRemoteSkin(image, data);
     if(!image.isValid())
     {
         image.m_pix = QPixmap(":/image/lb_noneImage");
     }
-    m_backgroundList->updateItem(image, data);
+    m_backgroundList->updateItem(index, image, data);
 }
 
 void MusicBackgroundRemoteWidget::downLoadFinished(const MusicSkinRemoteGroups &data)
@@ -58,6 +82,49 @@ void MusicBackgroundRemoteWidget::downLoadFinished(const MusicSkinRemoteGroups &
     m_groups = data;
 }
 
+void MusicBackgroundRemoteWidget::updateVisibleItems()
+{
+    ///the visible items download first, the ones off screen wait until scrolled into view
+    for(int i=0; i<m_queueDatas.count(); ++i)
+    {
+        MusicBackgroundListItem *item = m_backgroundList->item(i);
+        if(!item || !item->getFileName().isEmpty())
+        {
+            continue;
+        }
+
+        if(isVisible() && !item->visibleRegion().isEmpty())
+        {
+            MusicDownloadQueueData data = m_queueDatas[i];
+            data.m_priority = VISIBLE_PRIORITY;
+            m_downloadQueue->setPriority(data);
+        }
+        else
+        {
+            m_downloadQueue->cancel(m_queueDatas[i].m_savePath);
+        }
+    }
+    m_downloadQueue->startToDownload();
+}
+
+void MusicBackgroundRemoteWidget::moveEvent(QMoveEvent *event)
+{
+    QWidget::moveEvent(event);
+    m_visibleTimer->start();
+}
+
+void MusicBackgroundRemoteWidget::resizeEvent(QResizeEvent *event)
+{
+    QWidget::resizeEvent(event);
+    m_visibleTimer->start();
+}
+
+void MusicBackgroundRemoteWidget::showEvent(QShowEvent *event)
+{
+    QWidget::showEvent(event);
+    m_visibleTimer->start();
+}
+
 void MusicBackgroundRemoteWidget::startToDownload(const QString &prefix)
 {
     if(m_groups.isEmpty())
@@ -69,7 +136,7 @@ void MusicBackgroundRemoteWidget::startToDownload(const QString &prefix)
     QDir().mkpath(path);
 
     m_backgroundList->clearAllItems();
-    MusicDownloadQueueDatas datas;
+    m_queueDatas.clear();
     MusicSkinRemoteItems *items = &m_groups[m_currentIndex].m_items;
     for(int i=0; i<items->count(); i++)
     {
@@ -77,11 +144,12 @@ void MusicBackgroundRemoteWidget::startToDownload(const QString &prefix)
         MusicDownloadQueueData data;
         data.m_url = (*items)[i].m_url;
         data.m_savePath = QString("%1/%2%3").arg(path).arg(i).arg(prefix);
-        datas << data;
+        m_queueDatas << data;
     }
 
-    m_downloadQueue->addImageQueue(datas);
-    m_downloadQueue->startToDownload();
+    ///reset the queue, the items are queued once laid out and visible
+    m_downloadQueue->addImageQueue(MusicDownloadQueueDatas());
+    m_visibleTimer->start();
 }
 
 
@@ -21,11 +21,12 @@
 
 #include <QWidget>
 #include "musicbackgroundlistwidget.h"
+#include "musicdownloadqueuerequest.h"
 #include "musicdownloadbackgroundremoterequest.h"
 
+class QTimer;
 class QPushButton;
 class QListWidgetItem;
-class MusicDownloadQueueRequest;
 
 /*! @brief The class of the remote background widget.
  * @author Greedysky <greedysky@163.com>
@@ -62,13 +63,27 @@ public Q_SLOTS:
      */
     virtual void downLoadFinished(const MusicSkinRemoteGroups &data);
 
+private Q_SLOTS:
+    /*!
+     * Queue the visible items first and cancel the ones off screen.
+     */
+    void updateVisibleItems();
+
 protected:
+    /*!
+     * Override the widget event.
+     */
+    virtual void moveEvent(QMoveEvent *event) override;
+    virtual void resizeEvent(QResizeEvent *event) override;
+    virtual void showEvent(QShowEvent *event) override;
     /*!
      * Start to download data.
      */
     void startToDownload(const QString &prefix);
 
     int m_currentIndex;
+    QTimer *m_visibleTimer;
+    MusicDownloadQueueDatas m_queueDatas;
     MusicSkinRemoteGroups m_groups;
     MusicBackgroundListWidget *m_backgroundList;
     MusicDownloadQueueRequest *m_downloadQueue;
@@ -31,6 +31,91 @@
         break;                                                                              \
     }
 
+#define ELIDED_CACHE_COUNT  1024
+#define ITEM_TEXT_MARGIN    3
+
+MusicSongsListItemDelegate::MusicSongsListItemDelegate(QObject *parent)
+    : QStyledItemDelegate(parent)
+{
+    m_hoverRow = -1;
+    m_hoverLoved = false;
+    m_musicSongs = nullptr;
+    m_elidedWidth = -1;
+    m_elidedNames.setMaxCost(ELIDED_CACHE_COUNT);
+}
+
+void MusicSongsListItemDelegate::setHoverRow(int row, bool loved)
+{
+    m_hoverRow = row;
+    m_hoverLoved = loved;
+}
+
+void MusicSongsListItemDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    const int row = index.row();
+    const bool hovered = (row == m_hoverRow);
+    if(hovered)
+    {
+        painter->fillRect(option.rect, QColor(20, 20, 20, 20));
+    }
+    QStyledItemDelegate::paint(painter, option, index);
+
+    if(!m_musicSongs || row < 0 || row >= m_musicSongs->count())
+    {
+        return;
+    }
+
+    QString text, icon;
+    const MusicSong &song = m_musicSongs->at(row);
+    switch(index.column())
+    {
+        case 0: icon = hovered ? ":/tiny/btn_play_later_normal" : QString(); break;
+        case 1: text = elidedName(option.font, song.getMusicName(), option.rect.width() - 10); break;
+        case 2: icon = hovered ? ":/tiny/btn_mv_normal" : QString(); break;
+        case 3: icon = hovered ? (m_hoverLoved ? ":/tiny/btn_loved_normal" : ":/tiny/btn_unloved_normal") : QString(); break;
+        case 4: icon = hovered ? ":/tiny/btn_delete_normal" : QString(); break;
+        case 5:
+            {
+                icon = hovered ? ":/tiny/btn_more_normal" : QString();
+                text = hovered ? QString() : song.getMusicPlayTime();
+                break;
+            }
+        default: break;
+    }
+
+    const QRect &rect = option.rect.adjusted(ITEM_TEXT_MARGIN, 0, 0, 0);
+    if(!icon.isEmpty())
+    {
+        QIcon(icon).paint(painter, rect, Qt::AlignLeft | Qt::AlignVCenter);
+    }
+    else if(!text.isEmpty())
+    {
+        painter->save();
+        painter->setFont(option.font);
+        painter->setPen(QColor(MusicUIObject::MQSSColor01));
+        painter->drawText(rect, Qt::AlignLeft | Qt::AlignVCenter, text);
+        painter->restore();
+    }
+}
+
+QString MusicSongsListItemDelegate::elidedName(const QFont &font, const QString &name, int width) const
+{
+    if(m_elidedWidth != width || m_elidedFont != font)
+    {
+        m_elidedNames.clear();
+        m_elidedWidth = width;
+        m_elidedFont = font;
+    }
+
+    QString *elided = m_elidedNames.object(name);
+    if(!elided)
+    {
+        elided = new QString(MusicUtils::Widget::elidedText(font, name, Qt::ElideRight, width));
+        m_elidedNames.insert(name, elided);
+    }
+    return *elided;
+}
+
 
 MusicSongsListTableWidget::MusicSongsListTableWidget(int index, QWidget *parent)
     : MusicAbstractSongsListTableWidget(parent), m_openFileWidget(nullptr),
@@ -47,6 +132,9 @@ MusicSongsListTableWidget::MusicSongsListTableWidget(int index, QWidget *parent)
     m_renameLineEditDelegate = nullptr;
     m_musicSort = nullptr;
 
+    m_songsItemDelegate = new MusicSongsListItemDelegate(this);
+    setItemDelegate(m_songsItemDelegate);
+
     setSelectionMode(QAbstractItemView::ExtendedSelection);
     setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
 
@@ -88,41 +176,10 @@ void MusicSongsListTableWidget::updateSongsFileName(const MusicSongs &songs)
         return;
     }
 
-    const int count = rowCount();
+    //rows hold no items, the delegate paints the visible ones from songs
+    m_songsItemDelegate->setMusicSongs(m_musicSongs);
     setRowCount(songs.count());
-    QHeaderView *headerview = horizontalHeader();
-    for(int i=count; i<songs.count(); i++)
-    {
-        QTableWidgetItem *item = new QTableWidgetItem;
-        setItem(i, 0, item);
-                          item = new QTableWidgetItem;
-        item->setText(MusicUtils::Widget::elidedText(font(), songs[i].getMusicName(), Qt::ElideRight, headerview->sectionSize(1) - 10));
-#if TTK_QT_VERSION_CHECK(5,13,0)
-        item->setForeground(QColor(MusicUIObject::MQSSColor01));
-#else
-        item->setTextColor(QColor(MusicUIObject::MQSSColor01));
-#endif
-        item->setTextAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-        setItem(i, 1, item);
-
-                          item = new QTableWidgetItem;
-        setItem(i, 2, item);
-
-                          item = new QTableWidgetItem;
-        setItem(i, 3, item);
-
-                          item = new QTableWidgetItem;
-        setItem(i, 4, item);
-
-                          item = new QTableWidgetItem(songs[i].getMusicPlayTime());
-#if TTK_QT_VERSION_CHECK(5,13,0)
-        item->setForeground(QColor(MusicUIObject::MQSSColor01));
-#else
-        item->setTextColor(QColor(MusicUIObject::MQSSColor01));
-#endif
-        item->setTextAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-        setItem(i, 5, item);
-    }
+    viewport()->update();
     //just fix table widget size hint
     setFixedHeight(allRowsHeight());
 }
@@ -152,6 +209,7 @@ void MusicSongsListTableWidget::setMusicSongsSearchedFileName(MusicSongs *songs,
         }
         m_listHasSearched = false;
         m_musicSongs = songs;
+        m_searchedIndexs.clear();
     }
     else
     {
@@ -161,6 +219,7 @@ void MusicSongsListTableWidget::setMusicSongsSearchedFileName(MusicSongs *songs,
         }
         m_listHasSearched = true;
         m_musicSongs = new MusicSongs;
+        m_searchedIndexs = fileIndexs;
         foreach(int index, fileIndexs)
         {
             m_musicSongs->append((*songs)[index]);
@@ -240,40 +299,12 @@ void MusicSongsListTableWidget::replacePlayWidgetRow()
         m_playRowIndex = 0;
     }
 
-    const QString &name = !m_musicSongs->isEmpty() ? m_musicSongs->at(m_playRowIndex).getMusicName() : QString();
-
     setRowHeight(m_playRowIndex, ITEM_ROW_HEIGHT_M);
 
     removeCellWidget(m_playRowIndex, 0);
     delete takeItem(m_playRowIndex, 0);
     clearSpans();
 
-    QHeaderView *headerview = horizontalHeader();
-    QTableWidgetItem *item = new QTableWidgetItem;
-    setItem(m_playRowIndex, 0, item);
-
-    item = new QTableWidgetItem(MusicUtils::Widget::elidedText(font(), name, Qt::ElideRight, headerview->sectionSize(1) - 10));
-#if TTK_QT_VERSION_CHECK(5,13,0)
-    item->setForeground(QColor(MusicUIObject::MQSSColor01));
-#else
-    item->setTextColor(QColor(MusicUIObject::MQSSColor01));
-#endif
-    item->setTextAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-
-    setItem(m_playRowIndex, 1, item);
-    setItem(m_playRowIndex, 2, new QTableWidgetItem);
-    setItem(m_playRowIndex, 3, new QTableWidgetItem);
-    setItem(m_playRowIndex, 4, new QTableWidgetItem);
-
-    item = new QTableWidgetItem((*m_musicSongs)[m_playRowIndex].getMusicPlayTime());
-#if TTK_QT_VERSION_CHECK(5,13,0)
-    item->setForeground(QColor(MusicUIObject::MQSSColor01));
-#else
-    item->setTextColor(QColor(MusicUIObject::MQSSColor01));
-#endif
-    item->setTextAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-    setItem(m_playRowIndex, 5, item);
-
     delete m_musicSongsPlayWidget;
     m_musicSongsPlayWidget = nullptr;
 
@@ -307,61 +338,10 @@ bool MusicSongsListTableWidget::createUploadFileWidget()
 
 void MusicSongsListTableWidget::itemCellEntered(int row, int column)
 {
-    ///clear previous table item state
-    QTableWidgetItem *it = item(m_previousColorRow, 0);
-    if(it)
-    {
-        it->setIcon(QIcon());
-    }
-
-    it = item(m_previousColorRow, 2);
-    if(it)
-    {
-        it->setIcon(QIcon());
-    }
-
-    it = item(m_previousColorRow, 3);
-    if(it)
-    {
-        it->setIcon(QIcon());
-    }
-
-    it = item(m_previousColorRow, 4);
-    if(it)
-    {
-        it->setIcon(QIcon());
-    }
-
-    it = item(m_previousColorRow, 5);
-    if(it)
-    {
-        it->setIcon(QIcon());
-        it->setText((*m_musicSongs)[m_previousColorRow].getMusicPlayTime());
-    }
-
-    ///draw new table item state
-    if((it = item(row, 0)))
-    {
-        it->setIcon(QIcon(":/tiny/btn_play_later_normal"));
-    }
-    if((it = item(row, 2)))
-    {
-        it->setIcon(QIcon(":/tiny/btn_mv_normal"));
-    }
-    if((it = item(row, 3)))
-    {
-        const bool contains = MusicApplication::instance()->musicListLovestContains(row);
-        it->setIcon(QIcon(contains ? ":/tiny/btn_loved_normal" : ":/tiny/btn_unloved_normal"));
-    }
-    if((it = item(row, 4)))
-    {
-        it->setIcon(QIcon(":/tiny/btn_delete_normal"));
-    }
-    if((it = item(row, 5)))
-    {
-        it->setText(QString());
-        it->setIcon(QIcon(":/tiny/btn_more_normal"));
-    }
+    ///draw new table item state, the play row is covered by the play widget
+    const bool contains = (row >= 0 && row != m_playRowIndex) ? MusicApplication::instance()->musicListLovestContains(row) : false;
+    m_songsItemDelegate->setHoverRow(row != m_playRowIndex ? row : -1, contains);
+    viewport()->update();
 
     if(column != 1)
     {
@@ -415,11 +395,8 @@ void MusicSongsListTableWidget::itemCellClicked(int row, int column)
                 }
 
                 const bool contains = !MusicApplication::instance()->musicListLovestContains(row);
-                QTableWidgetItem *it = item(row, 3);
-                if(it)
-                {
-                    it->setIcon(QIcon(contains ? ":/tiny/btn_loved_normal" : ":/tiny/btn_unloved_normal"));
-                }
+                m_songsItemDelegate->setHoverRow(row, contains);
+                viewport()->update();
                 Q_EMIT musicListSongToLovestListAt(contains, row);
                 break;
             }
@@ -501,6 +478,18 @@ void MusicSongsListTableWidget::setDeleteItemWithFile()
     m_deleteItemWithFile = false;
 }
 
+void MusicSongsListTableWidget::musicFileInformation()
+{
+    const int row = currentRow();
+    MusicAbstractSongsListTableWidget::musicFileInformation();
+
+    ///the tag may be saved, let the list refresh what it keeps about the song
+    if(row >= 0 && row < m_musicSongs->count())
+    {
+        Q_EMIT musicListSongChanged(m_parentToolIndex, mapSongRow(row));
+    }
+}
+
 void MusicSongsListTableWidget::showTimeOut()
 {
     m_timerShow.stop();
@@ -511,8 +500,10 @@ void MusicSongsListTableWidget::showTimeOut()
             return;
         }
 
-        const MusicSong &song = (*m_musicSongs)[m_previousColorRow];
-        m_musicSongsInfoWidget->setMusicSongInformation(song);
+        ///the songs loaded from snapshot stat their files only when shown
+        MusicSong *song = &(*m_musicSongs)[m_previousColorRow];
+        song->updateMusicStat();
+        m_musicSongsInfoWidget->setMusicSongInformation(*song);
         m_musicSongsInfoWidget->move(mapToGlobal(QPoint(width(), 0)).x() + 8, QCursor::pos().y());
 
         bool state;
@@ -547,8 +538,9 @@ void MusicSongsListTableWidget::setChangSongName()
     m_renameLineEditDelegate = new MusicRenameLineEditDelegate(this);
     setItemDelegateForRow(currentRow(), m_renameLineEditDelegate);
     m_renameActived = true;
-    m_renameItem = item(currentRow(), 1);
-    m_renameItem->setText((*m_musicSongs)[m_renameItem->row()].getMusicName());
+    //only the renaming row holds an item while the editor is open
+    m_renameItem = new QTableWidgetItem((*m_musicSongs)[currentRow()].getMusicName());
+    setItem(currentRow(), 1, m_renameItem);
     openPersistentEditor(m_renameItem);
     editItem(m_renameItem);
 }
@@ -616,7 +608,7 @@ void MusicSongsListTableWidget::musicAddToPlayedList()
 
 void MusicSongsListTableWidget::setItemRenameFinished(const QString &name)
 {
-    (*m_musicSongs)[m_playRowIndex].setMusicName(name);
+    setMusicSongName(m_playRowIndex, name);
 }
 
 void MusicSongsListTableWidget::musicListSongSortBy(QAction *action)
@@ -803,12 +795,12 @@ void MusicSongsListTableWidget::closeRenameItem()
     //the two if function to deal with
     if(m_renameActived)
     {
-        QHeaderView *headerview = horizontalHeader();
-        (*m_musicSongs)[m_renameItem->row()].setMusicName(m_renameItem->text());
-        m_renameItem->setText(MusicUtils::Widget::elidedText(font(), m_renameItem->text(), Qt::ElideRight, headerview->sectionSize(1) - 10));
+        const int row = m_renameItem->row();
+        setMusicSongName(row, m_renameItem->text());
 
         m_renameActived = false;
-        setItemDelegateForRow(m_renameItem->row(), nullptr);
+        setItemDelegateForRow(row, nullptr);
+        delete takeItem(row, 1);
         m_renameItem = nullptr;
 
         delete m_renameLineEditDelegate;
@@ -816,6 +808,18 @@ void MusicSongsListTableWidget::closeRenameItem()
     }
 }
 
+void MusicSongsListTableWidget::setMusicSongName(int row, const QString &name)
+{
+    ///a searched table holds a copy of the songs, the full list is renamed by the receiver
+    (*m_musicSongs)[row].setMusicName(name);
+    Q_EMIT musicListSongRenamed(m_parentToolIndex, mapSongRow(row), name);
+}
+
+int MusicSongsListTableWidget::mapSongRow(int row) const
+{
+    return m_listHasSearched ? m_searchedIndexs.value(row, -1) : row;
+}
+
 void MusicSongsListTableWidget::startToDrag()
 {
     bool empty;
@@ -848,17 +852,8 @@ void MusicSongsListTableWidget::startToDrag()
         }
 
         Q_EMIT getMusicIndexSwaped(start, end, index, songs);
-        for(int i=qMin(start, end); i<=qMax(start, end); ++i)
-        {
-            if(i == index)
-            {
-                continue; //skip the current play item index, because the play widget just has one item
-            }
-
-            QHeaderView *headerview = horizontalHeader();
-            item(i, 1)->setText(MusicUtils::Widget::elidedText(font(), songs[i].getMusicName(), Qt::ElideRight, headerview->sectionSize(1) - 10));
-            item(i, 5)->setText(songs[i].getMusicPlayTime());
-        }
+        //the swapped rows are painted from the songs directly
+        viewport()->update();
 
         bool state;
         Q_EMIT isCurrentIndex(state);
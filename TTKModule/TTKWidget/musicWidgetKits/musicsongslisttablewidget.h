@@ -20,6 +20,8 @@
  ================================================= */
 
 #include <QTimer>
+#include <QCache>
+#include <QStyledItemDelegate>
 #include "musicabstractsongslisttablewidget.h"
 
 class QPropertyAnimation;
@@ -28,6 +30,49 @@ class MusicSongsListPlayWidget;
 class MusicSongsListItemInfoWidget;
 class MusicRenameLineEditDelegate;
 
+/*! @brief The class of the songs list item delegate.
+ * @author Greedysky <greedysky@163.com>
+ */
+class MUSIC_WIDGET_EXPORT MusicSongsListItemDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+    TTK_DECLARE_MODULE(MusicSongsListItemDelegate)
+public:
+    /*!
+     * Object contsructor.
+     */
+    explicit MusicSongsListItemDelegate(QObject *parent = nullptr);
+
+    /*!
+     * Set the songs which rows are painted from.
+     */
+    inline void setMusicSongs(const MusicSongs *songs) { m_musicSongs = songs; }
+    /*!
+     * Set current hovered row and its lovest state.
+     */
+    void setHoverRow(int row, bool loved);
+
+    /*!
+     * Override paint.
+     */
+    virtual void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+
+private:
+    /*!
+     * Get the elided song name, cached by name until font or width changed.
+     */
+    QString elidedName(const QFont &font, const QString &name, int width) const;
+
+    int m_hoverRow;
+    bool m_hoverLoved;
+    const MusicSongs *m_musicSongs;
+    mutable QFont m_elidedFont;
+    mutable int m_elidedWidth;
+    mutable QCache<QString, QString> m_elidedNames;
+
+};
+
+
 /*! @brief The class of the songs list table widget.
  * @author Greedysky <greedysky@163.com>
  */
@@ -107,6 +152,14 @@ Q_SIGNALS:
      * Swap the current play index when user drag and drop.
      */
     void getMusicIndexSwaped(int before, int after, int play, MusicSongs &songs);
+    /*!
+     * The song of list at row has been renamed, row is in the full list.
+     */
+    void musicListSongRenamed(int index, int row, const QString &name);
+    /*!
+     * The song of list at row may have changed, such as its tag, row is in the full list.
+     */
+    void musicListSongChanged(int index, int row);
     /*!
      * Add or remove music list song to lovest list by row.
      */
@@ -137,6 +190,10 @@ public Q_SLOTS:
      * Delete item or items from list with file.
      */
     void setDeleteItemWithFile();
+    /*!
+     * Open music file information widget.
+     */
+    virtual void musicFileInformation() override;
     /*!
      * Show play item information widget.
      */
@@ -192,6 +249,14 @@ protected:
      * Close rename item.
      */
     void closeRenameItem();
+    /*!
+     * Rename the song at shown row and notify its row in the full list.
+     */
+    void setMusicSongName(int row, const QString &name);
+    /*!
+     * Map the shown row to the row in the full list.
+     */
+    int mapSongRow(int row) const;
     /*!
      * Start to drag to play list.
      */
@@ -211,9 +276,11 @@ protected:
     MusicSongsListPlayWidget *m_musicSongsPlayWidget;
 
     bool m_leftButtonPressed, m_listHasSearched;
+    TTKIntList m_searchedIndexs;
     bool m_renameActived, m_deleteItemWithFile;
     QTableWidgetItem *m_renameItem;
     MusicRenameLineEditDelegate *m_renameLineEditDelegate;
+    MusicSongsListItemDelegate *m_songsItemDelegate;
     MusicSort *m_musicSort;
 
 };
@@ -23,11 +23,17 @@
 #include "musictinyuiobject.h"
 #include "musicdispatchmanager.h"
 #include "musictkplconfigmanager.h"
+#include "musictkpbconfigmanager.h"
+#include "musicplaylistjournal.h"
 #include "musicextractwrap.h"
+#include "musicsongtagmanager.h"
 
+#include <QTimer>
 #include <QMimeData>
 #include <QFileDialog>
 
+#define SETTING_SAVE_INTERVAL   (5 * MT_S2MS)
+
 MusicApplication *MusicApplication::m_instance = nullptr;
 
 MusicApplication::MusicApplication(QWidget *parent)
@@ -97,6 +103,14 @@ MusicApplication::MusicApplication(QWidget *parent)
 
     readXMLConfigFromText();
 
+    ///settings loaded at startup are already on disk
+    M_SETTING_PTR->takeDirty();
+    m_settingSaveTimer = new QTimer(this);
+    m_settingSaveTimer->setSingleShot(true);
+    m_settingSaveTimer->setInterval(SETTING_SAVE_INTERVAL);
+    connect(m_settingSaveTimer, SIGNAL(timeout()), SLOT(saveSettingParameter()));
+    connect(M_SETTING_PTR, SIGNAL(parameterChanged(MusicSettingManager::ConfigType,QVariant)), m_settingSaveTimer, SLOT(start()));
+
     QTimer::singleShot(MT_MS, m_rightAreaWidget, SLOT(musicLoadSongIndexWidget()));
 }
 
@@ -294,11 +308,25 @@ qint64 MusicApplication::duration() const
     return m_musicPlayer->duration();
 }
 
+qint64 MusicApplication::position() const
+{
+    return m_musicPlayer->position();
+}
+
 MusicObject::PlayMode MusicApplication::getPlayMode() const
 {
     return m_musicPlaylist->playbackMode();
 }
 
+void MusicApplication::saveSettingParameter()
+{
+    if(M_SETTING_PTR->takeDirty())
+    {
+        MusicConfigManager xml;
+        xml.writeSysConfigData();
+    }
+}
+
 void MusicApplication::quitWindowClose()
 {
     //Write configuration files
@@ -1122,12 +1150,24 @@ void MusicApplication::readXMLConfigFromText()
 
     //Path configuration song
     MusicSongItems songs;
-    MusicTKPLConfigManager listXml;
-    if(listXml.readConfig())
+    MusicTKPBConfigManager listSnapshot;
+    if(!listSnapshot.readConfig() || !listSnapshot.readPlaylistData(songs))
     {
-        listXml.readPlaylistData(songs);
+        ///no usable snapshot, import from the tkpl file
+        MusicTKPLConfigManager listXml;
+        if(listXml.readConfig())
+        {
+            listXml.readPlaylistData(songs);
+        }
     }
+    ///apply the changes logged after the snapshot written
+    const bool journal = M_PLAYLIST_JOURNAL_PTR->replay(listSnapshot.generation(), songs);
     const bool success = m_musicSongTreeWidget->addMusicLists(songs);
+    if(!journal || !success)
+    {
+        ///the journal needs a snapshot of current lists to base on
+        M_PLAYLIST_JOURNAL_PTR->compact(m_musicSongTreeWidget->getMusicLists(), true);
+    }
     //
     MusicConfigManager xml;
     if(!xml.readConfig())
@@ -1293,6 +1333,10 @@ void MusicApplication::writeXMLConfigToText()
     M_SETTING_PTR->setValue(MusicSettingManager::ShowDesktopLrc, m_rightAreaWidget->getDestopLrcVisible());
     xml.writeSysConfigData();
 
+    const MusicSongItems &items = m_musicSongTreeWidget->getMusicLists();
     MusicTKPLConfigManager listXml;
-    listXml.writePlaylistData(m_musicSongTreeWidget->getMusicLists());
+    listXml.writePlaylistData(items);
+    M_PLAYLIST_JOURNAL_PTR->compact(items, true);
+
+    M_SONGTAG_PTR->save();
 }
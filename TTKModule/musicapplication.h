@@ -29,6 +29,7 @@ class MusicTopAreaWidget;
 class MusicRightAreaWidget;
 class MusicLeftAreaWidget;
 class MusicApplicationObject;
+class QTimer;
 
 namespace Ui {
 class MusicApplication;
@@ -112,6 +113,10 @@ public:
      * Get current player duration.
      */
     qint64 duration() const;
+    /*!
+     * Get current player position.
+     */
+    qint64 position() const;
     /*!
      * Get current play mode.
      */
@@ -298,6 +303,10 @@ public Q_SLOTS:
      * Get current play lists.
      */
     void getCurrentPlaylist(QStringList &list);
+    /*!
+     * Write the changed settings parameter, batched after a quiet interval.
+     */
+    void saveSettingParameter();
 
 protected:
     virtual void resizeEvent(QResizeEvent *event) override;
@@ -338,6 +347,7 @@ private:
     MusicRightAreaWidget *m_rightAreaWidget;
     MusicLeftAreaWidget *m_leftAreaWidget;
     MusicApplicationObject *m_applicationObject;
+    QTimer *m_settingSaveTimer;
 
     static MusicApplication *m_instance;
 
@@ -6,6 +6,7 @@
 #include "musiclrccontainerforwallpaper.h"
 #include "musicvideoplaywidget.h"
 #include "musicdownloadstatusobject.h"
+#include "musiclrcboundarytimer.h"
 #include "musicsettingwidget.h"
 #include "musictoastlabel.h"
 #include "musicalbumquerywidget.h"
@@ -30,6 +31,7 @@
 
 #include "qkugou/qkugouwindow.h"
 
+#include <QTimer>
 #include <QPropertyAnimation>
 
 MusicRightAreaWidget *MusicRightAreaWidget::m_instance = nullptr;
@@ -48,6 +50,10 @@ MusicRightAreaWidget::MusicRightAreaWidget(QWidget *parent)
     m_lrcAnalysis = new MusicLrcAnalysis(this);
     m_lrcAnalysis->setLineMax(MUSIC_LRC_INTERIOR_MAX_LINE);
 
+    ///line switches are scheduled at the lrc time instead of the next player tick
+    m_lrcBoundaryTimer = new MusicLrcBoundaryTimer(m_lrcAnalysis, this);
+    connect(m_lrcBoundaryTimer, SIGNAL(timeout()), SLOT(lrcBoundaryTimeout()));
+
     m_downloadStatusObject = new MusicDownloadStatusObject(parent);
     m_settingWidget = new MusicSettingWidget(this);
     connect(m_settingWidget, SIGNAL(parameterSettingChanged()), parent, SLOT(applySettingParameter()));
@@ -175,6 +181,8 @@ void MusicRightAreaWidget::updateCurrentLrc(qint64 current, qint64 total, bool p
             }
         }
     }
+
+    m_lrcBoundaryTimer->schedule(current, playStatus);
 }
 
 void MusicRightAreaWidget::loadCurrentSongLrc(const QString &name, const QString &path) const
@@ -866,6 +874,13 @@ void MusicRightAreaWidget::musicChangeDownloadCustumWidget()
     showSettingWidget();
 }
 
+void MusicRightAreaWidget::lrcBoundaryTimeout()
+{
+    ///read the audio clock again, the timer may fire a little early
+    const MusicApplication *w = MusicApplication::instance();
+    updateCurrentLrc(w->position(), w->duration(), !w->isPlaying());
+}
+
 void MusicRightAreaWidget::musicFunctionParameterInit(MusicFunction func)
 {
     if(M_SETTING_PTR->value(MusicSettingManager::WindowConcise).toBool())
@@ -27,6 +27,7 @@ class MusicVideoPlayWidget;
 class MusicDownloadStatusObject;
 
 class MusicLrcAnalysis;
+class MusicLrcBoundaryTimer;
 class MusicLrcContainerForInterior;
 class MusicLrcContainerForDesktop;
 class MusicLrcContainerForWallpaper;
@@ -297,6 +298,10 @@ public Q_SLOTS:
      * Change to download custum widget.
      */
     void musicChangeDownloadCustumWidget();
+    /*!
+     * Update current lrc at the next line boundary.
+     */
+    void lrcBoundaryTimeout();
 
 protected:
     /*!
@@ -310,6 +315,7 @@ protected:
     MusicSettingWidget *m_settingWidget;
     MusicVideoPlayWidget *m_videoPlayerWidget;
 
+    MusicLrcBoundaryTimer *m_lrcBoundaryTimer;
     MusicLrcAnalysis *m_lrcAnalysis;
     MusicLrcContainerForInterior *m_musicLrcForInterior;
     MusicLrcContainerForDesktop *m_musicLrcForDesktop;
@@ -20,6 +20,8 @@ include($$PWD/TTKVersion.pri)
 
 TEMPLATE = subdirs
 SUBDIRS = TTKConfig TTKQrc TTKThirdParty TTKModule TTKService TTKRun
+##qmake CONFIG+=ttk_build_test
+ttk_build_test:SUBDIRS += TTKTest
 
 TRANSLATIONS += TTKLanguage/cn.ts \
                 TTKLanguage/tc.ts \
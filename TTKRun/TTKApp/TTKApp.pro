@@ -33,15 +33,18 @@ win32:msvc{
 
 win32{
     DESTDIR = $$OUT_PWD/../../bin/$$TTKMusicPlayer
-    LIBS += -L$$DESTDIR -lTTKConfig
+    LIBS += -L$$DESTDIR -lTTKConfig -lTTKDumper
 }
 else{
     DESTDIR = $$OUT_PWD/../../bin
     DEFINES += CONFIG_OUT_BUILD
-    SOURCES += $$PWD/../../TTKConfig/musicconfigobject.cpp
+    SOURCES += \
+        $$PWD/../../TTKConfig/musicconfigobject.cpp \
+        $$PWD/../../TTKThirdParty/TTKDumper/ttklogger.cpp
     HEADERS += \
         $$PWD/../../TTKConfig/musicconfigobject.h \
-        $$PWD/../../TTKConfig/musicconfigdefine.h
+        $$PWD/../../TTKConfig/musicconfigdefine.h \
+        $$PWD/../../TTKThirdParty/TTKDumper/ttklogger.h
 }
 
 INCLUDEPATH += \
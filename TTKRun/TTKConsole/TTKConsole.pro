@@ -27,7 +27,7 @@ DEFINES += TTK_LIBRARY
 DESTDIR = $$OUT_PWD/../../bin/$$TTKMusicPlayer
 TARGET = TTKConsole
 
-LIBS += -L$$DESTDIR -lTTKCore
+LIBS += -L$$DESTDIR -lTTKCore -lTTKDumper
 unix:LIBS += -L$$DESTDIR -lqmmp -lTTKUi -lTTKExtras -lTTKWatcher -lzlib -lTTKZip
 
 win32:msvc{
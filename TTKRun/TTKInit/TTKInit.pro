@@ -31,7 +31,7 @@ win32:msvc{
     QMAKE_CXXFLAGS += -std=c++11
 }
 
-LIBS += -L$$DESTDIR -lTTKConfig
+LIBS += -L$$DESTDIR -lTTKConfig -lTTKDumper
 
 INCLUDEPATH += \
     $$PWD/../ \
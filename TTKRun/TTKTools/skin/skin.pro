@@ -41,7 +41,7 @@ INCLUDEPATH += \
     $$PWD/../../../TTKModule/TTKCore/musicUtilsKits \
     $$PWD/../../../TTKModule/TTKWidget/musicCoreKits \
 
-LIBS += -L$$OUT_PWD/../../../bin/$$TTKMusicPlayer -lTTKCore
+LIBS += -L$$OUT_PWD/../../../bin/$$TTKMusicPlayer -lTTKCore -lTTKDumper
 unix:LIBS += -L$$OUT_PWD/../../../bin/$$TTKMusicPlayer -lqmmp -lTTKUi -lTTKExtras -lTTKWatcher -lzlib -lTTKZip
 
 SOURCES += \
@@ -40,7 +40,7 @@ INCLUDEPATH += \
     $$PWD/../../../TTKModule/TTKCore/musicCoreKits \
     $$PWD/../../../TTKModule/TTKCore/musicUtilsKits
 
-LIBS += -L$$OUT_PWD/../../../bin/$$TTKMusicPlayer -lTTKCore
+LIBS += -L$$OUT_PWD/../../../bin/$$TTKMusicPlayer -lTTKCore -lTTKDumper
 unix:LIBS += -L$$OUT_PWD/../../../bin/$$TTKMusicPlayer -lqmmp -lTTKUi -lTTKExtras -lTTKWatcher -lzlib -lTTKZip
 
 SOURCES += \
@@ -0,0 +1,313 @@
+#include "musicdownloaddatarequesttest.h"
+#include "musicdownloaddatarequest.h"
+
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QNetworkProxy>
+#include <QCryptographicHash>
+
+#define TEST_DATA_SIZE      (256 * 1024)
+#define TEST_CUT_SIZE       (100 * 1000)
+#define TEST_TIMEOUT        (10 * MT_S2MS)
+#define TEST_ETAG           "\"ttk-song\""
+
+/*! @brief The class of the request the test server received.
+ * @author Greedysky <greedysky@163.com>
+ */
+typedef struct MusicDownloadServerRequest
+{
+    QString m_range;        /*!< range header*/
+    QString m_ifRange;      /*!< if range header*/
+}MusicDownloadServerRequest;
+
+/*! @brief The class of the http server stand in which cuts the data.
+ * Whole data responses stop after the cut size, and the first drop count
+ * of range responses close before any body.
+ * @author Greedysky <greedysky@163.com>
+ */
+class MusicDownloadServer : public QThread
+{
+public:
+    MusicDownloadServer(const QByteArray &data, const QByteArray &checksum, int cut, int drops)
+        : m_data(data),
+          m_checksum(checksum),
+          m_cut(cut),
+          m_drops(drops),
+          m_port(0)
+    {
+        start();
+        m_ready.acquire();
+    }
+
+    ~MusicDownloadServer()
+    {
+        m_quit.storeRelease(1);
+        wait();
+    }
+
+    inline QString url() const { return QString("http://127.0.0.1:%1/song.mp3").arg(m_port); }
+
+    void reset(int cut, int drops)
+    {
+        QMutexLocker locker(&m_mutex);
+        m_cut = cut;
+        m_drops = drops;
+        m_requests.clear();
+    }
+
+    QList<MusicDownloadServerRequest> requests()
+    {
+        QMutexLocker locker(&m_mutex);
+        return m_requests;
+    }
+
+protected:
+    virtual void run() override
+    {
+        QTcpServer server;
+        server.listen(QHostAddress::LocalHost);
+        m_port = server.serverPort();
+        m_ready.release();
+
+        while(m_quit.loadAcquire() == 0)
+        {
+            if(server.waitForNewConnection(100))
+            {
+                QTcpSocket *socket = server.nextPendingConnection();
+                response(socket);
+                delete socket;
+            }
+        }
+    }
+
+    void response(QTcpSocket *socket)
+    {
+        QByteArray header;
+        while(!header.contains("\r\n\r\n"))
+        {
+            if(socket->bytesAvailable() == 0 && !socket->waitForReadyRead(TEST_TIMEOUT))
+            {
+                return;
+            }
+            header += socket->readAll();
+        }
+
+        MusicDownloadServerRequest request;
+        foreach(const QByteArray &line, header.split('\n'))
+        {
+            const QString key = QString(line).section(':', 0, 0).trimmed().toLower();
+            const QString value = QString(line).section(':', 1).trimmed();
+            if(key == "range")
+            {
+                request.m_range = value;
+            }
+            else if(key == "if-range")
+            {
+                request.m_ifRange = value;
+            }
+        }
+
+        QMutexLocker locker(&m_mutex);
+        m_requests << request;
+
+        QByteArray head, body;
+        QRegExp regx("bytes=(\\d+)-(\\d+)");
+        if(regx.indexIn(request.m_range) != -1)
+        {
+            const int start = regx.cap(1).toInt();
+            const int end = regx.cap(2).toInt();
+            head = "HTTP/1.1 206 Partial Content\r\n";
+            head += QString("Content-Range: bytes %1-%2/%3\r\n").arg(start).arg(end).arg(m_data.size()).toUtf8();
+            head += QString("Content-Length: %1\r\n").arg(end - start + 1).toUtf8();
+            body = (m_drops-- > 0) ? QByteArray() : m_data.mid(start, end - start + 1);
+        }
+        else
+        {
+            head = "HTTP/1.1 200 OK\r\n";
+            head += QString("Content-Length: %1\r\n").arg(m_data.size()).toUtf8();
+            head += "Accept-Ranges: bytes\r\n";
+            if(!m_checksum.isEmpty())
+            {
+                head += "Content-MD5: " + m_checksum + "\r\n";
+            }
+            body = m_cut >= 0 ? m_data.left(m_cut) : m_data;
+        }
+        head += "ETag: " TEST_ETAG "\r\n";
+        head += "Connection: close\r\n\r\n";
+
+        socket->write(head + body);
+        socket->waitForBytesWritten(TEST_TIMEOUT);
+        socket->disconnectFromHost();
+        if(socket->state() != QAbstractSocket::UnconnectedState)
+        {
+            socket->waitForDisconnected(TEST_TIMEOUT);
+        }
+    }
+
+private:
+    QByteArray m_data, m_checksum;
+    int m_cut, m_drops;
+    quint16 m_port;
+    QSemaphore m_ready;
+    QAtomicInt m_quit;
+    QMutex m_mutex;
+    QList<MusicDownloadServerRequest> m_requests;
+
+};
+
+///download url to save path, return the result the request sent
+static QString download(const QString &url, const QString &save)
+{
+    MusicDownloadDataRequest *request = new MusicDownloadDataRequest(url, save, MusicObject::DownloadOther);
+    QSignalSpy spy(request, SIGNAL(downLoadDataChanged(QString)));
+    request->startToDownload();
+
+    const bool finished = spy.wait(TEST_TIMEOUT);
+    ///the request releases itself later, do it now before the next download
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    return finished ? spy.first().first().toString() : QString();
+}
+
+static QByteArray readFile(const QString &path)
+{
+    QFile file(path);
+    return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+}
+
+static QByteArray md5Base64(const QByteArray &data)
+{
+    return QCryptographicHash::hash(data, QCryptographicHash::Md5).toBase64();
+}
+
+void MusicDownloadDataRequestTest::initTestCase()
+{
+    QNetworkProxy::setApplicationProxy(QNetworkProxy::NoProxy);
+
+    m_dir = QDir::tempPath() + "/ttkdownloadtest";
+    QDir(m_dir).removeRecursively();
+    QVERIFY(QDir().mkpath(m_dir));
+
+    quint32 seed = 12345;
+    m_data.resize(TEST_DATA_SIZE);
+    for(int i=0; i<m_data.size(); ++i)
+    {
+        seed = seed * 1103515245 + 12345;
+        m_data[i] = TTKStatic_cast(char, seed >> 16);
+    }
+}
+
+void MusicDownloadDataRequestTest::cleanupTestCase()
+{
+    QDir(m_dir).removeRecursively();
+}
+
+void MusicDownloadDataRequestTest::resumeAfterCutBody()
+{
+    const QString &save = m_dir + "/cut.mp3";
+    MusicDownloadServer server(m_data, md5Base64(m_data), TEST_CUT_SIZE, 0);
+    QCOMPARE(download(server.url(), save), QString("DownloadOther"));
+
+    const QList<MusicDownloadServerRequest> &requests = server.requests();
+    QCOMPARE(requests.count(), 2);
+    QVERIFY(requests[0].m_range.isEmpty());
+    QCOMPARE(requests[1].m_range, QString("bytes=%1-%2").arg(TEST_CUT_SIZE).arg(TEST_DATA_SIZE - 1));
+    QCOMPARE(requests[1].m_ifRange, QString(TEST_ETAG));
+
+    QVERIFY(readFile(save) == m_data);
+    QVERIFY(!QFile::exists(save + DOWNLOAD_PART_FILE));
+    QVERIFY(!QFile::exists(save + DOWNLOAD_JOURNAL_FILE));
+}
+
+void MusicDownloadDataRequestTest::segmentRetry_data()
+{
+    QTest::addColumn<int>("drops");
+    QTest::addColumn<bool>("finished");
+
+    QTest::newRow("one drop") << 1 << true;
+    QTest::newRow("all retries") << DOWNLOAD_RETRY_COUNT << true;
+    QTest::newRow("retries run out") << DOWNLOAD_RETRY_COUNT + 1 << false;
+}
+
+void MusicDownloadDataRequestTest::segmentRetry()
+{
+    QFETCH(int, drops);
+    QFETCH(bool, finished);
+
+    const QString &save = m_dir + "/retry.mp3";
+    QFile::remove(save);
+    QFile::remove(save + DOWNLOAD_PART_FILE);
+    QFile::remove(save + DOWNLOAD_JOURNAL_FILE);
+
+    MusicDownloadServer server(m_data, QByteArray(), TEST_CUT_SIZE, drops);
+    QCOMPARE(download(server.url(), save), QString(finished ? "DownloadOther" : "The file create failed"));
+
+    ///every retry asks for the rest of the cut body again
+    const QList<MusicDownloadServerRequest> &requests = server.requests();
+    QCOMPARE(requests.count(), 1 + qMin(drops + 1, DOWNLOAD_RETRY_COUNT + 1));
+    for(int i=1; i<requests.count(); ++i)
+    {
+        QCOMPARE(requests[i].m_range, QString("bytes=%1-%2").arg(TEST_CUT_SIZE).arg(TEST_DATA_SIZE - 1));
+    }
+
+    QCOMPARE(QFile::exists(save), finished);
+    QCOMPARE(QFile::exists(save + DOWNLOAD_PART_FILE), !finished);
+    QCOMPARE(QFile::exists(save + DOWNLOAD_JOURNAL_FILE), !finished);
+    if(finished)
+    {
+        QVERIFY(readFile(save) == m_data);
+    }
+}
+
+void MusicDownloadDataRequestTest::journalResumesNextDownload()
+{
+    const QString &save = m_dir + "/journal.mp3";
+    MusicDownloadServer server(m_data, md5Base64(m_data), TEST_CUT_SIZE, DOWNLOAD_RETRY_COUNT + 1);
+    QCOMPARE(download(server.url(), save), QString("The file create failed"));
+
+    QCOMPARE(readFile(save + DOWNLOAD_PART_FILE).left(TEST_CUT_SIZE), m_data.left(TEST_CUT_SIZE));
+    QVERIFY(QFile::exists(save + DOWNLOAD_JOURNAL_FILE));
+
+    ///the next download of the same url asks for the rest only
+    server.reset(-1, 0);
+    QCOMPARE(download(server.url(), save), QString("DownloadOther"));
+
+    const QList<MusicDownloadServerRequest> &requests = server.requests();
+    QCOMPARE(requests.count(), 1);
+    QCOMPARE(requests[0].m_range, QString("bytes=%1-%2").arg(TEST_CUT_SIZE).arg(TEST_DATA_SIZE - 1));
+    QCOMPARE(requests[0].m_ifRange, QString(TEST_ETAG));
+
+    QVERIFY(readFile(save) == m_data);
+    QVERIFY(!QFile::exists(save + DOWNLOAD_PART_FILE));
+    QVERIFY(!QFile::exists(save + DOWNLOAD_JOURNAL_FILE));
+}
+
+void MusicDownloadDataRequestTest::checksumIsChecked_data()
+{
+    QTest::addColumn<bool>("matched");
+
+    QTest::newRow("matched md5") << true;
+    QTest::newRow("mismatched md5") << false;
+}
+
+void MusicDownloadDataRequestTest::checksumIsChecked()
+{
+    QFETCH(bool, matched);
+
+    const QString &save = m_dir + "/checksum.mp3";
+    QFile::remove(save);
+
+    const QByteArray &checksum = md5Base64(matched ? m_data : m_data.left(TEST_CUT_SIZE));
+    MusicDownloadServer server(m_data, checksum, TEST_CUT_SIZE, 0);
+    QCOMPARE(download(server.url(), save), QString(matched ? "DownloadOther" : "The file create failed"));
+
+    ///the mismatched data is dropped with its journal, nothing is left to resume
+    QCOMPARE(QFile::exists(save), matched);
+    QVERIFY(!QFile::exists(save + DOWNLOAD_PART_FILE));
+    QVERIFY(!QFile::exists(save + DOWNLOAD_JOURNAL_FILE));
+    if(matched)
+    {
+        QVERIFY(readFile(save) == m_data);
+    }
+}
+
+QTEST_GUILESS_MAIN(MusicDownloadDataRequestTest)
@@ -0,0 +1,64 @@
+#ifndef MUSICDOWNLOADDATAREQUESTTEST_H
+#define MUSICDOWNLOADDATAREQUESTTEST_H
+
+/* =================================================
+ * This file is part of the TTK Music Player project
+ * Copyright (C) 2015 - 2020 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ================================================= */
+
+#include <QtTest>
+
+/*! @brief The class of the download data request test.
+ * @author Greedysky <greedysky@163.com>
+ */
+class MusicDownloadDataRequestTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    /*!
+     * Create the test dir and the test data.
+     */
+    void initTestCase();
+    /*!
+     * Remove the test dir.
+     */
+    void cleanupTestCase();
+    /*!
+     * A body cut partway resumes by range and if range.
+     */
+    void resumeAfterCutBody();
+    /*!
+     * A dropped segment retries five times before it fails.
+     */
+    void segmentRetry_data();
+    void segmentRetry();
+    /*!
+     * Partial file and journal left by a failed download resume the next one.
+     */
+    void journalResumesNextDownload();
+    /*!
+     * Completed data must match the content md5.
+     */
+    void checksumIsChecked_data();
+    void checksumIsChecked();
+
+private:
+    QString m_dir;
+    QByteArray m_data;
+
+};
+
+#endif // MUSICDOWNLOADDATAREQUESTTEST_H
@@ -0,0 +1,117 @@
+#include "musicequalizertest.h"
+
+extern "C" {
+#include "equ/iir.h"
+}
+
+#define SAMPLE_RATE     44100
+#define CHANNELS        2
+
+///one second of a stereo sweep, the same every run
+static QVector<float> testSamples()
+{
+    QVector<float> samples(SAMPLE_RATE * CHANNELS);
+    for(int i=0; i<SAMPLE_RATE; ++i)
+    {
+        const double phase = 2 * M_PI * (50.0 + 10000.0 * i / SAMPLE_RATE) * i / SAMPLE_RATE;
+        samples[i * CHANNELS] = 0.5 * sin(phase);
+        samples[i * CHANNELS + 1] = 0.5 * cos(phase);
+    }
+    return samples;
+}
+
+static eq_state_t *createState(int bands, bool twoPasses, unsigned int rate = SAMPLE_RATE)
+{
+    eq_state_t *eq = eq_state_new(rate, bands);
+    eq_state_set_option(eq, EQ_TWO_PASSES, twoPasses);
+    for(int chn=0; chn<CHANNELS; ++chn)
+    {
+        eq_state_set_preamp(eq, chn, 1.0);
+        for(int i=0; i<bands; ++i)
+        {
+            eq_state_set_gain(eq, i, chn, i % 3 ? 0.1 * (i % 5) : 0.0);
+        }
+    }
+    return eq;
+}
+
+void MusicEqualizerTest::instancesAreIndependent()
+{
+    const QVector<float> &samples = testSamples();
+    const int frames = samples.count() / CHANNELS;
+
+    QVector<float> single = samples;
+    eq_state_t *eq = createState(31, true);
+    eq_state_iir(eq, single.data(), single.count(), CHANNELS);
+    eq_state_free(eq);
+
+    ///the other instance has other bands, gains and history, interleave both by blocks
+    QVector<float> first = samples, second = samples;
+    eq_state_t *left = createState(31, true);
+    eq_state_t *right = createState(10, false);
+    for(int i=0; i<frames; i+=512)
+    {
+        const int count = qMin(512, frames - i) * CHANNELS;
+        eq_state_iir(left, first.data() + i * CHANNELS, count, CHANNELS);
+        eq_state_iir(right, second.data() + i * CHANNELS, count, CHANNELS);
+    }
+    eq_state_free(left);
+    eq_state_free(right);
+
+    QCOMPARE(first, single);
+}
+
+void MusicEqualizerTest::unknownBandCountFallsBack_data()
+{
+    QTest::addColumn<unsigned int>("rate");
+
+    QTest::newRow("22050") << 22050u;
+    QTest::newRow("44100") << 44100u;
+    QTest::newRow("48000") << 48000u;
+    QTest::newRow("96000") << 96000u;
+}
+
+void MusicEqualizerTest::unknownBandCountFallsBack()
+{
+    QFETCH(unsigned int, rate);
+
+    ///12 bands has no table, the extra gains must not reach uncomputed coefficients
+    QVector<float> fallback = testSamples(), expected = testSamples();
+    eq_state_t *eq = createState(12, false, rate);
+    eq_state_iir(eq, fallback.data(), fallback.count(), CHANNELS);
+    eq_state_free(eq);
+
+    eq = createState(10, false, rate);
+    eq_state_iir(eq, expected.data(), expected.count(), CHANNELS);
+    eq_state_free(eq);
+
+    QCOMPARE(fallback, expected);
+}
+
+void MusicEqualizerTest::filterBenchmark_data()
+{
+    QTest::addColumn<int>("bands");
+    QTest::addColumn<bool>("twoPasses");
+
+    QTest::newRow("10 bands") << 10 << false;
+    QTest::newRow("10 bands two passes") << 10 << true;
+    QTest::newRow("31 bands") << 31 << false;
+    QTest::newRow("31 bands two passes") << 31 << true;
+}
+
+void MusicEqualizerTest::filterBenchmark()
+{
+    QFETCH(int, bands);
+    QFETCH(bool, twoPasses);
+
+    const QVector<float> &samples = testSamples();
+    eq_state_t *eq = createState(bands, twoPasses);
+    QBENCHMARK
+    {
+        QVector<float> data = samples;
+        eq_state_iir(eq, data.data(), data.count(), CHANNELS);
+    }
+    eq_state_free(eq);
+}
+
+QTEST_GUILESS_MAIN(MusicEqualizerTest)
@@ -0,0 +1,48 @@
+#ifndef MUSICEQUALIZERTEST_H
+#define MUSICEQUALIZERTEST_H
+
+/* =================================================
+ * This file is part of the TTK Music Player project
+ * Copyright (C) 2015 - 2020 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ================================================= */
+
+#include <QtTest>
+
+/*! @brief The class of the iir equalizer test.
+ * @author Greedysky <greedysky@163.com>
+ */
+class MusicEqualizerTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    /*!
+     * Two instances filter their streams without touching each other.
+     */
+    void instancesAreIndependent();
+    /*!
+     * A band count without a table filters with the fallback table only.
+     */
+    void unknownBandCountFallsBack_data();
+    void unknownBandCountFallsBack();
+    /*!
+     * Filter cost per second of stereo samples.
+     */
+    void filterBenchmark_data();
+    void filterBenchmark();
+
+};
+
+#endif // MUSICEQUALIZERTEST_H
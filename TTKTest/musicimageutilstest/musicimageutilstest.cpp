@@ -0,0 +1,327 @@
+#include "musicimageutilstest.h"
+#include "musicimageutils.h"
+#include "qalg/qimagewrap.h"
+
+#include <QElapsedTimer>
+
+#define IMAGE_SIZE      1024
+#define GAUSS_RADIUS    10
+
+///a smooth gradient with soft stripes, the same every run
+static QImage testImage(int width, int height)
+{
+    QImage image(width, height, QImage::Format_RGB32);
+    for(int y=0; y<height; ++y)
+    {
+        QRgb *line = TTKReinterpret_cast(QRgb*, image.scanLine(y));
+        for(int x=0; x<width; ++x)
+        {
+            line[x] = qRgb(x * 255 / width, y * 255 / height, (x / 16 + y / 16) % 2 ? 192 : 64);
+        }
+    }
+    return image;
+}
+
+static QImage testImage(int size)
+{
+    return testImage(size, size);
+}
+
+///the serial gauss kernel before the split, kept as it was to check the exact mode
+static void gaussBlurSerial(int* pix, int width, int height, int radius)
+{
+    const float sigma =  1.0 * radius / 2.57;
+    const float deno  =  1.0 / (sigma * sqrt(2.0 * M_PI));
+    const float nume  = -1.0 / (2.0 * sigma * sigma);
+
+    float* gaussMatrix = (float*)malloc(sizeof(float)* (radius + radius + 1));
+    float gaussSum = 0.0;
+    for(int i = 0, x = -radius; x <= radius; ++x, ++i)
+    {
+        float g = deno * exp(1.0 * nume * x * x);
+
+        gaussMatrix[i] = g;
+        gaussSum += g;
+    }
+
+    const int len = radius + radius + 1;
+    for(int i = 0; i < len; ++i)
+    {
+        gaussMatrix[i] /= gaussSum;
+    }
+
+    ///the old loop read one past the end (k <= width), a zero there keeps the read defined
+    int* rowData  = (int*)calloc(width + 1, sizeof(int));
+    int* listData = (int*)calloc(height + 1, sizeof(int));
+
+    for(int y = 0; y < height; ++y)
+    {
+        memcpy(rowData, pix + y * width, sizeof(int) *width);
+
+        for(int x = 0; x < width; ++x)
+        {
+            float r = 0, g = 0, b = 0;
+            gaussSum = 0;
+
+            for(int i = -radius; i <= radius; ++i)
+            {
+                int k = x + i;
+
+                if(0 <= k && k <= width)
+                {
+                    int color = rowData[k];
+                    int cr = (color & 0x00ff0000) >> 16;
+                    int cg = (color & 0x0000ff00) >> 8;
+                    int cb = (color & 0x000000ff);
+
+                    r += cr * gaussMatrix[i + radius];
+                    g += cg * gaussMatrix[i + radius];
+                    b += cb * gaussMatrix[i + radius];
+
+                    gaussSum += gaussMatrix[i + radius];
+                }
+            }
+
+            int cr = (int)(r / gaussSum);
+            int cg = (int)(g / gaussSum);
+            int cb = (int)(b / gaussSum);
+
+            pix[y * width + x] = cr << 16 | cg << 8 | cb | 0xff000000;
+        }
+    }
+
+    for(int x = 0; x < width; ++x)
+    {
+        for(int y = 0; y < height; ++y)
+        {
+            listData[y] = pix[y * width + x];
+        }
+
+        for(int y = 0; y < height; ++y)
+        {
+            float r = 0, g = 0, b = 0;
+            gaussSum = 0;
+
+            for(int j = -radius; j <= radius; ++j)
+            {
+                int k = y + j;
+
+                if(0 <= k && k <= height)
+                {
+                    int color = listData[k];
+                    int cr = (color & 0x00ff0000) >> 16;
+                    int cg = (color & 0x0000ff00) >> 8;
+                    int cb = (color & 0x000000ff);
+
+                    r += cr * gaussMatrix[j + radius];
+                    g += cg * gaussMatrix[j + radius];
+                    b += cb * gaussMatrix[j + radius];
+
+                    gaussSum += gaussMatrix[j + radius];
+                }
+            }
+
+            int cr = (int)(r / gaussSum);
+            int cg = (int)(g / gaussSum);
+            int cb = (int)(b / gaussSum);
+
+            pix[y * width + x] = cr << 16 | cg << 8 | cb | 0xff000000;
+        }
+    }
+
+    free(gaussMatrix);
+    free(rowData);
+    free(listData);
+}
+
+///rows of the image sizes the kernels are measured at
+static void addImageSizes()
+{
+    QTest::addColumn<int>("width");
+    QTest::addColumn<int>("height");
+
+    QTest::newRow("1024") << IMAGE_SIZE << IMAGE_SIZE;
+    QTest::newRow("1080p") << 1920 << 1080;
+    QTest::newRow("4K") << 3840 << 2160;
+}
+
+///QBENCHMARK reports the time per call, print the throughput of all timed runs next to it
+template <typename Kernel>
+static void benchmarkMegapixels(qint64 pixels, const Kernel &kernel)
+{
+    qint64 runs = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK
+    {
+        kernel();
+        ++runs;
+    }
+
+    const qint64 elapsed = qMax<qint64>(1, timer.nsecsElapsed());
+    qDebug("%.1f MP/s", 1000.0 * pixels * runs / elapsed);
+}
+
+static void gaussBlur(QImage &image, QImageWrap::QGaussBlur::Mode mode, int radius)
+{
+    QImageWrap::QGaussBlur wrap;
+    wrap.setMode(mode);
+    wrap.render(TTKReinterpret_cast(int*, image.bits()), image.width(), image.height(), radius);
+}
+
+void MusicImageUtilsTest::exactBlurMatchesSerial_data()
+{
+    QTest::addColumn<int>("width");
+    QTest::addColumn<int>("height");
+    QTest::addColumn<int>("radius");
+
+    ///odd sizes leave a partial column block, the large one runs on several threads
+    QTest::newRow("small radius 1") << 250 << 170 << 1;
+    QTest::newRow("small radius 10") << 250 << 170 << GAUSS_RADIUS;
+    QTest::newRow("large radius 1") << 650 << 370 << 1;
+    QTest::newRow("large radius 10") << 650 << 370 << GAUSS_RADIUS;
+}
+
+void MusicImageUtilsTest::exactBlurMatchesSerial()
+{
+    QFETCH(int, width);
+    QFETCH(int, height);
+    QFETCH(int, radius);
+
+    QImage exact = testImage(width, height);
+    QImage serial = exact.copy();
+    gaussBlur(exact, QImageWrap::QGaussBlur::Exact, radius);
+    gaussBlurSerial(TTKReinterpret_cast(int*, serial.bits()), width, height, radius);
+
+    ///the old loop took the zero past the end into the last radius rows and columns, only they may differ
+    for(int y=0; y<height - radius; ++y)
+    {
+        const QRgb *e = TTKReinterpret_cast(const QRgb*, exact.constScanLine(y));
+        const QRgb *s = TTKReinterpret_cast(const QRgb*, serial.constScanLine(y));
+        for(int x=0; x<width - radius; ++x)
+        {
+            if(e[x] != s[x])
+            {
+                QFAIL(qPrintable(QString("pixel %1, %2 differs").arg(x).arg(y)));
+            }
+        }
+    }
+}
+
+void MusicImageUtilsTest::boxBlurMatchesExact()
+{
+    QImage exact = testImage(256);
+    QImage box = exact.copy();
+    gaussBlur(exact, QImageWrap::QGaussBlur::Exact, GAUSS_RADIUS);
+    gaussBlur(box, QImageWrap::QGaussBlur::Box, GAUSS_RADIUS);
+
+    qint64 total = 0;
+    for(int y=0; y<exact.height(); ++y)
+    {
+        const QRgb *e = TTKReinterpret_cast(const QRgb*, exact.constScanLine(y));
+        const QRgb *b = TTKReinterpret_cast(const QRgb*, box.constScanLine(y));
+        for(int x=0; x<exact.width(); ++x)
+        {
+            total += qAbs(qRed(e[x]) - qRed(b[x])) + qAbs(qGreen(e[x]) - qGreen(b[x])) + qAbs(qBlue(e[x]) - qBlue(b[x]));
+        }
+    }
+
+    ///three box passes only approximate the kernel, the mean error must stay small
+    const double mean = 1.0 * total / (exact.width() * exact.height() * 3);
+    QVERIFY2(mean < 4, qPrintable(QString::number(mean)));
+}
+
+void MusicImageUtilsTest::gaussBlurBenchmark_data()
+{
+    QTest::addColumn<int>("width");
+    QTest::addColumn<int>("height");
+    QTest::addColumn<int>("mode");
+    QTest::addColumn<int>("radius");
+
+    const int exact = QImageWrap::QGaussBlur::Exact;
+    const int box = QImageWrap::QGaussBlur::Box;
+    QTest::newRow("1024 exact 10") << IMAGE_SIZE << IMAGE_SIZE << exact << GAUSS_RADIUS;
+    QTest::newRow("1024 box 10") << IMAGE_SIZE << IMAGE_SIZE << box << GAUSS_RADIUS;
+    QTest::newRow("1024 exact 40") << IMAGE_SIZE << IMAGE_SIZE << exact << 4 * GAUSS_RADIUS;
+    QTest::newRow("1024 box 40") << IMAGE_SIZE << IMAGE_SIZE << box << 4 * GAUSS_RADIUS;
+    QTest::newRow("1080p exact 10") << 1920 << 1080 << exact << GAUSS_RADIUS;
+    QTest::newRow("1080p box 10") << 1920 << 1080 << box << GAUSS_RADIUS;
+    QTest::newRow("1080p exact 40") << 1920 << 1080 << exact << 4 * GAUSS_RADIUS;
+    QTest::newRow("1080p box 40") << 1920 << 1080 << box << 4 * GAUSS_RADIUS;
+    QTest::newRow("4K exact 10") << 3840 << 2160 << exact << GAUSS_RADIUS;
+    QTest::newRow("4K box 10") << 3840 << 2160 << box << GAUSS_RADIUS;
+    QTest::newRow("4K exact 40") << 3840 << 2160 << exact << 4 * GAUSS_RADIUS;
+    QTest::newRow("4K box 40") << 3840 << 2160 << box << 4 * GAUSS_RADIUS;
+}
+
+void MusicImageUtilsTest::gaussBlurBenchmark()
+{
+    QFETCH(int, width);
+    QFETCH(int, height);
+    QFETCH(int, mode);
+    QFETCH(int, radius);
+
+    const QImage &input = testImage(width, height);
+    QBENCHMARK
+    {
+        QImage image = input.copy();
+        gaussBlur(image, TTKStatic_cast(QImageWrap::QGaussBlur::Mode, mode), radius);
+    }
+}
+
+void MusicImageUtilsTest::reRenderImageBenchmark_data()
+{
+    addImageSizes();
+}
+
+void MusicImageUtilsTest::reRenderImageBenchmark()
+{
+    QFETCH(int, width);
+    QFETCH(int, height);
+
+    const QImage &input = testImage(width, height);
+    QImage output;
+    benchmarkMegapixels(qint64(width) * height, [&]()
+    {
+        MusicUtils::Image::reRenderImage(30, &input, &output);
+    });
+}
+
+void MusicImageUtilsTest::grayScalePixmapBenchmark_data()
+{
+    addImageSizes();
+}
+
+void MusicImageUtilsTest::grayScalePixmapBenchmark()
+{
+    QFETCH(int, width);
+    QFETCH(int, height);
+
+    const QPixmap &input = QPixmap::fromImage(testImage(width, height));
+    benchmarkMegapixels(qint64(width) * height, [&]()
+    {
+        MusicUtils::Image::grayScalePixmap(input, 20);
+    });
+}
+
+void MusicImageUtilsTest::grayScaleAverageBenchmark_data()
+{
+    addImageSizes();
+}
+
+void MusicImageUtilsTest::grayScaleAverageBenchmark()
+{
+    QFETCH(int, width);
+    QFETCH(int, height);
+
+    const QImage &input = testImage(width, height);
+    int average = 0;
+    benchmarkMegapixels(qint64(width) * height, [&]()
+    {
+        average += MusicUtils::Image::grayScaleAverage(input, width, height);
+    });
+    QVERIFY(average > 0);
+}
+
+///the gray scale works on a pixmap, which needs the gui application
+QTEST_MAIN(MusicImageUtilsTest)
@@ -0,0 +1,63 @@
+#ifndef MUSICIMAGEUTILSTEST_H
+#define MUSICIMAGEUTILSTEST_H
+
+/* =================================================
+ * This file is part of the TTK Music Player project
+ * Copyright (C) 2015 - 2020 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ================================================= */
+
+#include <QtTest>
+
+/*! @brief The class of the image utils test.
+ * @author Greedysky <greedysky@163.com>
+ */
+class MusicImageUtilsTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    /*!
+     * Exact gauss blur matches the old serial kernel bit by bit.
+     */
+    void exactBlurMatchesSerial_data();
+    void exactBlurMatchesSerial();
+    /*!
+     * Cache blocked box blur stays close to the exact gauss kernel.
+     */
+    void boxBlurMatchesExact();
+    /*!
+     * Gauss blur cost of the exact kernel and the box approximation at 1080p and 4K.
+     */
+    void gaussBlurBenchmark_data();
+    void gaussBlurBenchmark();
+    /*!
+     * Color burn throughput of the row split render.
+     */
+    void reRenderImageBenchmark_data();
+    void reRenderImageBenchmark();
+    /*!
+     * Gray scale throughput of the row split render.
+     */
+    void grayScalePixmapBenchmark_data();
+    void grayScalePixmapBenchmark();
+    /*!
+     * Gray average throughput of the scanline walk.
+     */
+    void grayScaleAverageBenchmark_data();
+    void grayScaleAverageBenchmark();
+
+};
+
+#endif // MUSICIMAGEUTILSTEST_H
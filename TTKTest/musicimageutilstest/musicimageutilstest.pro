@@ -0,0 +1,33 @@
+# =================================================
+# * This file is part of the TTK Music Player project
+# * Copyright (C) 2015 - 2020 Greedysky Studio
+#
+# * This program is free software; you can redistribute it and/or modify
+# * it under the terms of the GNU General Public License as published by
+# * the Free Software Foundation; either version 3 of the License, or
+# * (at your option) any later version.
+#
+# * This program is distributed in the hope that it will be useful,
+# * but WITHOUT ANY WARRANTY; without even the implied warranty of
+# * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# * GNU General Public License for more details.
+#
+# * You should have received a copy of the GNU General Public License along
+# * with this program; If not, see <http://www.gnu.org/licenses/>.
+# =================================================
+
+include($$PWD/../TTKTest.pri)
+
+QT += gui
+
+TARGET = musicimageutilstest
+
+LIBS += -lTTKExtras
+
+INCLUDEPATH += \
+    $$PWD/../../TTKThirdParty \
+    $$PWD/../../TTKThirdParty/TTKExtras
+
+HEADERS += musicimageutilstest.h
+
+SOURCES += musicimageutilstest.cpp
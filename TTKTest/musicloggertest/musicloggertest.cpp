@@ -0,0 +1,127 @@
+#include "musicloggertest.h"
+#include "ttklogger.h"
+
+#include <QDir>
+#include <QElapsedTimer>
+
+#define LOGGER_THREAD_COUNT     4
+#define LOGGER_ORDER_COUNT      1000
+#define LOGGER_CALL_COUNT       10000
+
+///log numbered records of one caller
+static void logMessages(const char *tag, int id, int count)
+{
+    for(int i=0; i<count; ++i)
+    {
+        TTK_MESSAGE(tag << id << i, Info);
+    }
+}
+
+/*! @brief The class of the logger caller thread.
+ * @author Greedysky <greedysky@163.com>
+ */
+class MusicLoggerThread : public QThread
+{
+public:
+    MusicLoggerThread(const char *tag, int id, int count)
+        : m_tag(tag), m_id(id), m_count(count)
+    {
+
+    }
+
+protected:
+    virtual void run() override
+    {
+        logMessages(m_tag, m_id, m_count);
+    }
+
+private:
+    const char *m_tag;
+    int m_id, m_count;
+
+};
+
+///log from the caller and the other threads at once, return when all are done
+static void logFromThreads(const char *tag, int threads, int count)
+{
+    QList<MusicLoggerThread*> callers;
+    for(int i=1; i<threads; ++i)
+    {
+        callers << new MusicLoggerThread(tag, i, count);
+        callers.last()->start();
+    }
+
+    logMessages(tag, 0, count);
+    foreach(MusicLoggerThread *caller, callers)
+    {
+        caller->wait();
+    }
+    qDeleteAll(callers);
+}
+
+void MusicLoggerTest::initTestCase()
+{
+    ///the log file is opened in the working dir with the first record
+    m_dir = QDir::tempPath() + "/ttkloggertest";
+    QDir(m_dir).removeRecursively();
+    QVERIFY(QDir().mkpath(m_dir));
+    QVERIFY(QDir::setCurrent(m_dir));
+}
+
+void MusicLoggerTest::cleanupTestCase()
+{
+    QDir::setCurrent(QDir::tempPath());
+    QDir(m_dir).removeRecursively();
+}
+
+void MusicLoggerTest::recordsKeepThreadOrder()
+{
+    logFromThreads("order", LOGGER_THREAD_COUNT, LOGGER_ORDER_COUNT);
+    TTK_LOGGER.flush();
+
+    QFile file(m_dir + "/logger.txt");
+    QVERIFY(file.open(QIODevice::ReadOnly));
+
+    QVector<int> next(LOGGER_THREAD_COUNT, 0);
+    const QRegExp regx("order (\\d+) (\\d+)$");
+    QTextStream stream(&file);
+    while(!stream.atEnd())
+    {
+        const QString &line = stream.readLine();
+        if(regx.indexIn(line) == -1)
+        {
+            continue;
+        }
+
+        const int id = regx.cap(1).toInt();
+        QCOMPARE(regx.cap(2).toInt(), next[id]++);
+    }
+    QCOMPARE(next, QVector<int>(LOGGER_THREAD_COUNT, LOGGER_ORDER_COUNT));
+}
+
+void MusicLoggerTest::messageBenchmark_data()
+{
+    QTest::addColumn<int>("threads");
+
+    QTest::newRow("1 thread") << 1;
+    QTest::newRow("4 threads") << LOGGER_THREAD_COUNT;
+}
+
+void MusicLoggerTest::messageBenchmark()
+{
+    QFETCH(int, threads);
+
+    qint64 runs = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK
+    {
+        logFromThreads("benchmark", threads, LOGGER_CALL_COUNT);
+        ++runs;
+    }
+
+    ///QBENCHMARK reports the time of all calls of one run, print the cost of one call next to it
+    qDebug("%.0f ns per call", 1.0 * timer.nsecsElapsed() / (runs * LOGGER_CALL_COUNT));
+}
+
+QTEST_GUILESS_MAIN(MusicLoggerTest)
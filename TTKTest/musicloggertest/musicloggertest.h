@@ -0,0 +1,55 @@
+#ifndef MUSICLOGGERTEST_H
+#define MUSICLOGGERTEST_H
+
+/* =================================================
+ * This file is part of the TTK Music Player project
+ * Copyright (C) 2015 - 2020 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ================================================= */
+
+#include <QtTest>
+
+/*! @brief The class of the async logger test.
+ * @author Greedysky <greedysky@163.com>
+ */
+class MusicLoggerTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    /*!
+     * Move the log file into a temp dir.
+     */
+    void initTestCase();
+    /*!
+     * Remove the temp log dir.
+     */
+    void cleanupTestCase();
+
+    /*!
+     * Records of every thread reach the log file in their calling order.
+     */
+    void recordsKeepThreadOrder();
+    /*!
+     * Cost of one log call from one thread and from several threads at once.
+     */
+    void messageBenchmark_data();
+    void messageBenchmark();
+
+private:
+    QString m_dir;
+
+};
+
+#endif // MUSICLOGGERTEST_H
@@ -0,0 +1,252 @@
+#include "musiclrcanalysistest.h"
+#include "musiclrcanalysis.h"
+
+#include <QRegExp>
+
+Q_DECLARE_METATYPE(TTKIntStringMap)
+
+/*! @brief The class of the lrc analysis which exposes the parsed timeline.
+ * @author Greedysky <greedysky@163.com>
+ */
+class MusicLrcAnalysisProbe : public MusicLrcAnalysis
+{
+public:
+    TTKIntStringMap parse(const QByteArray &data)
+    {
+        TTKIntStringMap map;
+        setLrcData(data);
+        for(int i=0; i<m_lrcContainer.count(); ++i)
+        {
+            map.insert(m_lrcContainer.time(i), m_lrcContainer.text(i));
+        }
+        return map;
+    }
+};
+
+///the fraction was scaled by the digits of its value, so leading zeros were lost
+static qint64 legacyTime(int minutes, int seconds, int milliseconds)
+{
+    int scale = 1;
+    for(int i=QString::number(milliseconds).length(); i<3; ++i)
+    {
+        scale *= 10;
+    }
+    return minutes * MT_M2MS + seconds * MT_S2MS + milliseconds * scale;
+}
+
+///the regex cascade parser before the single pass one, kept as the reference
+static void legacyMatchLrcLine(const QString &oneLine, TTKIntStringMap &map)
+{
+    static const char *tags[] = {
+        "\\[\\d{2}:\\d{2}\\.\\d{3}\\]", "\\[\\d{2}:\\d{2}\\.\\d{2}\\]", "\\[\\d{2}:\\d{2}\\.\\d{1}\\]",
+        "\\[\\d{2}:\\d{2}:\\d{3}\\]", "\\[\\d{2}:\\d{2}:\\d{2}\\]", "\\[\\d{2}:\\d{2}:\\d{1}\\]",
+        "\\[\\d{2}:\\d{2}\\]",
+        "\\[\\d{2}\\.\\d{2}\\.\\d{3}\\]", "\\[\\d{2}\\.\\d{2}\\.\\d{2}\\]", "\\[\\d{2}\\.\\d{2}\\.\\d{1}\\]",
+        "\\[\\d{2}\\.\\d{2}:\\d{3}\\]", "\\[\\d{2}\\.\\d{2}:\\d{2}\\]", "\\[\\d{2}\\.\\d{2}:\\d{1}\\]",
+        "\\[\\d{2}\\.\\d{2}\\]"
+    };
+    ///field patterns of each format, the split formats have none
+    static const char *fields[][3] = {
+        {"\\d{2}(?=:)", "\\d{2}(?=\\.)", "\\d{3}(?=\\])"}, {"\\d{2}(?=:)", "\\d{2}(?=\\.)", "\\d{2}(?=\\])"}, {"\\d{2}(?=:)", "\\d{2}(?=\\.)", "\\d{1}(?=\\])"},
+        {nullptr, nullptr, nullptr}, {nullptr, nullptr, nullptr}, {nullptr, nullptr, nullptr},
+        {"\\d{2}(?=:)", "\\d{2}(?=\\])", nullptr},
+        {nullptr, nullptr, nullptr}, {nullptr, nullptr, nullptr}, {nullptr, nullptr, nullptr},
+        {"\\d{2}(?=\\.)", "\\d{2}(?=:)", "\\d{3}(?=\\])"}, {"\\d{2}(?=\\.)", "\\d{2}(?=:)", "\\d{2}(?=\\])"}, {"\\d{2}(?=\\.)", "\\d{2}(?=:)", "\\d{1}(?=\\])"},
+        {"\\d{2}(?=\\.)", "\\d{2}(?=\\])", nullptr}
+    };
+    static const char *splits[] = {nullptr, nullptr, nullptr, ":", ":", ":", nullptr, ".", ".", ".", nullptr, nullptr, nullptr, nullptr};
+
+    int type = 13;
+    for(int i=0; i<13; ++i)
+    {
+        if(oneLine.contains(QRegExp(tags[i])))
+        {
+            type = i;
+            break;
+        }
+    }
+
+    const QRegExp regx(tags[type]);
+    QString temp = oneLine;
+    temp.replace(regx, QString());
+
+    int pos = regx.indexIn(oneLine, 0);
+    while(pos != -1)
+    {
+        QString cap = regx.cap(0);
+        if(splits[type])
+        {
+            cap.chop(1);
+            cap.remove(0, 1);
+            const QStringList lists(cap.split(splits[type]));
+            if(lists.count() == 3)
+            {
+                map.insert(legacyTime(lists[0].toInt(), lists[1].toInt(), lists[2].toInt()), temp);
+            }
+        }
+        else
+        {
+            int values[3] = {0, 0, -1};
+            for(int i=0; i<3 && fields[type][i]; ++i)
+            {
+                QRegExp field(fields[type][i]);
+                field.indexIn(cap);
+                values[i] = field.cap(0).toInt();
+            }
+
+            const qint64 time = values[2] < 0 ? values[0] * MT_M2MS + values[1] * MT_S2MS : legacyTime(values[0], values[1], values[2]);
+            map.insert(time, temp);
+        }
+
+        pos += regx.matchedLength();
+        pos = regx.indexIn(oneLine, pos);
+    }
+}
+
+static TTKIntStringMap legacyMatchLrcData(const QByteArray &data)
+{
+    TTKIntStringMap map;
+    foreach(const QString &oneLine, QString(data).split("\n"))
+    {
+        legacyMatchLrcLine(oneLine, map);
+    }
+
+    if(!map.isEmpty() && !map.contains(0))
+    {
+        map.insert(0, QString());
+    }
+    return map;
+}
+
+static QByteArray benchmarkLrcData()
+{
+    QByteArray data("[ti:benchmark]\n[ar:benchmark]\n");
+    for(int i=0; i<2000; ++i)
+    {
+        const int time = i * 1370;
+        data.append(QString("[%1:%2.%3]line %4 of the benchmark lyric\n")
+                    .arg(time / MT_M2MS % 100, 2, 10, QChar('0'))
+                    .arg(time / MT_S2MS % 60, 2, 10, QChar('0'))
+                    .arg(time % MT_S2MS / 10, 2, 10, QChar('0'))
+                    .arg(i).toUtf8());
+    }
+    return data;
+}
+
+void MusicLrcAnalysisTest::matchLrcData_data()
+{
+    ///changed lists the lines of the new parser that differ from the old one, removed the old times it drops
+    QTest::addColumn<QByteArray>("lrc");
+    QTest::addColumn<TTKIntStringMap>("changed");
+    QTest::addColumn<TTKIntList>("removed");
+
+    QTest::newRow("headers and centiseconds")
+            << QByteArray("[ti:Song]\n[ar:Artist]\n[al:Album]\n[00:00.00]Intro\n[00:12.34]Line one\n[00:15.60]Line two\n[01:02.99]Line three\n")
+            << TTKIntStringMap() << TTKIntList();
+    QTest::newRow("milliseconds")
+            << QByteArray("[00:01.123]a\n[00:02.500]b\n[01:30.999]c\n")
+            << TTKIntStringMap() << TTKIntList();
+    QTest::newRow("tenths")
+            << QByteArray("[00:01.5]a\n[00:02.9]b\n[00:03.0]c\n")
+            << TTKIntStringMap() << TTKIntList();
+    QTest::newRow("no fraction")
+            << QByteArray("[00:05]a\n[03:10]b\n")
+            << TTKIntStringMap() << TTKIntList();
+    QTest::newRow("colon fraction")
+            << QByteArray("[00:01:25]a\n[00:02:500]b\n[00:03:7]c\n")
+            << TTKIntStringMap() << TTKIntList();
+    QTest::newRow("dot minutes")
+            << QByteArray("[00.01.25]a\n[00.02.500]b\n[00.03.7]c\n[00.04]d\n")
+            << TTKIntStringMap() << TTKIntList();
+    QTest::newRow("dot minutes colon fraction")
+            << QByteArray("[00.01:25]a\n[00.02:500]b\n[00.03:7]c\n")
+            << TTKIntStringMap() << TTKIntList();
+    QTest::newRow("repeated tags")
+            << QByteArray("[00:10.20][00:40.20][01:10.20]Chorus\n[00:20.30]Verse\n")
+            << TTKIntStringMap() << TTKIntList();
+    QTest::newRow("duplicate time")
+            << QByteArray("[00:10.20]first\n[00:10.20]second\n")
+            << TTKIntStringMap() << TTKIntList();
+    QTest::newRow("empty text")
+            << QByteArray("[00:10.20]\n[00:20.30]end\n")
+            << TTKIntStringMap() << TTKIntList();
+    QTest::newRow("untagged lines")
+            << QByteArray("plain text\n[00:10.20]a [b] c\n\nnoise [x]\n")
+            << TTKIntStringMap() << TTKIntList();
+
+    TTKIntStringMap changed;
+    changed.insert(1050, "a");
+    changed.insert(2005, "b");
+    changed.insert(3010, "c");
+    QTest::newRow("leading zero fraction")
+            << QByteArray("[00:01.05]a\n[00:02.005]b\n[00:03:01]c\n")
+            << changed << (TTKIntList() << 1500 << 2500 << 3100);
+
+    changed.clear();
+    changed.insert(1500, "a");
+    changed.insert(3000, "a");
+    QTest::newRow("mixed formats")
+            << QByteArray("[00:01.50][00:03]a\n")
+            << changed << TTKIntList();
+
+    changed.clear();
+    changed.insert(500, "a");
+    changed.insert(2500, "b");
+    QTest::newRow("offset")
+            << QByteArray("[offset:+500]\n[00:01.00]a\n[00:03.00]b\n")
+            << changed << (TTKIntList() << 1000 << 3000);
+}
+
+void MusicLrcAnalysisTest::matchLrcData()
+{
+    QFETCH(QByteArray, lrc);
+    QFETCH(TTKIntStringMap, changed);
+    QFETCH(TTKIntList, removed);
+
+    TTKIntStringMap expected = legacyMatchLrcData(lrc);
+    foreach(const int time, removed)
+    {
+        QVERIFY2(expected.remove(time) == 1, "removed time is not in the old result");
+    }
+
+    for(TTKIntStringMap::const_iterator it = changed.constBegin(); it != changed.constEnd(); ++it)
+    {
+        QVERIFY2(expected.value(it.key(), "\n") != it.value(), "changed line is the same in the old result");
+        expected.insert(it.key(), it.value());
+    }
+
+    MusicLrcAnalysisProbe analysis;
+    QCOMPARE(analysis.parse(lrc), expected);
+}
+
+void MusicLrcAnalysisTest::matchLrcDataBenchmark_data()
+{
+    QTest::addColumn<bool>("legacy");
+
+    QTest::newRow("regex cascade") << true;
+    QTest::newRow("single pass") << false;
+}
+
+void MusicLrcAnalysisTest::matchLrcDataBenchmark()
+{
+    QFETCH(bool, legacy);
+
+    const QByteArray &data = benchmarkLrcData();
+    MusicLrcAnalysisProbe analysis;
+    if(legacy)
+    {
+        QBENCHMARK
+        {
+            legacyMatchLrcData(data);
+        }
+    }
+    else
+    {
+        QBENCHMARK
+        {
+            analysis.parse(data);
+        }
+    }
+}
+
+QTEST_GUILESS_MAIN(MusicLrcAnalysisTest)
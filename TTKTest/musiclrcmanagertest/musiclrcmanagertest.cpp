@@ -0,0 +1,140 @@
+#include "musiclrcmanagertest.h"
+#include "musiclrcmanagerforinterior.h"
+#include "musicsettingmanager.h"
+#include "musicwidgetutils.h"
+
+#include <QImage>
+
+#define TEST_FRAME_COUNT    200
+
+/*! @brief The class of the interior lrc manager which can draw the old three pass text.
+ * @author Greedysky <greedysky@163.com>
+ */
+class MusicLrcManagerProbe : public MusicLrcManagerForInterior
+{
+public:
+    explicit MusicLrcManagerProbe(bool threePass)
+        : MusicLrcManagerForInterior(nullptr),
+          m_threePass(threePass)
+    {
+        resize(LRC_PER_WIDTH, m_geometry.y());
+        setLinearGradientColor(MusicLrcColor::mapIndexToColor(MusicLrcColor::IYellow));
+        setText("The quick brown fox jumps over the lazy dog");
+    }
+
+    void setMaskWidth(int width)
+    {
+        m_lrcMaskWidth = width;
+    }
+
+protected:
+    virtual void paintEvent(QPaintEvent *event) override
+    {
+        if(!m_threePass)
+        {
+            MusicLrcManagerForInterior::paintEvent(event);
+            return;
+        }
+
+        ///the interior draw before the lrc layers were cached, kept as the baseline
+        QPainter painter(this);
+        painter.setRenderHints(QPainter::Antialiasing | QPainter::SmoothPixmapTransform);
+
+        QFont font(m_font);
+        int ttplus = font.pointSize() - m_gradientFontSize;
+        font.setPointSize(ttplus = (ttplus < 0) ? 0 : ttplus);
+        painter.setFont(font);
+        m_geometry.setX(MusicUtils::Widget::fontTextWidth(font, text()));
+
+        const int fontHeight = MusicUtils::Widget::fontTextHeight(font);
+        m_linearGradient.setFinalStop(0, fontHeight);
+        m_maskLinearGradient.setFinalStop(0, fontHeight);
+
+        if(m_geometry.x() + m_intervalCount >= m_lrcPerWidth && m_lrcMaskWidth >= m_lrcPerWidth / 2)
+        {
+            m_intervalCount -= m_lrcMaskWidthInterval;
+        }
+
+        ttplus = 2.55*m_gradientTransparent;
+        painter.setPen(QColor(0, 0, 0, ttplus));
+
+        ttplus = (m_lrcPerWidth - m_geometry.x()) / 2.0;
+        painter.drawText((ttplus < 0 ? m_intervalCount : ttplus) + 1, 1,
+                         m_geometry.x(), m_geometry.y(), Qt::AlignLeft | Qt::AlignVCenter, text());
+
+        painter.setPen(QPen(m_linearGradient, 0));
+        painter.drawText(ttplus < 0 ? m_intervalCount : ttplus, 0,
+                         m_geometry.x(), m_geometry.y(), Qt::AlignLeft | Qt::AlignVCenter, text());
+
+        int offsetValue = m_lrcMaskWidth;
+        if(!M_SETTING_PTR->boolValue(MusicSettingManager::OtherLrcKTVMode))
+        {
+            offsetValue = (m_lrcMaskWidth != 0) ? m_geometry.x() : m_lrcMaskWidth;
+        }
+
+        painter.setPen(QPen(m_maskLinearGradient, 0));
+        painter.drawText(ttplus < 0 ? m_intervalCount : ttplus, 0,
+                         offsetValue, m_geometry.y(), Qt::AlignLeft | Qt::AlignVCenter, text());
+    }
+
+private:
+    bool m_threePass;
+
+};
+
+///every frame moves the mask on, as the mask timer does while a line is sung
+static void drawFrames(MusicLrcManagerProbe *manager, QImage *image, int count)
+{
+    for(int i=0; i<count; ++i)
+    {
+        image->fill(Qt::transparent);
+        manager->setMaskWidth(i * LRC_PER_WIDTH / count);
+        manager->render(image, QPoint(), QRegion(), QWidget::DrawChildren);
+    }
+}
+
+void MusicLrcManagerTest::frameTimeAccessors()
+{
+    MusicLrcManagerProbe manager(false);
+    QCOMPARE(manager.getLastFrameTime(), qint64(0));
+    QCOMPARE(manager.getAverageFrameTime(), qint64(0));
+
+    QImage image(manager.size(), QImage::Format_ARGB32_Premultiplied);
+    drawFrames(&manager, &image, TEST_FRAME_COUNT);
+    QVERIFY(manager.getLastFrameTime() > 0);
+    QVERIFY(manager.getAverageFrameTime() > 0);
+}
+
+void MusicLrcManagerTest::frameBenchmark_data()
+{
+    QTest::addColumn<bool>("threePass");
+
+    QTest::newRow("cached layers") << false;
+    QTest::newRow("three pass") << true;
+}
+
+void MusicLrcManagerTest::frameBenchmark()
+{
+    QFETCH(bool, threePass);
+
+    MusicLrcManagerProbe manager(threePass);
+    QImage image(manager.size(), QImage::Format_ARGB32_Premultiplied);
+
+    QElapsedTimer timer;
+    qint64 elapsed = 0, frames = 0;
+    QBENCHMARK
+    {
+        timer.start();
+        drawFrames(&manager, &image, TEST_FRAME_COUNT);
+        elapsed += timer.nsecsElapsed();
+        frames += TEST_FRAME_COUNT;
+    }
+
+    qDebug("%.1f us per frame", elapsed / 1000.0 / frames);
+    if(!threePass)
+    {
+        qDebug("layers %.1f us average, %.1f us last", manager.getAverageFrameTime() / 1000.0, manager.getLastFrameTime() / 1000.0);
+    }
+}
+
+QTEST_MAIN(MusicLrcManagerTest)
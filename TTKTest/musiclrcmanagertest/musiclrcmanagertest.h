@@ -0,0 +1,43 @@
+#ifndef MUSICLRCMANAGERTEST_H
+#define MUSICLRCMANAGERTEST_H
+
+/* =================================================
+ * This file is part of the TTK Music Player project
+ * Copyright (C) 2015 - 2020 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ================================================= */
+
+#include <QtTest>
+
+/*! @brief The class of the lrc manager test.
+ * @author Greedysky <greedysky@163.com>
+ */
+class MusicLrcManagerTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    /*!
+     * Frame time accessors start at zero and follow the drawn frames.
+     */
+    void frameTimeAccessors();
+    /*!
+     * Frame cost of the cached layers against the old three pass text draw.
+     */
+    void frameBenchmark_data();
+    void frameBenchmark();
+
+};
+
+#endif // MUSICLRCMANAGERTEST_H
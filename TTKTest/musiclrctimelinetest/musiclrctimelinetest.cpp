@@ -0,0 +1,97 @@
+#include "musiclrctimelinetest.h"
+#include "musiclrctimeline.h"
+#include "musiclrcanalysis.h"
+#include "musiclrcboundarytimer.h"
+
+#include <QEventLoop>
+#include <QElapsedTimer>
+
+#define TEST_LINE_COUNT     20
+#define TEST_LINE_INTERVAL  150
+#define TEST_DRIFT_MAX      20
+
+void MusicLrcTimelineTest::findIndexMatchesMap()
+{
+    TTKIntStringMap map;
+    MusicLrcTimeline timeline;
+    for(int i=0; i<500; ++i)
+    {
+        ///unsorted times, some lines repeat the time of the line before
+        const qint64 time = (i - i % 50 / 49) * 7919 % 300000;
+        map.insert(time, QString::number(i));
+        timeline.insert(time, QString::number(i));
+    }
+    timeline.finish();
+    QCOMPARE(timeline.count(), map.count());
+
+    for(qint64 time = -10; time < 310000; time += 7)
+    {
+        ///the old lookup took the last key not greater than time
+        TTKIntStringMap::const_iterator it = map.upperBound(time);
+        const int index = timeline.findIndex(time);
+        if(it == map.constBegin())
+        {
+            QCOMPARE(index, -1);
+        }
+        else
+        {
+            --it;
+            QVERIFY(index >= 0);
+            QCOMPARE(timeline.time(index), it.key());
+            QCOMPARE(timeline.text(index), it.value());
+        }
+    }
+}
+
+void MusicLrcTimelineTest::boundaryTimerDrift()
+{
+    QByteArray data;
+    for(int i=0; i<TEST_LINE_COUNT; ++i)
+    {
+        const int time = (i + 1) * TEST_LINE_INTERVAL;
+        data += QString("[00:%1.%2]line%3\n").arg(time / MT_S2MS, 2, 10, QChar('0')).arg(time % MT_S2MS, 3, 10, QChar('0')).arg(i).toUtf8();
+    }
+
+    MusicLrcAnalysis analysis;
+    analysis.setLineMax(MUSIC_LRC_INTERIOR_MAX_LINE);
+    QCOMPARE(analysis.setLrcData(data), MusicLrcAnalysis::OpenFileSuccess);
+
+    ///the elapsed timer stands for the audio clock, the slot does what the right area widget does on timeout
+    QElapsedTimer clock;
+    MusicLrcBoundaryTimer timer(&analysis);
+    QEventLoop loop;
+    QStringList lines;
+    qint64 drift = 0;
+    const auto update = [&]()
+    {
+        const qint64 current = clock.elapsed();
+        QString currentLrc, laterLrc;
+        qint64 intervalTime;
+        if(analysis.findText(current, TEST_LINE_COUNT * TEST_LINE_INTERVAL, currentLrc, laterLrc, intervalTime) &&
+           !currentLrc.isEmpty() && (lines.isEmpty() || lines.last() != currentLrc))
+        {
+            lines << currentLrc;
+            drift = qMax(drift, current - (currentLrc.mid(4).toInt() + 1) * TEST_LINE_INTERVAL);
+        }
+
+        timer.schedule(current, false);
+        if(!timer.isActive())
+        {
+            loop.quit();
+        }
+    };
+    connect(&timer, &MusicLrcBoundaryTimer::timeout, update);
+
+    clock.start();
+    update();
+    loop.exec();
+
+    QCOMPARE(lines.count(), TEST_LINE_COUNT);
+    for(int i=0; i<lines.count(); ++i)
+    {
+        QCOMPARE(lines[i], QString("line%1").arg(i));
+    }
+    QVERIFY2(drift <= TEST_DRIFT_MAX, qPrintable(QString("max drift %1 ms").arg(drift)));
+}
+
+QTEST_GUILESS_MAIN(MusicLrcTimelineTest)
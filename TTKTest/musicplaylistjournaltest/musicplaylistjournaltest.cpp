@@ -0,0 +1,126 @@
+#include "musicplaylistjournaltest.h"
+#include "musicplaylistjournal.h"
+#include "musictkpbconfigmanager.h"
+#include "musictkplconfigmanager.h"
+
+#include <QDir>
+
+#define TEST_LIST_COUNT     8
+#define TEST_SONG_COUNT     2000
+
+///the songs spread over the test lists, the same every run
+static MusicSongItems testItems(int count)
+{
+    MusicSongItems items;
+    for(int i=0; i<TEST_LIST_COUNT; ++i)
+    {
+        MusicSongItem item;
+        item.m_itemIndex = i;
+        item.m_itemName = QString("list%1").arg(i);
+        for(int j=i; j<count; j+=TEST_LIST_COUNT)
+        {
+            const QString &name = QString("artist%1 - song%2").arg(j % 97).arg(j);
+            item.m_songs << MusicSong(QString("/music/%1/%2.mp3").arg(i).arg(name), "mp3", "03:30", 0, name);
+        }
+        items << item;
+    }
+    return items;
+}
+
+void MusicPlaylistJournalTest::initTestCase()
+{
+    ///never touch the user playlist, the config dir follows the home dir
+    m_dir = QDir::tempPath() + "/ttkplaylistjournaltest";
+    QDir(m_dir).removeRecursively();
+    QVERIFY(QDir().mkpath(m_dir));
+#ifdef Q_OS_WIN
+    qputenv("APPDATA", m_dir.toLocal8Bit());
+#else
+    qputenv("HOME", m_dir.toLocal8Bit());
+#endif
+    QVERIFY(QDir().mkpath(APPDATA_DIR_FULL));
+
+    m_items = testItems(TEST_LIST_COUNT * TEST_SONG_COUNT);
+    M_PLAYLIST_JOURNAL_PTR->compact(m_items, true);
+}
+
+void MusicPlaylistJournalTest::cleanupTestCase()
+{
+    QDir(m_dir).removeRecursively();
+}
+
+void MusicPlaylistJournalTest::renameSongReplay()
+{
+    M_PLAYLIST_JOURNAL_PTR->compact(m_items, true);
+    M_PLAYLIST_JOURNAL_PTR->renameSong(1, 3, "renamed");
+
+    MusicTKPBConfigManager manager;
+    QVERIFY(manager.readConfig());
+
+    MusicSongItems items;
+    QVERIFY(manager.readPlaylistData(items));
+    QVERIFY(M_PLAYLIST_JOURNAL_PTR->replay(manager.generation(), items));
+    QCOMPARE(items.count(), m_items.count());
+    QCOMPARE(items[1].m_songs[3].getMusicName(), QString("renamed"));
+    QCOMPARE(items[1].m_songs[4].getMusicName(), m_items[1].m_songs[4].getMusicName());
+}
+
+void MusicPlaylistJournalTest::journalSaveLatency_data()
+{
+    QTest::addColumn<int>("count");
+
+    QTest::newRow("1k") << 1000;
+    QTest::newRow("10k") << 10000;
+    QTest::newRow("100k") << 100000;
+}
+
+void MusicPlaylistJournalTest::journalSaveLatency()
+{
+    QFETCH(int, count);
+
+    ///the record goes on top of a snapshot of the same size
+    M_PLAYLIST_JOURNAL_PTR->compact(testItems(count), true);
+
+    int playCount = 0;
+    QBENCHMARK
+    {
+        M_PLAYLIST_JOURNAL_PTR->setPlayCount(0, 0, ++playCount);
+    }
+}
+
+void MusicPlaylistJournalTest::snapshotSaveLatency_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<bool>("tkpl");
+
+    QTest::newRow("tkpb 1k") << 1000 << false;
+    QTest::newRow("tkpl 1k") << 1000 << true;
+    QTest::newRow("tkpb 10k") << 10000 << false;
+    QTest::newRow("tkpl 10k") << 10000 << true;
+    QTest::newRow("tkpb 100k") << 100000 << false;
+    QTest::newRow("tkpl 100k") << 100000 << true;
+}
+
+void MusicPlaylistJournalTest::snapshotSaveLatency()
+{
+    QFETCH(int, count);
+    QFETCH(bool, tkpl);
+
+    const MusicSongItems &items = testItems(count);
+    QBENCHMARK
+    {
+        if(tkpl)
+        {
+            ///every save rewrote the whole dom before the journal
+            MusicTKPLConfigManager manager;
+            QVERIFY(manager.writePlaylistData(items));
+        }
+        else
+        {
+            MusicTKPBConfigManager manager;
+            QVERIFY(manager.writePlaylistData(items));
+        }
+    }
+}
+
+QTEST_GUILESS_MAIN(MusicPlaylistJournalTest)
@@ -0,0 +1,63 @@
+#ifndef MUSICPLAYLISTJOURNALTEST_H
+#define MUSICPLAYLISTJOURNALTEST_H
+
+/* =================================================
+ * This file is part of the TTK Music Player project
+ * Copyright (C) 2015 - 2020 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ================================================= */
+
+#include <QtTest>
+#include "musicsong.h"
+
+/*! @brief The class of the playlist journal test.
+ * @author Greedysky <greedysky@163.com>
+ */
+class MusicPlaylistJournalTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    /*!
+     * Move the config dir into a temp dir.
+     */
+    void initTestCase();
+    /*!
+     * Remove the temp config dir.
+     */
+    void cleanupTestCase();
+
+    /*!
+     * Song rename is replayed onto the snapshot.
+     */
+    void renameSongReplay();
+    /*!
+     * Save latency of one journal record at 1k, 10k and 100k songs.
+     */
+    void journalSaveLatency_data();
+    void journalSaveLatency();
+    /*!
+     * Save latency of one full rewrite at 1k, 10k and 100k songs,
+     * the binary snapshot and the tkpl dom the journal replaces.
+     */
+    void snapshotSaveLatency_data();
+    void snapshotSaveLatency();
+
+private:
+    QString m_dir;
+    MusicSongItems m_items;
+
+};
+
+#endif // MUSICPLAYLISTJOURNALTEST_H
@@ -0,0 +1,97 @@
+#include "musicsongsorttest.h"
+#include "musicsong.h"
+
+#define BENCHMARK_SONG_COUNT    100000
+
+Q_DECLARE_METATYPE(MusicSong::Sort)
+
+///songs with many equal keys, the same every run
+static MusicSongs testSongs(int count)
+{
+    MusicSongs songs;
+    for(int i=0; i<count; ++i)
+    {
+        const QString &name = QString("artist%1 - song%2").arg(i * 7 % 613).arg(i * 31 % 4099);
+        const int seconds = i * 13 % 3600;
+        MusicSong song(QString("/music/%1.mp3").arg(i), "mp3", QString("%1:%2").arg(seconds / 60).arg(seconds % 60, 2, 10, QChar('0')), i * 17 % 101, name);
+        song.setMusicAddTime(i * 29 % 997);
+        songs << song;
+    }
+    return songs;
+}
+
+void MusicSongSortTest::sortMatchesStableSort_data()
+{
+    QTest::addColumn<MusicSong::Sort>("type");
+    QTest::addColumn<int>("count");
+
+    QTest::newRow("play count serial") << MusicSong::SortByPlayCount << 1000;
+    QTest::newRow("play count parallel") << MusicSong::SortByPlayCount << 50000;
+    QTest::newRow("play time parallel") << MusicSong::SortByPlayTime << 50000;
+}
+
+void MusicSongSortTest::sortMatchesStableSort()
+{
+    QFETCH(MusicSong::Sort, type);
+    QFETCH(int, count);
+
+    MusicSongs songs = testSongs(count);
+    MusicSongs expected = songs;
+    std::stable_sort(expected.begin(), expected.end(), [type](const MusicSong &a, const MusicSong &b)
+    {
+        return type == MusicSong::SortByPlayCount ? a.getMusicPlayCount() < b.getMusicPlayCount()
+                                                  : a.getMusicPlayTimeMsec() < b.getMusicPlayTimeMsec();
+    });
+
+    MusicSong::sortSongs(&songs, type, Qt::AscendingOrder);
+    QCOMPARE(songs.count(), expected.count());
+    for(int i=0; i<songs.count(); ++i)
+    {
+        QCOMPARE(songs[i].getMusicPath(), expected[i].getMusicPath());
+    }
+}
+
+void MusicSongSortTest::sortBenchmark_data()
+{
+    QTest::addColumn<MusicSong::Sort>("type");
+    QTest::addColumn<bool>("legacy");
+
+    QTest::newRow("name operator") << MusicSong::SortByFileName << true;
+    QTest::newRow("name keys") << MusicSong::SortByFileName << false;
+    QTest::newRow("singer operator") << MusicSong::SortBySinger << true;
+    QTest::newRow("singer keys") << MusicSong::SortBySinger << false;
+    QTest::newRow("play count operator") << MusicSong::SortByPlayCount << true;
+    QTest::newRow("play count keys") << MusicSong::SortByPlayCount << false;
+}
+
+void MusicSongSortTest::sortBenchmark()
+{
+    QFETCH(MusicSong::Sort, type);
+    QFETCH(bool, legacy);
+
+    MusicSongs input = testSongs(BENCHMARK_SONG_COUNT);
+    for(int i=0; i<input.count(); ++i)
+    {
+        input[i].setMusicSort(type);
+    }
+
+    if(legacy)
+    {
+        ///the sort before the precomputed keys, every comparison builds its key again
+        QBENCHMARK
+        {
+            MusicSongs songs = input;
+            std::sort(songs.begin(), songs.end());
+        }
+    }
+    else
+    {
+        QBENCHMARK
+        {
+            MusicSongs songs = input;
+            MusicSong::sortSongs(&songs, type, Qt::AscendingOrder);
+        }
+    }
+}
+
+QTEST_GUILESS_MAIN(MusicSongSortTest)
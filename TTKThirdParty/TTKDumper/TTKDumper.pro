@@ -42,7 +42,8 @@ win32:msvc{
 SOURCES += \
     $$PWD/miniprocess.cpp \
     $$PWD/minidumper.cpp \
-    $$PWD/ttkdumper.cpp
+    $$PWD/ttkdumper.cpp \
+    $$PWD/ttklogger.cpp
     
 HEADERS += \
     $$PWD/miniprocess.h \
@@ -0,0 +1,170 @@
+#include "ttklogger.h"
+#include "ttkglobal.h"
+
+#include <cstdlib>
+
+#define LOG_FILE_NAME           "logger.txt"
+#define LOG_TIME_FORMAT         "yyyy-MM-dd hh:mm:ss:zzz"
+
+///load the list head with acquire order
+static inline TTKLogger::Record *loadRecord(QAtomicPointer<TTKLogger::Record> &head)
+{
+#if TTK_QT_VERSION_CHECK(5,0,0)
+    return head.loadAcquire();
+#else
+    return head;
+#endif
+}
+
+///the writer thread sleeps until records are pushed or the logger is shut down
+class TTKLogger::Writer : public QThread
+{
+public:
+    explicit Writer(TTKLogger *logger)
+        : m_logger(logger)
+    {
+
+    }
+
+protected:
+    virtual void run() override
+    {
+        while(true)
+        {
+            m_logger->m_waitMutex.lock();
+            while(m_logger->m_running && !loadRecord(m_logger->m_head))
+            {
+                m_logger->m_waitCondition.wait(&m_logger->m_waitMutex);
+            }
+            m_logger->m_waitMutex.unlock();
+
+            m_logger->flush();
+            if(!m_logger->m_running)
+            {
+                break;
+            }
+        }
+    }
+
+private:
+    TTKLogger *m_logger;
+
+};
+
+
+TTKLogger* TTKLogger::createInstance()
+{
+    ///never deleted, so static destructors running after the shutdown can still log
+    static TTKLogger *instance = new TTKLogger;
+    return instance;
+}
+
+void TTKLogger::append(Level level, const QString &message)
+{
+    Record *record = new Record;
+    record->m_level = level;
+    record->m_time = QDateTime::currentMSecsSinceEpoch();
+    record->m_thread = QThread::currentThreadId();
+    record->m_message = message;
+
+    Record *head = nullptr;
+    do
+    {
+        head = loadRecord(m_head);
+        record->m_next = head;
+    } while(!m_head.testAndSetRelease(head, record));
+
+    if(level == Fatal || !m_running)
+    {
+        flush();
+    }
+    else if(!head)
+    {
+        ///the writer waits only on an empty list, wake it for the first record
+        QMutexLocker locker(&m_waitMutex);
+        m_waitCondition.wakeOne();
+    }
+}
+
+void TTKLogger::flush()
+{
+    QMutexLocker locker(&m_mutex);
+    Record *record = m_head.fetchAndStoreAcquire(nullptr);
+
+    ///the list is pushed at head, reverse it to the calling order
+    Record *ordered = nullptr;
+    while(record)
+    {
+        Record *next = record->m_next;
+        record->m_next = ordered;
+        ordered = record;
+        record = next;
+    }
+
+    if(!ordered)
+    {
+        return;
+    }
+
+    while(ordered)
+    {
+        Record *next = ordered->m_next;
+        m_stream << QString("[%1] [%2] [0x%3]:  %4").arg(QDateTime::fromMSecsSinceEpoch(ordered->m_time).toString(LOG_TIME_FORMAT))
+                                                   .arg(levelName(ordered->m_level))
+                                                   .arg((quintptr)ordered->m_thread, 0, 16)
+                                                   .arg(ordered->m_message);
+#if TTK_QT_VERSION_CHECK(5,15,0)
+        m_stream << Qt::endl;
+#else
+        m_stream << endl;
+#endif
+        delete ordered;
+        ordered = next;
+    }
+    m_stream.flush();
+}
+
+QString TTKLogger::levelName(Level level)
+{
+    switch(level)
+    {
+        case Trace: return "[Trace]";
+        case Debug: return "[Debug]";
+        case Info: return "[Info]";
+        case Warn: return "[Warn]";
+        case Error: return "[Error]";
+        case Fatal: return "[Fatal]";
+        default: return QString();
+    }
+}
+
+TTKLogger::TTKLogger()
+    : m_head(nullptr)
+{
+    m_running = 1;
+    m_file.setFileName(LOG_FILE_NAME);
+    m_file.open(QIODevice::WriteOnly | QIODevice::Append);
+    m_stream.setDevice(&m_file);
+    m_stream << QString().rightJustified(70, '=');
+#if TTK_QT_VERSION_CHECK(5,15,0)
+    m_stream << Qt::endl;
+#else
+    m_stream << endl;
+#endif
+
+    m_writer = new Writer(this);
+    m_writer->start(QThread::LowestPriority);
+    atexit(shutdown);
+}
+
+void TTKLogger::shutdown()
+{
+    TTKLogger *logger = createInstance();
+    logger->m_waitMutex.lock();
+    logger->m_running = 0;
+    logger->m_waitCondition.wakeAll();
+    logger->m_waitMutex.unlock();
+
+    logger->m_writer->wait();
+    logger->flush();
+}
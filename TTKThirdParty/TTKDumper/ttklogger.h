@@ -20,162 +20,203 @@
  ================================================= */
 
 #include <QFile>
+#include <QMutex>
 #include <QDebug>
+#include <QThread>
 #include <QDateTime>
 #include <QTextStream>
-
-#define CURRENT_TIME QTime::currentTime().toString(MUSIC_ZTIME_FORMAT)
-#define CURRENT_DATE QDate::currentDate().toString(MUSIC_YEAR_FORMAT)
-#define LOG_END      QString("log::npos")
+#include <QWaitCondition>
+
+///logger levels, messages below TTK_LOGGER_LEVEL are removed at compile time
+#define TTK_LOGGER_LEVEL_TRACE  0
+#define TTK_LOGGER_LEVEL_DEBUG  1
+#define TTK_LOGGER_LEVEL_INFO   2
+#define TTK_LOGGER_LEVEL_WARN   3
+#define TTK_LOGGER_LEVEL_ERROR  4
+#define TTK_LOGGER_LEVEL_FATAL  5
+
+#ifndef TTK_LOGGER_LEVEL
+#  define TTK_LOGGER_LEVEL      TTK_LOGGER_LEVEL_TRACE
+#endif
 
 #define TTK_LOGGER    (*TTKLogger::createInstance())
-#define TTK_MESSAGE(str, msg)       \
-{                                   \
-    TTK_LOGGER.setLevel(msg);       \
-    TTK_LOGGER << str << LOG_END;   \
+#define TTK_MESSAGE(str, level)                 \
+{                                               \
+    TTKLogger::Message(TTKLogger::level) << str;\
 }
 
 #ifdef TTK_DEBUG
-    #define TTK_LOGGER_INFO(str)  TTK_MESSAGE(str, "[Info]")
-    #define TTK_LOGGER_DEBUG(str) TTK_MESSAGE(str, "[Debug]")
-    #define TTK_LOGGER_WARN(str)  TTK_MESSAGE(str, "[Warn]")
-    #define TTK_LOGGER_TRACE(str) TTK_MESSAGE(str, "[Trace]")
-    #define TTK_LOGGER_ERROR(str) TTK_MESSAGE(str, "[Error]")
-    #define TTK_LOGGER_FATAL(str) TTK_MESSAGE(str, "[Fatal]")
+#  define TTK_LOGGER_OUTPUT(str, level) TTK_MESSAGE(str, level)
+#else
+#  define TTK_LOGGER_OUTPUT(str, level) qDebug() << str
+#endif
+
+#if TTK_LOGGER_LEVEL <= TTK_LOGGER_LEVEL_INFO
+#  define TTK_LOGGER_INFO(str)  TTK_LOGGER_OUTPUT(str, Info)
+#else
+#  define TTK_LOGGER_INFO(str)
+#endif
+#if TTK_LOGGER_LEVEL <= TTK_LOGGER_LEVEL_DEBUG
+#  define TTK_LOGGER_DEBUG(str) TTK_LOGGER_OUTPUT(str, Debug)
+#else
+#  define TTK_LOGGER_DEBUG(str)
+#endif
+#if TTK_LOGGER_LEVEL <= TTK_LOGGER_LEVEL_WARN
+#  define TTK_LOGGER_WARN(str)  TTK_LOGGER_OUTPUT(str, Warn)
+#else
+#  define TTK_LOGGER_WARN(str)
+#endif
+#if TTK_LOGGER_LEVEL <= TTK_LOGGER_LEVEL_TRACE
+#  define TTK_LOGGER_TRACE(str) TTK_LOGGER_OUTPUT(str, Trace)
+#else
+#  define TTK_LOGGER_TRACE(str)
+#endif
+#if TTK_LOGGER_LEVEL <= TTK_LOGGER_LEVEL_ERROR
+#  define TTK_LOGGER_ERROR(str) TTK_LOGGER_OUTPUT(str, Error)
 #else
-    #define TTK_LOGGER_INFO(str)  qDebug() << str
-    #define TTK_LOGGER_DEBUG(str) qDebug() << str
-    #define TTK_LOGGER_WARN(str)  qDebug() << str
-    #define TTK_LOGGER_TRACE(str) qDebug() << str
-    #define TTK_LOGGER_ERROR(str) qDebug() << str
-    #define TTK_LOGGER_FATAL(str) qDebug() << str
+#  define TTK_LOGGER_ERROR(str)
 #endif
+#define TTK_LOGGER_FATAL(str)   TTK_LOGGER_OUTPUT(str, Fatal)
 
 /*! @brief The class of the application logger.
+ * Callers build their message on their own and push it to a lock-free
+ * list, a writer thread waits for records and writes the whole list at once.
  * @author Greedysky <greedysky@163.com>
  */
 class Q_DECL_EXPORT TTKLogger
 {
 public:
-    /*!
-     * Get object instance ptr.
-     */
-    inline static TTKLogger* createInstance()
+    enum Level
     {
-        static TTKLogger obj;
-        return &obj;
-    }
-
-    /*!
-     * Set logger level.
+        Trace = TTK_LOGGER_LEVEL_TRACE,  /*!< trace level*/
+        Debug = TTK_LOGGER_LEVEL_DEBUG,  /*!< debug level*/
+        Info = TTK_LOGGER_LEVEL_INFO,    /*!< info level*/
+        Warn = TTK_LOGGER_LEVEL_WARN,    /*!< warn level*/
+        Error = TTK_LOGGER_LEVEL_ERROR,  /*!< error level*/
+        Fatal = TTK_LOGGER_LEVEL_FATAL   /*!< fatal level*/
+    };
+
+    /*! @brief The class of the logger record.
      */
-    inline void setLevel(const QString &level)
+    struct Record
     {
-        m_levelType = level;
-    }
-    /*!
-     * Get logger level.
+        Level m_level;
+        qint64 m_time;
+        Qt::HANDLE m_thread;
+        QString m_message;
+        Record *m_next;
+    };
+
+    /*! @brief The class of the logger message, owned by the calling thread.
+     * The record is pushed to the logger when the message is destroyed.
      */
-    inline QString level() const
+    class Message
     {
-        return m_levelType;
-    }
+    public:
+        /*!
+         * Object contsructor.
+         */
+        explicit Message(Level level)
+            : m_level(level)
+        {
 
-    /*!
-     * Operator << override.
-     */
-    inline TTKLogger &operator <<(bool t)
-    {
-#ifdef TTK_DEBUG
-        m_streamString.append(QString("%1 ").arg(t ? "true" : "false"));
-#else
-        Q_UNUSED(t);
-#endif
-        return *this;
-    }
-    inline TTKLogger &operator<<(char t) { return debugData<char>(t); }
-    inline TTKLogger &operator<<(signed short t) { return debugData<short>(t); }
-    inline TTKLogger &operator<<(ushort t) { return debugData<ushort>(t); }
-    inline TTKLogger &operator<<(signed int t) { return debugData<int>(t); }
-    inline TTKLogger &operator<<(uint t) { return debugData<uint>(t); }
-    inline TTKLogger &operator<<(signed long t) { return debugData<long>(t); }
-    inline TTKLogger &operator<<(ulong t) { return debugData<ulong>(t); }
-    inline TTKLogger &operator<<(qint64 t) { return debugData<qint64>(t); }
-    inline TTKLogger &operator<<(quint64 t) { return debugData<quint64>(t); }
-    inline TTKLogger &operator<<(float t) { return debugData<float>(t); }
-    inline TTKLogger &operator<<(double t) { return debugData<double>(t); }
-    inline TTKLogger &operator<<(const char *t) { return debugData<const char*>(t); }
-    inline TTKLogger &operator<<(const QStringRef &t) { return debugData<QString>(t.toString()); }
-    inline TTKLogger &operator<<(const QLatin1String &t) { return debugData<QLatin1String>(t); }
-    inline TTKLogger &operator<<(const QByteArray &t) { return debugData<QString>(QString(t)); }
-    inline TTKLogger &operator<<(const QString &t)
-    {
-#ifdef TTK_DEBUG
-        if(t == LOG_END)
+        }
+
+        ~Message()
         {
-            m_stream << QString("[%1 %2]:  %3").arg(CURRENT_DATE).arg(CURRENT_TIME).arg(m_streamString);
-#if TTK_QT_VERSION_CHECK(5,15,0)
-            m_stream << Qt::endl;
-#else
-            m_stream << endl;
-#endif
-            m_streamString.clear();
+            TTKLogger::createInstance()->append(m_level, m_data);
+        }
+
+        /*!
+         * Operator << override.
+         */
+        inline Message &operator<<(bool t) { return append(QLatin1String(t ? "true" : "false")); }
+        inline Message &operator<<(char t) { return append(QString(QChar(t))); }
+        inline Message &operator<<(signed short t) { return append(QString::number(t)); }
+        inline Message &operator<<(ushort t) { return append(QString::number(t)); }
+        inline Message &operator<<(signed int t) { return append(QString::number(t)); }
+        inline Message &operator<<(uint t) { return append(QString::number(t)); }
+        inline Message &operator<<(signed long t) { return append(QString::number(t)); }
+        inline Message &operator<<(ulong t) { return append(QString::number(t)); }
+        inline Message &operator<<(qint64 t) { return append(QString::number(t)); }
+        inline Message &operator<<(quint64 t) { return append(QString::number(t)); }
+        inline Message &operator<<(float t) { return append(QString::number(t)); }
+        inline Message &operator<<(double t) { return append(QString::number(t)); }
+        inline Message &operator<<(const char *t) { return append(QString(t)); }
+        inline Message &operator<<(const QLatin1String &t) { return append(t); }
+        inline Message &operator<<(const QByteArray &t) { return append(QString(t)); }
+        inline Message &operator<<(const QString &t) { return append(t); }
+        /*!
+         * Operator << override, other types are written as qDebug does.
+         */
+        template <typename T>
+        inline Message &operator<<(const T &t)
+        {
+            QString data;
+            QDebug(&data).nospace() << t;
+            return append(data);
         }
-        else
+
+    private:
+        /*!
+         * Append one field to the message.
+         */
+        template <typename T>
+        inline Message &append(const T &data)
         {
-            debugData<QString>(t);
+            if(!m_data.isEmpty())
+            {
+                m_data.append(QLatin1Char(' '));
+            }
+            m_data.append(data);
+            return *this;
         }
-#else
-        Q_UNUSED(t);
-#endif
-        return *this;
-    }
+
+        Level m_level;
+        QString m_data;
+
+    };
+
+    /*!
+     * Get object instance ptr, the one instance lives in the dumper library.
+     */
+    static TTKLogger* createInstance();
+
+    /*!
+     * Push one record, called from any thread.
+     */
+    void append(Level level, const QString &message);
+    /*!
+     * Write all pushed records into local file.
+     */
+    void flush();
+
+    /*!
+     * Get logger level name.
+     */
+    static QString levelName(Level level);
 
 private:
+    class Writer;
+
     /*!
      * Object contsructor.
      */
-    TTKLogger()
-    {
-#ifdef TTK_DEBUG
-        m_file.setFileName("logger.txt");
-        m_file.open(QIODevice::WriteOnly | QIODevice::Append);
-        m_stream.setDevice(&m_file);
-        m_stream << QString().rightJustified(70, '=');
-#if TTK_QT_VERSION_CHECK(5,15,0)
-        m_stream << Qt::endl;
-#else
-        m_stream << endl;
-#endif
-        m_levelType = "[Info]";
-#endif
-    }
-
-    ~TTKLogger()
-    {
-#ifdef TTK_DEBUG
-        m_file.close();
-#endif
-    }
+    TTKLogger();
 
     /*!
-     * Output debug data into local file.
+     * Stop the writer and write the rest, records after that are written at once.
      */
-    template <typename T>
-    TTKLogger &debugData(const T &data)
-    {
-#ifdef TTK_DEBUG
-        m_streamString.append(QString("%1 %2 ").arg(m_levelType).arg(data));
-#else
-        Q_UNUSED(data);
-#endif
-        return *this;
-    }
+    static void shutdown();
 
     QFile m_file;
+    QMutex m_mutex;
     QTextStream m_stream;
-    QString m_streamString;
-    QString m_levelType;
+    QAtomicPointer<Record> m_head;
+    QMutex m_waitMutex;
+    QWaitCondition m_waitCondition;
+    volatile int m_running;
+    Writer *m_writer;
 
 };
 
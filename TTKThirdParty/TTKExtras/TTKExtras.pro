@@ -34,7 +34,7 @@ win32:msvc{
     QMAKE_CXXFLAGS += -std=c++11
 }
 
-LIBS += -L$$DESTDIR -lTTKUi
+LIBS += -L$$DESTDIR -lTTKUi -lTTKDumper
 INCLUDEPATH += $$PWD
 
 include($$PWD/../TTKExtrasDefine.pri)
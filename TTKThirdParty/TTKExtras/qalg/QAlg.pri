@@ -37,4 +37,5 @@ HEADERS += \
     $$PWD/random.h \
     $$PWD/qaeswrap.h \
     $$PWD/qdeswrap.h \
-    $$PWD/qimagewrap.h
+    $$PWD/qimagewrap.h \
+    $$PWD/qparallelwrap.h
@@ -4,8 +4,131 @@
 #include <qmath.h>
 #include <QPainter>
 
+#include "qparallelwrap.h"
+
+#define GAUSS_BLOCK_WIDTH   32
+#define GAUSS_THREAD_PIXELS (256 * 256)
+
 namespace QImageWrap {
+///one output pixel of the gauss kernel, taps out of range are skipped
+static inline int gaussPixel(const int* data, int stride, int index, int count, int radius, const float* gaussMatrix)
+{
+    float r = 0, g = 0, b = 0;
+    float gaussSum = 0;
+
+    for(int i = -radius; i <= radius; ++i)
+    {
+        const int k = index + i;
+        if(0 <= k && k < count)
+        {
+            const int color = data[k * stride];
+            const int cr = (color & 0x00ff0000) >> 16;
+            const int cg = (color & 0x0000ff00) >> 8;
+            const int cb = (color & 0x000000ff);
+
+            r += cr * gaussMatrix[i + radius];
+            g += cg * gaussMatrix[i + radius];
+            b += cb * gaussMatrix[i + radius];
+
+            gaussSum += gaussMatrix[i + radius];
+        }
+    }
+
+    const int cr = (int)(r / gaussSum);
+    const int cg = (int)(g / gaussSum);
+    const int cb = (int)(b / gaussSum);
+    return cr << 16 | cg << 8 | cb | 0xff000000;
+}
+
+///box blur one line in place by sliding window sums, edge pixels are repeated
+static void boxLine(int* data, int stride, int count, int radius, int* line)
+{
+    for(int i = 0; i < count; ++i)
+    {
+        line[i] = data[i * stride];
+    }
+
+    const int size = radius + radius + 1;
+    int r = 0, g = 0, b = 0;
+    for(int i = -radius; i <= radius; ++i)
+    {
+        const int color = line[qBound(0, i, count - 1)];
+        r += (color & 0x00ff0000) >> 16;
+        g += (color & 0x0000ff00) >> 8;
+        b += (color & 0x000000ff);
+    }
+
+    for(int i = 0; i < count; ++i)
+    {
+        data[i * stride] = (r + size / 2) / size << 16 | (g + size / 2) / size << 8 | (b + size / 2) / size | 0xff000000;
+
+        const int in = line[qMin(i + radius + 1, count - 1)];
+        const int out = line[qMax(i - radius, 0)];
+        r += ((in & 0x00ff0000) >> 16) - ((out & 0x00ff0000) >> 16);
+        g += ((in & 0x0000ff00) >> 8) - ((out & 0x0000ff00) >> 8);
+        b += (in & 0x000000ff) - (out & 0x000000ff);
+    }
+}
+
+///box blur a block of columns together by sliding window sums, edge pixels are repeated
+static void boxColumns(int* data, int stride, int count, int width, int radius, int* block)
+{
+    for(int i = 0; i < count; ++i)
+    {
+        memcpy(block + i * GAUSS_BLOCK_WIDTH, data + i * stride, sizeof(int) * width);
+    }
+
+    const int size = radius + radius + 1;
+    int r[GAUSS_BLOCK_WIDTH] = {0}, g[GAUSS_BLOCK_WIDTH] = {0}, b[GAUSS_BLOCK_WIDTH] = {0};
+    for(int i = -radius; i <= radius; ++i)
+    {
+        const int* row = block + qBound(0, i, count - 1) * GAUSS_BLOCK_WIDTH;
+        for(int x = 0; x < width; ++x)
+        {
+            r[x] += (row[x] & 0x00ff0000) >> 16;
+            g[x] += (row[x] & 0x0000ff00) >> 8;
+            b[x] += (row[x] & 0x000000ff);
+        }
+    }
+
+    for(int i = 0; i < count; ++i)
+    {
+        int* row = data + i * stride;
+        const int* in = block + qMin(i + radius + 1, count - 1) * GAUSS_BLOCK_WIDTH;
+        const int* out = block + qMax(i - radius, 0) * GAUSS_BLOCK_WIDTH;
+        for(int x = 0; x < width; ++x)
+        {
+            row[x] = (r[x] + size / 2) / size << 16 | (g[x] + size / 2) / size << 8 | (b[x] + size / 2) / size | 0xff000000;
+            r[x] += ((in[x] & 0x00ff0000) >> 16) - ((out[x] & 0x00ff0000) >> 16);
+            g[x] += ((in[x] & 0x0000ff00) >> 8) - ((out[x] & 0x0000ff00) >> 8);
+            b[x] += (in[x] & 0x000000ff) - (out[x] & 0x000000ff);
+        }
+    }
+}
+
+QGaussBlur::QGaussBlur()
+{
+    m_mode = Exact;
+}
+
 void QGaussBlur::render(int* pix, int width, int height, int radius)
+{
+    if(!pix || width <= 0 || height <= 0 || radius <= 0)
+    {
+        return;
+    }
+
+    if(m_mode == Box)
+    {
+        renderBox(pix, width, height, radius);
+    }
+    else
+    {
+        renderExact(pix, width, height, radius);
+    }
+}
+
+void QGaussBlur::renderExact(int* pix, int width, int height, int radius)
 {
     const float sigma =  1.0 * radius / 2.57;
     const float deno  =  1.0 / (sigma * sqrt(2.0 * M_PI));
@@ -27,87 +150,95 @@ void QGaussBlur::render(int* pix, int width, int height, int radius)
         gaussMatrix[i] /= gaussSum;
     }
 
-    int* rowData  = (int*)malloc(width * sizeof(int));
-    int* listData = (int*)malloc(height * sizeof(int));
-
-    for(int y = 0; y < height; ++y)
+    //Row pass, every row works on its own copy
+    QParallelWrap::render(height, width * height, GAUSS_THREAD_PIXELS, [&](int from, int to)
     {
-        memcpy(rowData, pix + y * width, sizeof(int) *width);
-
-        for(int x = 0; x < width; ++x)
+        int* rowData = (int*)malloc(width * sizeof(int));
+        for(int y = from; y < to; ++y)
         {
-            float r = 0, g = 0, b = 0;
-            gaussSum = 0;
+            memcpy(rowData, pix + y * width, sizeof(int) * width);
+            for(int x = 0; x < width; ++x)
+            {
+                pix[y * width + x] = gaussPixel(rowData, 1, x, width, radius, gaussMatrix);
+            }
+        }
+        free(rowData);
+    });
 
-            for(int i = -radius; i <= radius; ++i)
+    //Column pass, columns are copied by blocks so that reading keeps row order
+    const int blocks = (width + GAUSS_BLOCK_WIDTH - 1) / GAUSS_BLOCK_WIDTH;
+    QParallelWrap::render(blocks, width * height, GAUSS_THREAD_PIXELS, [&](int from, int to)
+    {
+        int* blockData = (int*)malloc(height * GAUSS_BLOCK_WIDTH * sizeof(int));
+        for(int block = from; block < to; ++block)
+        {
+            const int left = block * GAUSS_BLOCK_WIDTH;
+            const int count = qMin(GAUSS_BLOCK_WIDTH, width - left);
+            for(int y = 0; y < height; ++y)
             {
-                int k = x + i;
+                memcpy(blockData + y * GAUSS_BLOCK_WIDTH, pix + y * width + left, sizeof(int) * count);
+            }
 
-                if(0 <= k && k <= width)
+            for(int y = 0; y < height; ++y)
+            {
+                for(int x = 0; x < count; ++x)
                 {
-                    int color = rowData[k];
-                    int cr = (color & 0x00ff0000) >> 16;
-                    int cg = (color & 0x0000ff00) >> 8;
-                    int cb = (color & 0x000000ff);
-
-                    r += cr * gaussMatrix[i + radius];
-                    g += cg * gaussMatrix[i + radius];
-                    b += cb * gaussMatrix[i + radius];
-
-                    gaussSum += gaussMatrix[i + radius];
+                    pix[y * width + left + x] = gaussPixel(blockData + x, GAUSS_BLOCK_WIDTH, y, height, radius, gaussMatrix);
                 }
             }
+        }
+        free(blockData);
+    });
 
-            int cr = (int)(r / gaussSum);
-            int cg = (int)(g / gaussSum);
-            int cb = (int)(b / gaussSum);
+    free(gaussMatrix);
+}
 
-            pix[y * width + x] = cr << 16 | cg << 8 | cb | 0xff000000;
-        }
+void QGaussBlur::renderBox(int* pix, int width, int height, int radius)
+{
+    //Box sizes of three passes whose variance matches the gauss sigma
+    const int passes = 3;
+    const float sigma = 1.0 * radius / 2.57;
+    const float ideal = sqrt(12.0 * sigma * sigma / passes + 1);
+    int lower = floor(ideal);
+    if(lower % 2 == 0)
+    {
+        --lower;
     }
 
-    for(int x = 0; x < width; ++x)
+    const int upper = lower + 2;
+    const int count = qRound((12.0 * sigma * sigma - passes * lower * lower - 4.0 * passes * lower - 3.0 * passes) / (-4.0 * lower - 4.0));
+
+    for(int pass = 0; pass < passes; ++pass)
     {
-        for(int y = 0; y < height; ++y)
+        const int boxRadius = ((pass < count ? lower : upper) - 1) / 2;
+        if(boxRadius <= 0)
         {
-            listData[y] = pix[y * width + x];
+            continue;
         }
 
-        for(int y = 0; y < height; ++y)
+        QParallelWrap::render(height, width * height, GAUSS_THREAD_PIXELS, [&](int from, int to)
         {
-            float r = 0, g = 0, b = 0;
-            gaussSum = 0;
-
-            for(int j = -radius; j <= radius; ++j)
+            int* line = (int*)malloc(width * sizeof(int));
+            for(int y = from; y < to; ++y)
             {
-                int k = y + j;
-
-                if(0 <= k && k <= height)
-                {
-                    int color = listData[k];
-                    int cr = (color & 0x00ff0000) >> 16;
-                    int cg = (color & 0x0000ff00) >> 8;
-                    int cb = (color & 0x000000ff);
-
-                    r += cr * gaussMatrix[j + radius];
-                    g += cg * gaussMatrix[j + radius];
-                    b += cb * gaussMatrix[j + radius];
-
-                    gaussSum += gaussMatrix[j + radius];
-                }
+                boxLine(pix + y * width, 1, width, boxRadius, line);
             }
+            free(line);
+        });
 
-            int cr = (int)(r / gaussSum);
-            int cg = (int)(g / gaussSum);
-            int cb = (int)(b / gaussSum);
-
-            pix[y * width + x] = cr << 16 | cg << 8 | cb | 0xff000000;
-        }
+        //Columns are blurred by blocks, every step reads and writes one row span of the block
+        const int blocks = (width + GAUSS_BLOCK_WIDTH - 1) / GAUSS_BLOCK_WIDTH;
+        QParallelWrap::render(blocks, width * height, GAUSS_THREAD_PIXELS, [&](int from, int to)
+        {
+            int* blockData = (int*)malloc(height * GAUSS_BLOCK_WIDTH * sizeof(int));
+            for(int block = from; block < to; ++block)
+            {
+                const int left = block * GAUSS_BLOCK_WIDTH;
+                boxColumns(pix + left, width, height, qMin(GAUSS_BLOCK_WIDTH, width - left), boxRadius, blockData);
+            }
+            free(blockData);
+        });
     }
-
-    free(gaussMatrix);
-    free(rowData);
-    free(listData);
 }
 
 
@@ -32,11 +32,40 @@ namespace QImageWrap {
 class MUSIC_EXTRAS_EXPORT QGaussBlur
 {
 public:
+    enum Mode
+    {
+        Exact,  /*!< exact gauss kernel*/
+        Box     /*!< three box blurs approximation, cost does not grow with radius*/
+    };
+
+    QGaussBlur();
+
+    /*!
+     * Set blur mode.
+     */
+    inline void setMode(Mode mode) { m_mode = mode; }
+    /*!
+     * Get blur mode.
+     */
+    inline Mode mode() const { return m_mode; }
+
     /*!
      * Image gauss blur render.
      */
     void render(int* pix, int width, int height, int radius);
 
+private:
+    /*!
+     * Image gauss blur render by exact kernel, row pass then column pass.
+     */
+    void renderExact(int* pix, int width, int height, int radius);
+    /*!
+     * Image gauss blur render by three box blurs, row pass then column blocks.
+     */
+    void renderBox(int* pix, int width, int height, int radius);
+
+    Mode m_mode;
+
 };
 
 
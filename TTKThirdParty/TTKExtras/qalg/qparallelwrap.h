@@ -0,0 +1,60 @@
+#ifndef QPARALLELWRAP_H
+#define QPARALLELWRAP_H
+
+/* =================================================
+ * This file is part of the TTK Music Player project
+ * Copyright (C) 2015 - 2020 Greedysky Studio
+
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; If not, see <http://www.gnu.org/licenses/>.
+ ================================================= */
+
+#include <QThread>
+#include "musicextrasglobaldefine.h"
+#ifdef TTK_GREATER_NEW
+#  include <QtConcurrent/QtConcurrent>
+#else
+#  include <QtConcurrentRun>
+#endif
+
+/*! @brief The namespace of the parallel render wrapper.
+ * @author Greedysky <greedysky@163.com>
+ */
+namespace QParallelWrap {
+/*!
+ * Run kernel over [0, count), split into chunks on the thread pool
+ * when pixels are not less than the min pixels, one chunk runs on the caller.
+ */
+template <typename Kernel>
+void render(int count, int pixels, int minPixels, const Kernel &kernel)
+{
+    const int threads = (pixels < minPixels) ? 1 : qBound(1, QThread::idealThreadCount(), count);
+    const int step = (count + threads - 1) / threads;
+
+    QList< QFuture<void> > futures;
+    for(int from = step; from < count; from += step)
+    {
+        const int to = qMin(from + step, count);
+        futures << QtConcurrent::run([&kernel, from, to]() { kernel(from, to); });
+    }
+
+    kernel(0, qMin(step, count));
+    for(int i = 0; i < futures.count(); ++i)
+    {
+        futures[i].waitForFinished();
+    }
+}
+
+}
+
+#endif // QPARALLELWRAP_H